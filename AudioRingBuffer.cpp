@@ -0,0 +1,167 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2025 Mihai Ursu                                                 //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+/*
+AudioRingBuffer.cpp
+This file contains the sources for the lock-free audio ring buffer.
+*/
+
+#include "AudioRingBuffer.h"
+
+#include <algorithm>
+#include <cstring>
+
+
+//!************************************************************************
+//! Constructor
+//!************************************************************************
+AudioRingBuffer::AudioRingBuffer()
+    : mMask( 0 )
+    , mWritePos( 0 )
+    , mReadPos( 0 )
+{
+}
+
+
+//!************************************************************************
+//! Get the capacity
+//!
+//! @returns: the capacity [bytes]
+//!************************************************************************
+size_t AudioRingBuffer::getCapacity() const
+{
+    return mData.size();
+}
+
+
+//!************************************************************************
+//! Get the bytes written and not yet read
+//! Safe to call from any thread. The read position is loaded first: the
+//! write position loaded after it is never behind it, so the difference
+//! cannot wrap around while the consumer advances. Both threads may move
+//! between the two loads, so the result is kept within the capacity.
+//!
+//! @returns: the filled bytes
+//!************************************************************************
+size_t AudioRingBuffer::getFilledBytes() const
+{
+    const size_t readPos = mReadPos.load( std::memory_order_acquire );
+    const size_t writePos = mWritePos.load( std::memory_order_acquire );
+
+    return std::min( writePos - readPos, mData.size() );
+}
+
+
+//!************************************************************************
+//! Read up to aLength bytes
+//! Called only by the consumer.
+//!
+//! @returns: the number of bytes read
+//!************************************************************************
+size_t AudioRingBuffer::read
+    (
+    char*           aData,          //!< destination
+    const size_t    aLength         //!< requested bytes
+    )
+{
+    const size_t readPos = mReadPos.load( std::memory_order_relaxed );
+    const size_t filled = mWritePos.load( std::memory_order_acquire ) - readPos;
+    const size_t count = std::min( aLength, filled );
+
+    if( count )
+    {
+        const size_t start = readPos & mMask;
+        const size_t firstPart = std::min( count, mData.size() - start );
+        memcpy( aData, mData.data() + start, firstPart );
+        memcpy( aData + firstPart, mData.data(), count - firstPart );
+
+        mReadPos.store( readPos + count, std::memory_order_release );
+    }
+
+    return count;
+}
+
+
+//!************************************************************************
+//! Drop all the content
+//! Only when neither the producer nor the consumer is running.
+//!
+//! @returns: nothing
+//!************************************************************************
+void AudioRingBuffer::reset()
+{
+    mWritePos = 0;
+    mReadPos = 0;
+}
+
+
+//!************************************************************************
+//! Set the capacity, rounded up to a power of two
+//! Only when neither the producer nor the consumer is running.
+//!
+//! @returns: nothing
+//!************************************************************************
+void AudioRingBuffer::setCapacity
+    (
+    const size_t    aMinCapacity    //!< minimum capacity [bytes]
+    )
+{
+    size_t capacity = 1;
+
+    while( capacity < aMinCapacity )
+    {
+        capacity <<= 1;
+    }
+
+    if( capacity != mData.size() )
+    {
+        mData.assign( capacity, 0 );
+        mMask = capacity - 1;
+    }
+
+    reset();
+}
+
+
+//!************************************************************************
+//! Write up to aLength bytes
+//! Called only by the producer.
+//!
+//! @returns: the number of bytes written
+//!************************************************************************
+size_t AudioRingBuffer::write
+    (
+    const char*     aData,          //!< source
+    const size_t    aLength         //!< bytes to write
+    )
+{
+    const size_t writePos = mWritePos.load( std::memory_order_relaxed );
+    const size_t freeBytes = mData.size() - ( writePos - mReadPos.load( std::memory_order_acquire ) );
+    const size_t count = std::min( aLength, freeBytes );
+
+    if( count )
+    {
+        const size_t start = writePos & mMask;
+        const size_t firstPart = std::min( count, mData.size() - start );
+        memcpy( mData.data() + start, aData, firstPart );
+        memcpy( mData.data(), aData + firstPart, count - firstPart );
+
+        mWritePos.store( writePos + count, std::memory_order_release );
+    }
+
+    return count;
+}
@@ -0,0 +1,78 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2025 Mihai Ursu                                                 //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+/*
+AudioRingBuffer.h
+This file contains the definitions for the lock-free audio ring buffer.
+*/
+
+#ifndef AudioRingBuffer_h
+#define AudioRingBuffer_h
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+
+//************************************************************************
+// Class for passing audio bytes from one producer thread to one consumer
+// thread without locks. Each position is written by one side only, so
+// reading and writing never wait and never allocate.
+//************************************************************************
+class AudioRingBuffer
+{
+    //************************************************************************
+    // functions
+    //************************************************************************
+    public:
+        AudioRingBuffer();
+
+        size_t getCapacity() const;
+
+        size_t getFilledBytes() const;
+
+        size_t read
+            (
+            char*           aData,          //!< destination
+            const size_t    aLength         //!< requested bytes
+            );
+
+        void reset();
+
+        void setCapacity
+            (
+            const size_t    aMinCapacity    //!< minimum capacity [bytes]
+            );
+
+        size_t write
+            (
+            const char*     aData,          //!< source
+            const size_t    aLength         //!< bytes to write
+            );
+
+
+    //************************************************************************
+    // variables
+    //************************************************************************
+    private:
+        std::vector<char>       mData;              //!< storage, its size is a power of two
+        size_t                  mMask;              //!< capacity - 1
+        std::atomic<size_t>     mWritePos;          //!< total bytes written, owned by the producer
+        std::atomic<size_t>     mReadPos;           //!< total bytes read, owned by the consumer
+};
+
+#endif // AudioRingBuffer_h
@@ -22,6 +22,8 @@ This file contains the sources for the audio source.
 
 #include "AudioSource.h"
 
+#include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <cstdlib>
 #include <cstring>
@@ -29,8 +31,6 @@ This file contains the sources for the audio source.
 #include <iostream>
 #include <fstream>
 
-#include "NoisePwrSpectrum.h"
-
 
 //!************************************************************************
 //! Constructor
@@ -42,9 +42,61 @@ AudioSource::AudioSource
     )
     : mAudioFormat( aFormat )
     , mAudioBufferLengthSeconds( aBufferLengthSeconds )
-    , mBufferPos( 0 )
+    , mWaveformPos( 0 )
+    , mContinuous( false )
+    , mBandLimited( false )
+    , mLastValue( 0 )
+    , mLastCrossed( false )
+    , mLowWaterSeconds( LOW_WATER_SECONDS_DEFAULT )
+    , mHighWaterSeconds( HIGH_WATER_SECONDS_DEFAULT )
+    , mLowWaterBytes( 0 )
+    , mHighWaterBytes( 0 )
+    , mRingChannels( 1 )
+    , mConvertFrames( nullptr )
+    , mStopRender( false )
+    , mUnderrunsCount( 0 )
+    , mRampSeconds( RAMP_SECONDS_DEFAULT )
+    , mPreviousPos( 0 )
+    , mRampFrames( 0 )
+    , mRampFramesLeft( 0 )
+    , mFramesRendered( 0 )
+    , mSwitchWaitFrames( 0 )
+    , mSwitchPending( false )
 {
     srand( time( NULL ) );
+    mReadFrames.resize( static_cast<size_t>( READ_CHUNK_FRAMES ) * std::max( mAudioFormat.channelCount(), 1 ) );
+
+    switch( mAudioFormat.sampleFormat() )
+    {
+        case QAudioFormat::UInt8:
+            mConvertFrames = &AudioSource::convertFrames<uint8_t>;
+            break;
+
+        case QAudioFormat::Int16:
+            mConvertFrames = &AudioSource::convertFrames<int16_t>;
+            break;
+
+        case QAudioFormat::Int32:
+            mConvertFrames = &AudioSource::convertFrames<int32_t>;
+            break;
+
+        case QAudioFormat::Float:
+            mConvertFrames = &AudioSource::convertFrames<float>;
+            break;
+
+        default:
+            break;
+    }
+}
+
+
+//!************************************************************************
+//! Destructor
+//! Stops the render thread
+//!************************************************************************
+AudioSource::~AudioSource()
+{
+    stopRenderThread();
 }
 
 
@@ -56,786 +108,1221 @@ AudioSource::AudioSource
 //!************************************************************************
 qint64 AudioSource::bytesAvailable() const
 {
-    return mAudioBuffer.size() + QIODevice::bytesAvailable();
+    // readData() always delivers, padding with silence if the ring runs dry
+    const qint64 ringFrameBytes = mRingChannels * sizeof( float );
+    const qint64 framesCount = std::max<qint64>( mRing.getFilledBytes(), mLowWaterBytes ) / ringFrameBytes;
+
+    return framesCount * mAudioFormat.bytesPerFrame() + QIODevice::bytesAvailable();
 }
 
 
 //!************************************************************************
-//! Fill the audio buffer with generated data
+//! Add the values of the traces routed to individual output channels
+//! All channel-specific traces are evaluated at the same moment, so that
+//! they stay time-aligned with each other.
 //!
 //! @returns: nothing
 //!************************************************************************
-void AudioSource::fillDataBuffer()
+void AudioSource::addChannelSignalValues
+    (
+    const std::vector<const SignalItem::SignalSmc*>&    aChannelTraces,     //!< traces routed to channels
+    const double                                        aTime,              //!< time
+    std::vector<double>&                                aChannelValues      //!< values for each output channel
+    ) const
 {
-    const int CHANNEL_BYTES = mAudioFormat.bytesPerSample();
-    qint64 bufferLength = mAudioFormat.bytesForDuration( mAudioBufferLengthSeconds * 1000000 );
-    std::vector<double> totalNoiseBuffer( bufferLength );
-
-    for( size_t k = 0; k < mSignalsVector.size(); k++ )
+    for( size_t i = 0; i < aChannelTraces.size(); i++ )
     {
-        if( SignalItem::SIGNAL_TYPE_NOISE == mSignalsVector.at( k )->getType() )
-        {
-            std::vector<double> crtNoiseBuffer( bufferLength );
-
-            for( size_t i = 0; i < bufferLength; i++ )
-            {
-                double time = static_cast<double>( i % mAudioFormat.sampleRate() ) / mAudioFormat.sampleRate();
-                time += static_cast<size_t>( i / mAudioFormat.sampleRate() );
-                crtNoiseBuffer.at( i ) = getSignalValueNoise( mSignalsVector.at( k )->getSignalDataNoise(), time );
-            }
-
-            SignalItem::SignalNoise sig = mSignalsVector.at( k )->getSignalDataNoise();
-
-            if( 0 == sig.gamma ) // white noise
-            {
-                for( size_t i = 0; i < bufferLength; i++ )
-                {
-                    totalNoiseBuffer.at( i ) += crtNoiseBuffer.at( i );
-                }
-            }
-            else // any value in [-2..2] except 0
-            {
-                NoisePwrSpectrum noisePwrSpectrum( sig.gamma );
-                std::vector<double> filteredNoiseBuffer( bufferLength );
-                noisePwrSpectrum.filterData( crtNoiseBuffer, filteredNoiseBuffer );
+        const SignalItem::SignalSmc& sig = *aChannelTraces.at( i );
 
-                for( size_t i = 0; i < bufferLength; i++ )
-                {
-                    totalNoiseBuffer.at( i ) += filteredNoiseBuffer.at( i );
-                }
-            }
+        if( static_cast<size_t>( sig.channel ) < aChannelValues.size() )
+        {
+            aChannelValues.at( sig.channel ) += getSignalValueSmc( sig, aTime );
         }
     }
+}
 
-    mAudioBuffer.resize( bufferLength );
-    unsigned char* bufferData = reinterpret_cast<unsigned char *>( mAudioBuffer.data() );
 
-    const bool SAVE_TO_RAW_FILE = false;
-    std::ofstream outputFile;
+//!************************************************************************
+//! Smooth the corners of a component which fall near a run of frames
+//! Periodic corners repeat in every period around the run, the others
+//! happen once.
+//!
+//! @returns: nothing
+//!************************************************************************
+void AudioSource::addCornerCorrections
+    (
+    const ComponentState&   aState,         //!< component state
+    const double            aStartTime,     //!< time of the first frame, in the period if periodic [s]
+    const double            aSamplePeriod,  //!< time between frames [s]
+    double*                 aValues,        //!< values the corrections are added to
+    const size_t            aFramesCount    //!< number of frames
+    )
+{
+    const double period = aState.period;
+    double firstPeriod = 0;
+    double lastPeriod = 0;
 
-    if( SAVE_TO_RAW_FILE )
+    if( period > 0 )
     {
-        outputFile.open( "out_raw.txt" );
+        firstPeriod = std::floor( ( aStartTime - aSamplePeriod ) / period );
+        lastPeriod = std::floor( ( aStartTime + aFramesCount * aSamplePeriod ) / period );
     }
 
-    for( size_t i = 0; bufferLength > 0; i++ )
+    for( double m = firstPeriod; m <= lastPeriod; m++ )
     {
-        double time = static_cast<double>( i % mAudioFormat.sampleRate() ) / mAudioFormat.sampleRate();
-        time += static_cast<size_t>( i / mAudioFormat.sampleRate() );
-        double yGenerated = getSignalValue( time );
-        yGenerated += totalNoiseBuffer.at( i );
-
-        for( int j = 0; j < mAudioFormat.channelCount(); j++ )
+        for( const Corner& corner : aState.cornerVec )
         {
-            if( 0 == j )
-            {
-                if( SAVE_TO_RAW_FILE && outputFile.is_open() )
-                {
-                    QString line = QString::number( time ) + "\t" + QString::number( yGenerated ) + "\n";
-                    outputFile << line.toStdString();
-                }
-            }
-
-            switch( mAudioFormat.sampleFormat() )
-            {
-                case QAudioFormat::UInt8:
-                    *reinterpret_cast<uint8_t*>( bufferData ) = static_cast<uint8_t>( 255 * ( 1.0 + yGenerated ) / 2 );
-                    break;
-
-                case QAudioFormat::Int16:
-                    *reinterpret_cast<int16_t*>( bufferData ) = static_cast<int16_t>( yGenerated * 32767 );
-                    break;
+            addEdgeCorrection( ( m * period + corner.t - aStartTime ) / aSamplePeriod,
+                               corner.step,
+                               corner.slopeStep * aSamplePeriod,
+                               aValues,
+                               aFramesCount );
+        }
+    }
+}
 
-                case QAudioFormat::Int32:
-                    *reinterpret_cast<int32_t*>( bufferData ) = static_cast<int32_t>( yGenerated * std::numeric_limits<int32_t>::max() );
-                    break;
 
-                case QAudioFormat::Float:
-                    *reinterpret_cast<float*>( bufferData ) = yGenerated;
-                    break;
+//!************************************************************************
+//! Smooth a discontinuity and a kink with their polynomial residuals
+//! The two frames around the corner get the difference between the
+//! band-limited step (PolyBLEP) and ramp (PolyBLAMP) and their naive
+//! samples; a frame falling on the corner holds the value before it.
+//!
+//! @returns: nothing
+//!************************************************************************
+void AudioSource::addEdgeCorrection
+    (
+    const double        aPosition,      //!< corner position from the first frame [frames]
+    const double        aStep,          //!< value change at the corner
+    const double        aSlopeStep,     //!< slope change at the corner [1/frame]
+    double*             aValues,        //!< values the correction is added to
+    const size_t        aFramesCount    //!< number of frames
+    )
+{
+    const double first = std::max( std::floor( aPosition ), 0.0 );
+    const double last = std::min( std::floor( aPosition ) + 1, static_cast<double>( aFramesCount ) - 1 );
 
-                default:
-                    break;
-            }
+    for( double i = first; i <= last; i++ )
+    {
+        const double d = i - aPosition;
 
-            bufferData += CHANNEL_BYTES;
-            bufferLength -= CHANNEL_BYTES;
+        if( d <= 0 && d > -1 )
+        {
+            const double r = 1 + d;
+            aValues[static_cast<size_t>( i )] += aStep * r * r / 2 + aSlopeStep * r * r * r / 6;
+        }
+        else if( d > 0 && d < 1 )
+        {
+            const double r = 1 - d;
+            aValues[static_cast<size_t>( i )] += -aStep * r * r / 2 + aSlopeStep * r * r * r / 6;
         }
-    }    
-
-    if( SAVE_TO_RAW_FILE && outputFile.is_open() )
-    {
-        outputFile.close();
     }
 }
 
 
 //!************************************************************************
-//! Generate a random number
-//! adapted from Knuth, D.E. - The Art of Computer Programming
-//!                            Volume 2, Seminumerical Algorithms
-//!                            3rd Ed, Addison-Wesley, 1997
+//! Append a linear piece to the period of a piecewise-linear component
+//! The piece starts where the previous one ends.
 //!
-//! @returns: a random double in [0..1]
+//! @returns: nothing
 //!************************************************************************
-double AudioSource::generateRandomDek
+void AudioSource::addSegment
     (
-    int32_t*   pIdum        //!< seed value
-    ) const
+    ComponentState&     aState,         //!< component state
+    const double        aEnd,           //!< end in the period, included [s]
+    const double        aStartValue,    //!< value at the start
+    const double        aSlope          //!< value change per second [1/s]
+    )
 {
-    const int32_t MBIG = 1000000000;
-    const int32_t MSEED = 161803398;
-    const int32_t MZ = 0;
-    const double FAC = 1.0 / MBIG;
+    Segment segment;
+    segment.tStart = aState.segmentVec.size() ? aState.segmentVec.back().tEnd : 0;
+    segment.tEnd = aEnd;
+    segment.yStart = aStartValue;
+    segment.slope = aSlope;
 
-    static int32_t inext;
-    static int32_t inextp;
-    static int32_t ma[56];
-    static int32_t iff = 0;
-    int32_t mj;
-    int32_t mk;
-    int32_t i;
-    int32_t ii;
-    int32_t k;
+    aState.segmentVec.push_back( segment );
+}
 
-    if( *pIdum < 0 || iff == 0 )
-    {
-        iff = 1;
-        mj = labs( MSEED - labs( *pIdum ) );
-        mj %= MBIG;
-        ma[55] = mj;
-        mk = 1;
 
-        for( i = 1; i <= 54; i++ )
-        {
-            ii = ( 21 * i ) % 55;
-            ma[ii] = mk;
-            mk = mj - mk;
+//!************************************************************************
+//! Add the values of a piecewise-linear component by walking its pieces
+//! The piece and the frames left in it are found once for each run, which
+//! is then a constant or a linear ramp, so that the work per frame is a
+//! single addition.
+//!
+//! @returns: nothing
+//!************************************************************************
+void AudioSource::addSegmentValues
+    (
+    ComponentState&     aState,         //!< component state
+    const double        aSamplePeriod,  //!< time between frames [s]
+    double*             aValues,        //!< values the signal is added to
+    const size_t        aFramesCount    //!< number of frames
+    )
+{
+    const std::vector<Segment>& segments = aState.segmentVec;
+    size_t framesDone = 0;
 
-            if( mk < MZ )
-            {
-                mk += MBIG;
-            }
+    while( aFramesCount > framesDone && segments.size() )
+    {
+        const double pos = aState.periodPos;
+        size_t k = 0;
 
-            mj = ma[ii];
+        while( k + 1 < segments.size() && pos > segments.at( k ).tEnd )
+        {
+            k++;
         }
 
-        for( k = 1; k <= 4; k++ )
+        const Segment& segment = segments.at( k );
+        double runFrames = static_cast<double>( aFramesCount - framesDone );
+
+        if( aState.period > 0 )
         {
-            for( i = 1; i <= 55; i++ )
+            // up to the frame at the end of the piece, and before the period wraps
+            if( k + 1 < segments.size() )
             {
-                ma[i] -= ma[ 1 + ( i + 30 ) % 55 ];
-
-                if( ma[i] < MZ )
-                {
-                    ma[i] += MBIG;
-                }
+                runFrames = std::min( runFrames, std::floor( ( segment.tEnd - pos ) / aSamplePeriod ) + 1 );
             }
+
+            runFrames = std::min( runFrames, std::ceil( ( aState.period - FRAME_ROUNDING * aSamplePeriod - pos ) / aSamplePeriod ) );
+            runFrames = std::max( runFrames, 1.0 );
         }
 
-        inext = 0;
-        inextp = 31;
-        *pIdum = 1;
-    }
+        const size_t count = static_cast<size_t>( runFrames );
+        const double yStart = segment.yStart + segment.slope * ( pos - segment.tStart );
+        const double yStep = segment.slope * aSamplePeriod;
+        double* values = aValues + framesDone;
 
-    if( ++inext == 56 )
-    {
-        inext = 1;
-    }
+        for( size_t i = 0; i < count; i++ )
+        {
+            values[i] += yStart + yStep * i;
+        }
 
-    if( ++inextp == 56 )
-    {
-        inextp = 1;
-    }
+        if( aState.period > 0 )
+        {
+            aState.periodPos = pos + count * aSamplePeriod;
 
-    mj = ma[inext] - ma[inextp];
+            while( aState.periodPos >= aState.period - FRAME_ROUNDING * aSamplePeriod )
+            {
+                aState.periodPos -= aState.period;
+                aState.periodIndex++;
+            }
+        }
 
-    if( mj < MZ )
-    {
-        mj += MBIG;
+        framesDone += count;
     }
-
-    ma[inext] = mj;
-
-    return ( double )( mj * FAC );
 }
 
 
 //!************************************************************************
-//! Generate a random number
-//! adapted from Press, W.H. et al - Numerical Recipes in C. The Art of Scientific Computing
-//!                                  2nd Ed, Cambridge Univ. Press, 1992
+//! Smooth the corners of a TrapDampSin component near a run of frames
+//! The envelope kinks of each burst bend the sine, and the end of the
+//! signal at the cross time is a jump to the offset.
 //!
-//! see ran4(), subchapter 7.5, pp. 303
-//!
-//! @returns: a random double in [0..1]
+//! @returns: nothing
 //!************************************************************************
-double AudioSource::generateRandomNag
+void AudioSource::addTrapDampSinCorrections
     (
-    int32_t*   pIdum        //!< seed value
-    ) const
+    const SignalItem::SignalTrapDampSin&    aSignalData,    //!< TrapDampSin signal data
+    const double                            aStartTime,     //!< time of the first frame [s]
+    const double                            aSamplePeriod,  //!< time between frames [s]
+    double*                                 aValues,        //!< values the corrections are added to
+    const size_t                            aFramesCount    //!< number of frames
+    )
 {
-    const uint32_t JFLONE = 0x3f800000;
-    const uint32_t JFLMSK = 0x007fffff;
-    static int32_t idums = 0;
+    const double tPeriod = aSignalData.tPeriod;
+    const double tEnd = aStartTime + aFramesCount * aSamplePeriod;
 
-    if( *pIdum < 0 )
+    if( tPeriod <= 0 || aSignalData.tCross <= 0 )
     {
-        idums = -( *pIdum );
-        *pIdum = 1;
+        return;
     }
 
-    uint32_t irword = *pIdum;
-    uint32_t lword = idums;
-    pseudoDes( &lword, &irword );
-    uint32_t itemp = JFLONE | ( JFLMSK & irword );
-    ++( *pIdum );
-
-    return ( *reinterpret_cast< float* >( &itemp ) - 1.0 );
-}
+    // rise, width, fall and quiet pieces of a burst, clipped to the period
+    double bounds[5] = { 0,
+                         aSignalData.tRise,
+                         aSignalData.tRise + aSignalData.tWidth,
+                         aSignalData.tRise + aSignalData.tWidth + aSignalData.tFall,
+                         tPeriod };
 
+    for( double& bound : bounds )
+    {
+        bound = std::min( bound, tPeriod );
+    }
 
-//!************************************************************************
-//! Get the value of the entire signal, obtained by superposition
-//! through the entire vector *without noise*
-//!
-//! @returns The value of the signal at a specified moment
-//!************************************************************************
-double AudioSource::getSignalValue
-    (
-    const double aTime      //!< time
-    ) const
-{
-    double y = 0;
+    const double omega = 2 * M_PI * aSignalData.freqHz;
 
-    for( size_t i = 0; i < mSignalsVector.size(); i++ )
+    // value and slope of the burst, without the offset
+    auto evaluate = [&]( const int aPiece, const double aPeriodIndex, const double aTimeInPeriod, double& aValue, double& aSlope )
     {
-        switch( mSignalsVector.at( i )->getType() )
-        {
-            case SignalItem::SIGNAL_TYPE_TRIANGLE:
-                y += getSignalValueTriangle( mSignalsVector.at( i )->getSignalDataTriangle(), aTime );
-                break;
+        const double tPerStart = aSignalData.tDelay + aPeriodIndex * tPeriod;
+        const double yEnvRise = aSignalData.amplit * ( aSignalData.tCross - tPerStart - aSignalData.tRise ) / aSignalData.tCross;
+        const double yEnvFall = aSignalData.amplit * ( aSignalData.tCross - tPerStart - aSignalData.tRise - aSignalData.tWidth ) / aSignalData.tCross;
+        double env = 0;
+        double envSlope = 0;
 
-            case SignalItem::SIGNAL_TYPE_RECTANGLE:
-                y += getSignalValueRectangle( mSignalsVector.at( i )->getSignalDataRectangle(), aTime );
+        switch( aPiece )
+        {
+            case 0:
+                env = aTimeInPeriod / aSignalData.tRise * yEnvRise;
+                envSlope = yEnvRise / aSignalData.tRise;
                 break;
 
-            case SignalItem::SIGNAL_TYPE_PULSE:
-                y += getSignalValuePulse( mSignalsVector.at( i )->getSignalDataPulse(), aTime );
+            case 1:
+                env = yEnvRise - aSignalData.amplit * ( aTimeInPeriod - aSignalData.tRise ) / aSignalData.tCross;
+                envSlope = -aSignalData.amplit / aSignalData.tCross;
                 break;
 
-            case SignalItem::SIGNAL_TYPE_RISEFALL:
-                y += getSignalValueRiseFall( mSignalsVector.at( i )->getSignalDataRiseFall(), aTime );
+            case 2:
+                env = ( 1 - ( aTimeInPeriod - aSignalData.tRise - aSignalData.tWidth ) / aSignalData.tFall ) * yEnvFall;
+                envSlope = -yEnvFall / aSignalData.tFall;
                 break;
 
-            case SignalItem::SIGNAL_TYPE_SINDAMP:
-                y += getSignalValueSinDamp( mSignalsVector.at( i )->getSignalDataSinDamp(), aTime );
+            default:
                 break;
+        }
 
-            case SignalItem::SIGNAL_TYPE_SINRISE:
-                y += getSignalValueSinRise( mSignalsVector.at( i )->getSignalDataSinRise(), aTime );
-                break;
+        aValue = env * sin( omega * aTimeInPeriod );
+        aSlope = envSlope * sin( omega * aTimeInPeriod ) + env * omega * cos( omega * aTimeInPeriod );
+    };
 
-            case SignalItem::SIGNAL_TYPE_WAVSIN:
-                y += getSignalValueWavSin( mSignalsVector.at( i )->getSignalDataWavSin(), aTime );
-                break;
+    const double firstPeriod = std::max( std::floor( ( aStartTime - aSamplePeriod - aSignalData.tDelay ) / tPeriod ), 0.0 );
+    const double lastPeriod = std::floor( ( std::min( tEnd, aSignalData.tCross ) - aSignalData.tDelay ) / tPeriod );
 
-            case SignalItem::SIGNAL_TYPE_AMSIN:
-                y += getSignalValueAmSin( mSignalsVector.at( i )->getSignalDataAmSin(), aTime );
-                break;
+    for( double k = firstPeriod; k <= lastPeriod; k++ )
+    {
+        for( int piece = 0; piece < 4; piece++ )
+        {
+            const double tCorner = aSignalData.tDelay + k * tPeriod + bounds[piece];
 
-            case SignalItem::SIGNAL_TYPE_SINDAMPSIN:
-                y += getSignalValueSinDampSin( mSignalsVector.at( i )->getSignalDataSinDampSin(), aTime );
-                break;
+            // corners of nonempty pieces, the first one is the start of the component
+            if( bounds[piece + 1] <= bounds[piece]
+             || ( 0 == k && 0 == bounds[piece] )
+             || tCorner >= aSignalData.tCross
+              )
+            {
+                continue;
+            }
 
-            case SignalItem::SIGNAL_TYPE_TRAPDAMPSIN:
-                y += getSignalValueTrapDampSin( mSignalsVector.at( i )->getSignalDataTrapDampSin(), aTime );
-                break;
+            int leftPiece = piece;
+            double leftPeriod = k;
 
-            case SignalItem::SIGNAL_TYPE_SMC:
-                y += getSignalValueSmc( mSignalsVector.at( i )->getSignalDataSmc(), aTime );
-                break;
+            do
+            {
+                if( 0 == leftPiece )
+                {
+                    leftPiece = 4;
+                    leftPeriod--;
+                }
 
-            case SignalItem::SIGNAL_TYPE_NOISE: // intentionally skip noise type
-            default:
-                break;
+                leftPiece--;
+            } while( bounds[leftPiece + 1] <= bounds[leftPiece] );
+
+            double yLeft = 0;
+            double slopeLeft = 0;
+            double yRight = 0;
+            double slopeRight = 0;
+            evaluate( leftPiece, leftPeriod, bounds[leftPiece + 1], yLeft, slopeLeft );
+            evaluate( piece, k, bounds[piece], yRight, slopeRight );
+
+            addEdgeCorrection( ( tCorner - aStartTime ) / aSamplePeriod,
+                               yRight - yLeft,
+                               ( slopeRight - slopeLeft ) * aSamplePeriod,
+                               aValues,
+                               aFramesCount );
         }
     }
 
-    return y;
+    // the burst stops at the cross time
+    if( aSignalData.tCross > aStartTime - aSamplePeriod
+     && aSignalData.tCross < tEnd
+     && aSignalData.tCross > aSignalData.tDelay
+      )
+    {
+        const double k = std::floor( ( aSignalData.tCross - aSignalData.tDelay ) / tPeriod );
+        const double tInPer = aSignalData.tCross - aSignalData.tDelay - k * tPeriod;
+        int piece = 0;
+
+        while( piece < 3 && tInPer > bounds[piece + 1] )
+        {
+            piece++;
+        }
+
+        double yLeft = 0;
+        double slopeLeft = 0;
+        evaluate( piece, k, tInPer, yLeft, slopeLeft );
+
+        addEdgeCorrection( ( aSignalData.tCross - aStartTime ) / aSamplePeriod,
+                           -yLeft,
+                           -slopeLeft * aSamplePeriod,
+                           aValues,
+                           aFramesCount );
+    }
 }
 
 
 //!************************************************************************
-//! Get the value of a Triangle signal
+//! Add the values of a component played from its band-limited wavetable
+//! The table is read with linear interpolation at the phase of the cycle.
 //!
-//! @returns The signal value at a specified moment
+//! @returns: nothing
 //!************************************************************************
-double AudioSource::getSignalValueTriangle
+void AudioSource::addWavetableValues
     (
-    const SignalItem::SignalTriangle    aSignalData,    //!< Triangle signal data
-    const double                        aTime           //!< time
-    ) const
+    ComponentState&     aState,         //!< component state
+    double*             aValues,        //!< values the signal is added to
+    const size_t        aFramesCount    //!< number of frames
+    )
 {
-    double y = 0;
+    const float* table = aState.table;
+    double phase = aState.phase;
 
-    if( aTime >= aSignalData.tDelay )
+    for( size_t i = 0; i < aFramesCount; i++ )
     {
-        double dt0 = aTime - aSignalData.tDelay;
-        uint32_t kPer = dt0 / aSignalData.tPeriod;
-        double tInPer = dt0 - kPer * aSignalData.tPeriod;
+        const double pos = phase * WavetableBank::TABLE_SIZE;
+        const size_t k = std::min( static_cast<size_t>( pos ), WavetableBank::TABLE_SIZE - 1 );
+        const double y = table[k] + ( pos - k ) * ( table[k + 1] - table[k] );
 
-        if( tInPer <= aSignalData.tRise )
-        {
-            y = aSignalData.yMin + ( aSignalData.yMax - aSignalData.yMin ) * tInPer / aSignalData.tRise;
-        }
-        else
-        {
-            y = aSignalData.yMax - ( aSignalData.yMax - aSignalData.yMin ) * ( tInPer - aSignalData.tRise ) / aSignalData.tFall;
-        }
+        aValues[i] += aState.tableOffset + aState.tableScale * y;
+
+        phase += aState.phaseStep;
+        phase -= std::floor( phase );
     }
 
-    return y;
+    aState.phase = phase;
 }
 
 
 //!************************************************************************
-//! Get the value of a Rectangle signal
+//! Advance the state of a component by one frame
+//! The phases are kept wrapped to one cycle and the period position to one
+//! period, so that neither grows with the elapsed time.
 //!
-//! @returns The signal value at a specified moment
+//! @returns: nothing
 //!************************************************************************
-double AudioSource::getSignalValueRectangle
+void AudioSource::advanceComponentState
     (
-    const SignalItem::SignalRectangle   aSignalData,    //!< Rectangle signal data
-    const double                        aTime           //!< time
-    ) const
+    ComponentState&     aState,         //!< component state
+    const double        aSamplePeriod   //!< time between frames [s]
+    )
 {
-    double y = 0;
-
-    if( aTime >= aSignalData.tDelay )
+    aState.phase += aState.phaseStep;
+    aState.phase -= std::floor( aState.phase );
+    aState.auxPhase += aState.auxPhaseStep;
+    aState.auxPhase -= std::floor( aState.auxPhase );
+    aState.envelope *= aState.envelopeRatio;
+    aState.auxEnvelope *= aState.auxEnvelopeRatio;
+
+    if( aState.period > 0 )
     {
-        double dt0 = aTime - aSignalData.tDelay;
-        uint32_t kPer = dt0 / aSignalData.tPeriod;
-        double tInPer = dt0 - kPer * aSignalData.tPeriod;
+        aState.periodPos += aSamplePeriod;
 
-        if( tInPer <= aSignalData.tPeriod * aSignalData.fillFactor )
+        // a period end within rounding starts the next period on this frame
+        while( aState.periodPos >= aState.period - FRAME_ROUNDING * aSamplePeriod )
         {
-            y = aSignalData.yMax;
-        }
-        else
-        {
-            y = aSignalData.yMin;
+            aState.periodPos -= aState.period;
+            aState.periodIndex++;
+            aState.envelope *= aState.periodRatio;
         }
     }
-
-    return y;
-}
+}
 
 
 //!************************************************************************
-//! Get the value of a Pulse signal
+//! Copy the looped waveform being played
+//! A single plane is repeated on all ring channels. Silence is produced
+//! if there is no waveform.
 //!
-//! @returns The signal value at a specified moment
+//! @returns: nothing
 //!************************************************************************
-double AudioSource::getSignalValuePulse
+void AudioSource::copyWaveform
     (
-    const SignalItem::SignalPulse       aSignalData,    //!< Pulse signal data
-    const double                        aTime           //!< time
-    ) const
+    float*          aFrames,        //!< destination, interleaved ring frames
+    const size_t    aFramesCount    //!< number of frames
+    )
 {
-    double y = 0;
+    const size_t CHANNELS_COUNT = mRingChannels;
 
-    if( aTime >= aSignalData.tDelay )
+    if( mWaveform && mWaveform->framesCount )
     {
-        double dt0 = aTime - aSignalData.tDelay;
-        uint32_t kPer = dt0 / aSignalData.tPeriod;
-        double tInPer = dt0 - kPer * aSignalData.tPeriod;
+        const std::vector<std::vector<float>>& planes = mWaveform->planeVec;
+        size_t framesDone = 0;
 
-        if( tInPer <= aSignalData.tRise )
-        {
-            y = aSignalData.yMin + ( aSignalData.yMax - aSignalData.yMin ) * tInPer / aSignalData.tRise;
-        }
-        else if( tInPer <= aSignalData.tRise + aSignalData.tWidth )
-        {
-            y = aSignalData.yMax;
-        }
-        else if( tInPer <= aSignalData.tRise + aSignalData.tWidth + aSignalData.tFall )
+        while( aFramesCount > framesDone )
         {
-            y = aSignalData.yMax - ( aSignalData.yMax - aSignalData.yMin ) * ( tInPer - aSignalData.tRise - aSignalData.tWidth ) / aSignalData.tFall;
+            const size_t chunk = std::min( mWaveform->framesCount - mWaveformPos, aFramesCount - framesDone );
+            float* frames = aFrames + framesDone * CHANNELS_COUNT;
+
+            if( 1 == CHANNELS_COUNT )
+            {
+                memcpy( frames, planes.front().data() + mWaveformPos, chunk * sizeof( float ) );
+            }
+            else
+            {
+                for( size_t i = 0; i < chunk; i++ )
+                {
+                    for( size_t j = 0; j < CHANNELS_COUNT; j++ )
+                    {
+                        frames[i * CHANNELS_COUNT + j] = planes[std::min( j, planes.size() - 1 )][mWaveformPos + i];
+                    }
+                }
+            }
+
+            mWaveformPos = ( mWaveformPos + chunk ) % mWaveform->framesCount;
+            framesDone += chunk;
         }
-        else
+
+        if( mRampFramesLeft )
         {
-            y = aSignalData.yMin;
+            rampFromPreviousWaveform( aFrames, aFramesCount );
         }
     }
-
-    return y;
+    else
+    {
+        std::fill( aFrames, aFrames + aFramesCount * CHANNELS_COUNT, 0.0f );
+    }
 }
 
 
 //!************************************************************************
-//! Get the value of an exponential RiseFall signal
+//! Queue a signal list to replace the one being played
+//! The new waveform is rendered here, on the caller's thread, and the
+//! render thread switches to it exactly at the requested boundary. When
+//! not playing, the new waveform is used at once.
 //!
-//! @returns The signal value at a specified moment
+//! @returns: nothing
 //!************************************************************************
-double AudioSource::getSignalValueRiseFall
+void AudioSource::cueData
     (
-    const SignalItem::SignalRiseFall    aSignalData,    //!< RiseFall signal data
-    const double                        aTime           //!< time
-    ) const
+    const SignalList::Snapshot&     aSignals,           //!< signals
+    const SwitchSettings&           aSettings           //!< where and how to switch
+    )
 {
-    double y = 0;
-
-    if( aTime >= aSignalData.tDelay )
+    if( !mRenderThread.joinable() || mSmcPlaylist )
     {
-        if( aTime <= aSignalData.tDelayRise )
-        {
-            y = aSignalData.yMin;
-        }
-        else if( aTime > aSignalData.tDelayRise
-              && aTime <= aSignalData.tDelayFall
-               )
-        {
-            y = aSignalData.yMin
-                + ( aSignalData.yMax - aSignalData.yMin ) * ( 1. - exp( -( aTime - aSignalData.tDelayRise ) / aSignalData.tRampRise ) );
-
-        }
-        else if( aTime > aSignalData.tDelayFall )
-        {
-            y = aSignalData.yMin
-                + ( aSignalData.yMax - aSignalData.yMin ) * ( 1. - exp( -( aTime - aSignalData.tDelayRise ) / aSignalData.tRampRise ) )
-                + ( aSignalData.yMin - aSignalData.yMax ) * ( 1. - exp( -( aTime - aSignalData.tDelayFall ) / aSignalData.tRampFall ) );
-        }
+        setData( aSignals );
     }
+    else
+    {
+        mSignals = aSignals;
 
-    return y;
+        std::shared_ptr<SwitchRequest> request = std::make_shared<SwitchRequest>();
+        renderSnapshot( *request );
+        request->settings = aSettings;
+
+        mSwitchPending = true;
+        std::atomic_store( &mPendingSwitch, std::shared_ptr<const SwitchRequest>( request ) );
+    }
 }
 
 
 //!************************************************************************
-//! Get the value of a SinDamp signal
+//! Fill a waveform with generated data
+//! The samples are kept as floats in [-1..1]. Channels which carry the
+//! same signal share one plane; separate planes are only made when traces
+//! are routed to individual channels.
 //!
-//! @returns The signal value at a specified moment
+//! @returns: nothing
 //!************************************************************************
-double AudioSource::getSignalValueSinDamp
+void AudioSource::fillWaveform
     (
-    const SignalItem::SignalSinDamp     aSignalData,    //!< SinDamp signal data
-    const double                        aTime           //!< time
-    ) const
+    Waveform&       aWaveform       //!< filled waveform
+    )
 {
-    double y = 0;
+    const size_t framesCount = static_cast<size_t>( mAudioBufferLengthSeconds * mAudioFormat.sampleRate() );
 
-    if( aTime >= aSignalData.tDelay )
-    {
-        double dt0 = aTime - aSignalData.tDelay;
+    Generator generator;
+    initGenerator( generator, mSignals );
 
-        y = aSignalData.offset
-            + aSignalData.amplit * sin( 2 * M_PI * aSignalData.freqHz * dt0 + aSignalData.phiRad ) * exp( -aSignalData.damping * dt0 );
-    }
+    const bool SAVE_TO_RAW_FILE = false;
+    std::ofstream outputFile;
 
-    return y;
-}
+    if( SAVE_TO_RAW_FILE )
+    {
+        outputFile.open( "out_raw.txt" );
+    }
 
+    const size_t planesCount = generator.planesCount;
+    aWaveform.planeVec.assign( planesCount, std::vector<float>( framesCount ) );
+    aWaveform.framesCount = framesCount;
 
-//!************************************************************************
-//! Get the value of a SinRise signal
-//!
-//! @returns The signal value at a specified moment
-//!************************************************************************
-double AudioSource::getSignalValueSinRise
-    (
-    const SignalItem::SignalSinRise     aSignalData,    //!< SinRise signal data
-    const double                        aTime           //!< time
-    ) const
-{
-    double y = 0;
+    std::vector<double> values( static_cast<size_t>( RENDER_CHUNK_FRAMES ) * planesCount );
+    size_t framesDone = 0;
 
-    if( aTime >= aSignalData.tDelay )
+    while( framesCount > framesDone )
     {
-        if( aTime < aSignalData.tEnd )
-        {
-            double dtend = aTime - aSignalData.tEnd;
+        const size_t chunkFrames = std::min<size_t>( framesCount - framesDone, RENDER_CHUNK_FRAMES );
+        generateBlock( generator, chunkFrames, values.data() );
 
-            y = aSignalData.offset
-                + aSignalData.amplit * sin( 2 * M_PI * aSignalData.freqHz * dtend + aSignalData.phiRad ) * exp( aSignalData.damping * dtend );
-        }
-        else
+        for( size_t i = 0; i < chunkFrames; i++ )
         {
-            y = aSignalData.offset;
-        }
-    }
-
-    return y;
-}
+            if( SAVE_TO_RAW_FILE && outputFile.is_open() )
+            {
+                QString line = QString::number( ( framesDone + i ) * generator.timebase.samplePeriod ) + "\t" + QString::number( values[i * planesCount] ) + "\n";
+                outputFile << line.toStdString();
+            }
 
+            for( size_t j = 0; j < planesCount; j++ )
+            {
+                aWaveform.planeVec[j][framesDone + i] = static_cast<float>( values[i * planesCount + j] );
+            }
+        }
 
-//!************************************************************************
-//! Get the value of a WavSin signal
-//!
-//! @returns The signal value at a specified moment
-//!************************************************************************
-double AudioSource::getSignalValueWavSin
-    (
-    const SignalItem::SignalWavSin      aSignalData,    //!< WavSin signal data
-    const double                        aTime           //!< time
-    ) const
-{
-    double y = 0;
+        framesDone += chunkFrames;
+    }
 
-    if( aTime >= aSignalData.tDelay )
+    // a loop repeats its tail before frame 0; as the delayed values are
+    // linear in the history, the tail read at each delay is added to the
+    // first frames, so that the loop point of an array is seamless
+    if( framesCount && generator.delayVec.size() )
     {
-        uint8_t N = aSignalData.index;
+        const std::vector<double>& history = generator.historyVec;
+        const uint64_t mask = history.size() - 1;
+        const double delayMax = *std::max_element( generator.delayVec.begin(), generator.delayVec.end() );
+        const size_t tailFrames = static_cast<size_t>( delayMax ) + DELAY_TAPS;
+        size_t tailLength = 1;
 
-        if( N < 3
-         || N % 2 != 1
-          )
+        while( tailLength < 2 * tailFrames + 2 )
         {
-            N = 3;
+            tailLength <<= 1;
         }
 
-        double b = aSignalData.freqHz / N;
-        double T = 0.5 / b;
-        double dt0 = aTime - aSignalData.tDelay;
+        Generator loopTail;
+        loopTail.historyVec.assign( tailLength, 0 );
 
-        if( aTime < T + aSignalData.tDelay )
+        for( size_t k = 1; k <= tailFrames; k++ )
         {
-            y = aSignalData.offset
-                + aSignalData.amplit * sin( 2 * M_PI * b * dt0 ) * sin( 2 * M_PI * aSignalData.freqHz * dt0 );
+            const size_t frame = framesCount - 1 - ( k - 1 ) % framesCount;
+            loopTail.historyVec[tailLength - k] = history[frame & mask];
         }
-    }
 
-    return y;
-}
+        const size_t headFrames = std::min( tailFrames, framesCount );
+        std::vector<double> tailValues( headFrames );
 
+        for( size_t j = 0; j < planesCount; j++ )
+        {
+            readHistory( loopTail, generator.delayVec.at( j ), 0, tailValues.data(), headFrames );
 
-//!************************************************************************
-//! Get the value of a AmSin signal
-//!
-//! @returns The signal value at a specified moment
-//!************************************************************************
-double AudioSource::getSignalValueAmSin
-    (
-    const SignalItem::SignalAmSin       aSignalData,    //!< AmSin signal data
-    const double                        aTime           //!< time
-    ) const
-{
-    double y = 0;
+            for( size_t i = 0; i < headFrames; i++ )
+            {
+                aWaveform.planeVec[j][i] += static_cast<float>( tailValues[i] );
+            }
+        }
+    }
 
-    if( aTime >= aSignalData.carrierTDelay )
+    if( SAVE_TO_RAW_FILE && outputFile.is_open() )
     {
-        double dt0 = aTime - aSignalData.carrierTDelay;
-
-        y = aSignalData.carrierOffset
-            + aSignalData.carrierAmplitude * sin( 2 * M_PI * aSignalData.carrierFreqHz * dt0 )
-            * ( 1 + aSignalData.modulationIndex * cos( 2 * M_PI * aSignalData.modulationFreqHz * dt0 + aSignalData.modulationPhiRad ) );
+        outputFile.close();
     }
-
-    return y;
 }
 
 
 //!************************************************************************
-//! Get the value of a SinDampSin signal
+//! Find where the cued waveform takes over in the next frames
 //!
-//! @returns The signal value at a specified moment
+//! @returns: frames before the switch, aBlockFrames if it is not reached
 //!************************************************************************
-double AudioSource::getSignalValueSinDampSin
+size_t AudioSource::findSwitchOffset
     (
-    const SignalItem::SignalSinDampSin  aSignalData,    //!< SinDampSin signal data
-    const double                        aTime           //!< time
+    const size_t    aBlockFrames    //!< frames of the block being rendered
     ) const
 {
-    double y = 0;
+    const SwitchSettings& settings = mActiveSwitch->settings;
+    const bool hasWaveform = mWaveform && mWaveform->framesCount;
+    size_t offset = 0;
 
-    if( aTime >= aSignalData.tDelay )
+    switch( settings.boundary )
     {
-        double eyeAmplit = aSignalData.amplit;
-        double dt0 = aTime - aSignalData.tDelay;
-        uint32_t kPer = 1 + dt0 / aSignalData.tPeriodEnv;
+        case SWITCH_AT_FRAME:
+            if( settings.frame > mFramesRendered )
+            {
+                offset = static_cast<size_t>( std::min<uint64_t>( settings.frame - mFramesRendered, aBlockFrames ) );
+            }
+            break;
 
-        switch( aSignalData.dampingType )
-        {
-            case 0:
-                break;
+        case SWITCH_AT_PERIOD:
+            {
+                const double periodFrames = settings.periodSeconds * mAudioFormat.sampleRate();
 
-            case -3:
-                eyeAmplit *= exp( kPer - 1.0 );
-                break;
+                if( ( hasWaveform || mGenerator ) && periodFrames >= 1 )
+                {
+                    // the waveform time restarts where the loop wraps, which is also a boundary;
+                    // the generator time never wraps
+                    const uint64_t pos = mGenerator ? mGenerator->timebase.frame : mWaveformPos;
+                    const uint64_t wrapFrames = mGenerator ? aBlockFrames : mWaveform->framesCount - mWaveformPos;
+                    const double nextBoundary = std::ceil( pos / periodFrames ) * periodFrames;
+                    const uint64_t boundaryFrames = static_cast<uint64_t>( std::max<double>( std::round( nextBoundary - pos ), 0 ) );
+
+                    offset = static_cast<size_t>( std::min<uint64_t>( std::min( boundaryFrames, wrapFrames ), aBlockFrames ) );
+                }
+            }
+            break;
 
-            case -2:
-            case -1:
-            case 1:
-            case 2:
-                eyeAmplit *= pow( static_cast<double>( kPer ), -aSignalData.dampingType );
-                break;
+        case SWITCH_AT_ZERO_CROSSING:
+            if( mGenerator )
+            {
+                // the generator cannot look ahead, so it switches on the frame after a crossing
+                const double waitFrames = ZERO_CROSSING_WAIT_SECONDS * mAudioFormat.sampleRate();
 
-            case 3:
-                eyeAmplit *= exp( -( kPer - 1.0 ) );
-                break;
+                if( !mLastCrossed && mSwitchWaitFrames < waitFrames )
+                {
+                    offset = 1;
+                }
+            }
+            else if( hasWaveform && mSwitchWaitFrames < mWaveform->framesCount )
+            {
+                // the first channel is compared with the frame played before
+                const std::vector<float>& plane = mWaveform->planeVec.front();
+                const size_t framesCount = mWaveform->framesCount;
+                float previousValue = plane[( mWaveformPos + framesCount - 1 ) % framesCount];
+                offset = aBlockFrames;
 
-            default:
-                eyeAmplit = 0;
-                break;
-        }
+                for( size_t i = 0; i < aBlockFrames; i++ )
+                {
+                    const float value = plane[( mWaveformPos + i ) % framesCount];
 
-        y = aSignalData.offset
-                + eyeAmplit * sin( M_PI / aSignalData.tPeriodEnv * dt0 ) * sin( 2 * M_PI * aSignalData.freqSinHz * dt0 );
+                    if( ( previousValue < 0 && value >= 0 ) || ( previousValue > 0 && value <= 0 ) )
+                    {
+                        offset = i;
+                        break;
+                    }
+
+                    previousValue = value;
+                }
+            }
+            // without a crossing during a whole loop, switch at once
+            break;
+
+        case SWITCH_AT_BLOCK:
+        default:
+            break;
     }
 
-    return y;
+    return offset;
 }
 
 
 //!************************************************************************
-//! Get the value of a TrapDampSin signal
+//! Evaluate the next block of a generator
+//! Noise is colored sample by sample, so it never repeats. The components
+//! of all channels and those of each channel are summed in their own
+//! planes over the same timebase, then interleaved in one pass. The
+//! channels of an array read the plane of all channels at their delays.
 //!
-//! @returns The signal value at a specified moment
+//! @returns: nothing
 //!************************************************************************
-double AudioSource::getSignalValueTrapDampSin
+void AudioSource::generateBlock
     (
-    const SignalItem::SignalTrapDampSin aSignalData,    //!< TrapDampSin signal data
-    const double                        aTime           //!< time
+    Generator&      aGenerator,     //!< generator
+    const size_t    aFramesCount,   //!< number of frames
+    double*         aValues         //!< interleaved values of the planes
     ) const
 {
-    double y = 0;
+    const size_t PLANES_COUNT = aGenerator.planesCount;
+    const size_t COMPONENT_PLANES = aGenerator.timebase.planesCount;
+    const uint64_t firstFrame = aGenerator.timebase.frame;
+    const double Ts = aGenerator.timebase.samplePeriod;
+    std::vector<double>& block = aGenerator.blockVec;
 
-    if( aTime >= aSignalData.tDelay )
+    block.resize( aFramesCount * COMPONENT_PLANES );
+    getSignalValues( *aGenerator.snapshot, aGenerator.timebase, block.data(), aFramesCount );
+
+    for( NoiseStream& stream : aGenerator.noiseStreams )
     {
-        double dt0 = aTime - aSignalData.tDelay;
-        uint32_t kPer = 1 + dt0 / aSignalData.tPeriod;
+        const size_t plane = ( stream.channel >= 0 ) ? 1 + static_cast<size_t>( stream.channel ) : 0;
 
-        if( aTime >= aSignalData.tCross
-       || ( aTime > aSignalData.tDelay + ( kPer - 1 ) * aSignalData.tPeriod + aSignalData.tRise + aSignalData.tWidth + aSignalData.tFall
-         && aTime < aSignalData.tDelay + kPer * aSignalData.tPeriod )
-          )
+        if( plane >= COMPONENT_PLANES )
         {
-            y = aSignalData.offset;
+            continue;
         }
-        else
-        {
-            double yEnv = 0;
 
-            if( aTime > aSignalData.tDelay + ( kPer - 1 ) * aSignalData.tPeriod
-            &&  aTime <= aSignalData.tDelay + ( kPer - 1 ) * aSignalData.tPeriod + aSignalData.tRise
-              )
-            {
-                yEnv = aSignalData.amplit * ( aSignalData.tCross - aSignalData.tDelay - ( kPer - 1 ) * aSignalData.tPeriod - aSignalData.tRise );
-                yEnv /= aSignalData.tCross;
+        double* values = block.data() + plane * aFramesCount;
 
-                y = ( dt0 - ( kPer - 1 ) * aSignalData.tPeriod ) / aSignalData.tRise;
-                y *= yEnv;
-            }
-            else if( aTime > aSignalData.tDelay + ( kPer - 1 ) * aSignalData.tPeriod + aSignalData.tRise
-                  && aTime <= aSignalData.tDelay + ( kPer - 1 ) * aSignalData.tPeriod + aSignalData.tRise + aSignalData.tWidth
-                   )
-            {
-                yEnv = aSignalData.amplit * ( aSignalData.tCross - aSignalData.tDelay - ( kPer - 1 ) * aSignalData.tPeriod - aSignalData.tRise );
-                yEnv /= aSignalData.tCross;
+        for( size_t i = 0; i < aFramesCount; i++ )
+        {
+            double yNoise = getSignalValueNoise( stream.signal, stream.random, ( firstFrame + i ) * Ts );
 
-                y = yEnv - aSignalData.amplit * ( dt0 - ( kPer - 1 ) * aSignalData.tPeriod - aSignalData.tRise ) / aSignalData.tCross;
-            }
-            else if( aTime > aSignalData.tDelay + ( kPer - 1 ) * aSignalData.tPeriod + aSignalData.tRise + aSignalData.tWidth
-                  && aTime <= aSignalData.tDelay + ( kPer - 1 ) * aSignalData.tPeriod + aSignalData.tRise + aSignalData.tWidth + aSignalData.tFall
-                  )
+            if( 0 != stream.signal.gamma ) // any value in [-2..2] except 0
             {
-                yEnv = aSignalData.amplit * ( aSignalData.tCross - aSignalData.tDelay - ( kPer - 1 ) * aSignalData.tPeriod - aSignalData.tRise - aSignalData.tWidth );
-                yEnv /= aSignalData.tCross;
-
-                y = 1 - ( dt0 - ( kPer - 1 ) * aSignalData.tPeriod - aSignalData.tRise - aSignalData.tWidth ) / aSignalData.tFall;
-                y *= yEnv;
+                yNoise = stream.spectrum.filterSample( yNoise, firstFrame + i, stream.delayLine );
             }
 
-            y *= sin( 2 * M_PI * aSignalData.freqHz * ( dt0 - ( kPer - 1 ) * aSignalData.tPeriod ) );
-            y += aSignalData.offset;
+            values[i] += yNoise;
         }
     }
 
-    return y;
-}
+    const bool isArray = !aGenerator.delayVec.empty();
 
+    if( isArray )
+    {
+        std::vector<double>& delayed = aGenerator.delayedVec;
+        delayed.resize( aFramesCount * PLANES_COUNT );
+        writeHistory( aGenerator, block.data(), firstFrame, aFramesCount );
 
-//!************************************************************************
-//! Get the value of a white Noise signal
-//! An array of such values can be filtered for obtaining violet, blue,
-//! pink, or brown noise.
-//!
-//! @returns The signal value at a specified moment
-//!************************************************************************
-double AudioSource::getSignalValueNoise
-    (
-    const SignalItem::SignalNoise       aSignalData,    //!< Noise signal data
-    const double                        aTime           //!< time
-    ) const
-{
-    double y = 0;
-    static int32_t seedNag = rand();
+        for( size_t j = 0; j < PLANES_COUNT; j++ )
+        {
+            readHistory( aGenerator, aGenerator.delayVec.at( j ), firstFrame, delayed.data() + j * aFramesCount, aFramesCount );
+        }
+    }
 
-    if( aTime >= aSignalData.tDelay )
+    if( 1 == PLANES_COUNT && 1 == COMPONENT_PLANES && aGenerator.smcStreams.empty() && !isArray )
     {
-        switch( aSignalData.noiseType )
+        std::copy( block.begin(), block.end(), aValues );
+    }
+    else
+    {
+        std::vector<double>& row = aGenerator.rowVec;
+        row.resize( PLANES_COUNT );
+
+        // the plane of all channels is interleaved, delayed for each channel
+        // of an array, then the plane of each channel is added
+        for( size_t i = 0; i < aFramesCount; i++ )
         {
-            case SignalItem::NOISE_TYPE_DEK:
+            for( size_t j = 0; j < PLANES_COUNT; j++ )
+            {
+                row[j] = isArray ? aGenerator.delayedVec[j * aFramesCount + i] : block[i];
+            }
+
+            for( size_t j = 1; j < COMPONENT_PLANES && j <= PLANES_COUNT; j++ )
+            {
+                row[j - 1] += block[j * aFramesCount + i];
+            }
+
+            addChannelSignalValues( aGenerator.channelTraces, ( firstFrame + i ) * Ts, row );
+
+            for( SmcStream& stream : aGenerator.smcStreams )
+            {
+                double yStream = getSmcStreamValue( stream, firstFrame + i );
+
+                if( stream.signal.channel < 0 )
                 {
-                    int32_t seedDek = 1;
-                    y = generateRandomDek( &seedDek );  // [0..1]
-                    y = 2 * y - 1;                      // [-1..1]
-                    y *= aSignalData.amplit;            // [-a..a]
-                    y += aSignalData.offset;
+                    for( double& value : row )
+                    {
+                        value += yStream;
+                    }
                 }
-                break;
-
-            case SignalItem::NOISE_TYPE_NAG:
+                else if( static_cast<size_t>( stream.signal.channel ) < row.size() )
                 {
-                    y = generateRandomNag( &seedNag );  // [0..1]
-                    y = 2 * y - 1;                      // [-1..1]
-                    y *= aSignalData.amplit;            // [-a..a]
-                    y += aSignalData.offset;
+                    row.at( stream.signal.channel ) += yStream;
                 }
-                break;
+            }
 
-            default:
-                break;
+            std::copy( row.begin(), row.end(), aValues + i * PLANES_COUNT );
         }
     }
-
-    return y;
 }
 
 
 //!************************************************************************
-//! Get the value of a SMC signal
+//! Produce ring frames from the generator being played
+//! The generator fading out is evaluated alongside during a crossfade.
 //!
-//! @returns The signal value at a specified moment
+//! @returns: nothing
 //!************************************************************************
-double AudioSource::getSignalValueSmc
+void AudioSource::generateFrames
     (
-    const SignalItem::SignalSmc         aSignalData,    //!< SMC signal data
-    const double                        aTime           //!< time
-    ) const
+    float*          aFrames,        //!< destination, interleaved ring frames
+    const size_t    aFramesCount    //!< number of frames
+    )
 {
-    double y = 0;
+    const size_t CHANNELS_COUNT = mRingChannels;
+    const size_t PLANES_COUNT = mGenerator->planesCount;
+    const size_t rampFrames = std::min( aFramesCount, mRampFramesLeft );
+    size_t previousPlanesCount = 1;
 
-    if( aSignalData.sps > 0
-     && aSignalData.nrPoints
-     && aSignalData.accelDataVec.size()
-      )
+    mGeneratorValues.resize( aFramesCount * PLANES_COUNT );
+    generateBlock( *mGenerator, aFramesCount, mGeneratorValues.data() );
+
+    if( rampFrames )
     {
-        double smcSignalDuration = aSignalData.nrPoints / aSignalData.sps;
+        previousPlanesCount = mPreviousGenerator->planesCount;
+        mPreviousValues.resize( rampFrames * previousPlanesCount );
+        generateBlock( *mPreviousGenerator, rampFrames, mPreviousValues.data() );
+    }
+
+    for( size_t i = 0; i < aFramesCount; i++ )
+    {
+        const double* values = mGeneratorValues.data() + i * PLANES_COUNT;
+        const double* previousValues = mPreviousValues.data() + i * previousPlanesCount;
+        const float gain = ( i < rampFrames ) ? 1.0f - static_cast<float>( mRampFramesLeft - i ) / mRampFrames : 1.0f;
 
-        if( aTime <= smcSignalDuration )
+        for( size_t j = 0; j < CHANNELS_COUNT; j++ )
         {
-            double dt = 1.0 / aSignalData.sps;
-            uint32_t kSample = std::floor( aTime / dt );
-            double tInSample = aTime - kSample * dt;
+            float value = static_cast<float>( values[std::min( j, PLANES_COUNT - 1 )] );
 
-            if( kSample < aSignalData.accelDataVec.size() )
+            if( i < rampFrames )
             {
-                double yL = ( kSample > 0 ) ? aSignalData.accelDataVec.at( kSample - 1 ) : 0;
-                double yR = aSignalData.accelDataVec.at( kSample );
-                y = yL + ( tInSample / dt ) * ( yR - yL );
-                y /= aSignalData.MAX_SCALE_ACCEL_MS2;
+                value = gain * value + ( 1.0f - gain ) * static_cast<float>( previousValues[std::min( j, previousPlanesCount - 1 )] );
             }
+
+            aFrames[i * CHANNELS_COUNT + j] = value;
         }
+
+        const float value = aFrames[i * CHANNELS_COUNT];
+        mLastCrossed = ( mLastValue < 0 && value >= 0 ) || ( mLastValue > 0 && value <= 0 );
+        mLastValue = value;
+    }
+
+    mRampFramesLeft -= rampFrames;
+
+    if( mPreviousGenerator && 0 == mRampFramesLeft )
+    {
+        mPreviousGenerator.reset();
+    }
+}
+
+
+//!************************************************************************
+//! Generate a random number
+//! adapted from Knuth, D.E. - The Art of Computer Programming
+//!                            Volume 2, Seminumerical Algorithms
+//!                            3rd Ed, Addison-Wesley, 1997
+//!
+//! @returns: a random double in [0..1]
+//!************************************************************************
+double AudioSource::generateRandomDek
+    (
+    RandomState&    aState          //!< state of the generator
+    ) const
+{
+    const int32_t MBIG = 1000000000;
+    const int32_t MSEED = 161803398;
+    const int32_t MZ = 0;
+    const double FAC = 1.0 / MBIG;
+
+    int32_t* pIdum = &aState.dekSeed;
+    int32_t& inext = aState.dekNext;
+    int32_t& inextp = aState.dekNextP;
+    int32_t* ma = aState.dekTable;
+    int32_t& iff = aState.dekReady;
+    int32_t mj;
+    int32_t mk;
+    int32_t i;
+    int32_t ii;
+    int32_t k;
+
+    if( *pIdum < 0 || iff == 0 )
+    {
+        iff = 1;
+        mj = labs( MSEED - labs( *pIdum ) );
+        mj %= MBIG;
+        ma[55] = mj;
+        mk = 1;
+
+        for( i = 1; i <= 54; i++ )
+        {
+            ii = ( 21 * i ) % 55;
+            ma[ii] = mk;
+            mk = mj - mk;
+
+            if( mk < MZ )
+            {
+                mk += MBIG;
+            }
+
+            mj = ma[ii];
+        }
+
+        for( k = 1; k <= 4; k++ )
+        {
+            for( i = 1; i <= 55; i++ )
+            {
+                ma[i] -= ma[ 1 + ( i + 30 ) % 55 ];
+
+                if( ma[i] < MZ )
+                {
+                    ma[i] += MBIG;
+                }
+            }
+        }
+
+        inext = 0;
+        inextp = 31;
+        *pIdum = 1;
+    }
+
+    if( ++inext == 56 )
+    {
+        inext = 1;
+    }
+
+    if( ++inextp == 56 )
+    {
+        inextp = 1;
+    }
+
+    mj = ma[inext] - ma[inextp];
+
+    if( mj < MZ )
+    {
+        mj += MBIG;
+    }
+
+    ma[inext] = mj;
+
+    return ( double )( mj * FAC );
+}
+
+
+//!************************************************************************
+//! Generate a random number
+//! adapted from Press, W.H. et al - Numerical Recipes in C. The Art of Scientific Computing
+//!                                  2nd Ed, Cambridge Univ. Press, 1992
+//!
+//! see ran4(), subchapter 7.5, pp. 303
+//!
+//! @returns: a random double in [0..1]
+//!************************************************************************
+double AudioSource::generateRandomNag
+    (
+    RandomState&    aState          //!< state of the generator
+    ) const
+{
+    const uint32_t JFLONE = 0x3f800000;
+    const uint32_t JFLMSK = 0x007fffff;
+    int32_t* pIdum = &aState.nagSeed;
+    int32_t& idums = aState.nagKey;
+
+    if( *pIdum < 0 )
+    {
+        idums = -( *pIdum );
+        *pIdum = 1;
+    }
+
+    uint32_t irword = *pIdum;
+    uint32_t lword = idums;
+    pseudoDes( &lword, &irword );
+    uint32_t itemp = JFLONE | ( JFLMSK & irword );
+    ++( *pIdum );
+
+    return ( *reinterpret_cast< float* >( &itemp ) - 1.0 );
+}
+
+
+//!************************************************************************
+//! Get the level under which a decaying component is taken as settled
+//!
+//! @returns: half a step of the device sample format, relative to full scale
+//!************************************************************************
+double AudioSource::getSettledLevel() const
+{
+    double step = 0;
+
+    switch( mAudioFormat.sampleFormat() )
+    {
+        case QAudioFormat::UInt8:
+            step = 2.0 / 255;
+            break;
+
+        case QAudioFormat::Int16:
+            step = 1.0 / 32767;
+            break;
+
+        case QAudioFormat::Int32:
+            step = 1.0 / std::numeric_limits<int32_t>::max();
+            break;
+
+        case QAudioFormat::Float:
+        default:
+            step = 1.0 / ( 1 << 24 );
+            break;
+    }
+
+    return 0.5 * step;
+}
+
+
+//!************************************************************************
+//! Get the sums of the signal values over the next frames of a timebase
+//! The frames are split at the frames where components start or end, or
+//! an envelope starts, and each active component adds its values over a
+//! whole run; the ended ones add their settled values as a constant. The
+//! sums are made for each plane of the timebase, plane after plane, and
+//! the timebase advances by aFramesCount frames.
+//!
+//! @returns: nothing
+//!************************************************************************
+void AudioSource::getSignalValues
+    (
+    const std::vector<SignalItem>&  aSignals,       //!< signals
+    Timebase&                       aTimebase,      //!< sample clock and component states
+    double*                         aValues,        //!< sums of the signal values, aFramesCount for each plane
+    const size_t                    aFramesCount    //!< number of frames
+    ) const
+{
+    const double Ts = aTimebase.samplePeriod;
+    size_t framesDone = 0;
+
+    while( aFramesCount > framesDone )
+    {
+        if( aTimebase.frame >= aTimebase.nextEventFrame )
+        {
+            updateActiveComponents( aTimebase );
+        }
+
+        // the envelopes restart from their exact values on each run
+        for( const size_t k : aTimebase.activeVec )
+        {
+            ComponentState& state = aTimebase.stateVec.at( k );
+            startEnvelopes( aSignals.at( k ), state, aTimebase.frame, Ts );
+            aTimebase.nextEventFrame = std::min( aTimebase.nextEventFrame, state.envelopeFrame );
+        }
+
+        const size_t runFrames = static_cast<size_t>( std::min<uint64_t>( aFramesCount - framesDone, aTimebase.nextEventFrame - aTimebase.frame ) );
+
+        for( size_t p = 0; p < aTimebase.planesCount; p++ )
+        {
+            double* values = aValues + p * aFramesCount + framesDone;
+            std::fill( values, values + runFrames, aTimebase.settledOffsetVec.at( p ) );
+        }
+
+        for( const size_t k : aTimebase.activeVec )
+        {
+            const SignalItem& signal = aSignals.at( k );
+            ComponentState& state = aTimebase.stateVec.at( k );
+            double* values = aValues + state.plane * aFramesCount + framesDone;
+
+            if( state.table )
+            {
+                addWavetableValues( state, values, runFrames );
+            }
+            else if( state.segmentVec.size() )
+            {
+                const double startPos = state.periodPos;
+                addSegmentValues( state, Ts, values, runFrames );
+
+                if( state.cornerVec.size() )
+                {
+                    addCornerCorrections( state, startPos, Ts, values, runFrames );
+                }
+            }
+            else
+            {
+                for( size_t i = 0; i < runFrames; i++ )
+                {
+                    values[i] += getComponentValue( signal, state, ( aTimebase.frame + i ) * Ts );
+                    advanceComponentState( state, Ts );
+                }
+
+                if( state.cornerVec.size() )
+                {
+                    addCornerCorrections( state, aTimebase.frame * Ts, Ts, values, runFrames );
+                }
+
+                if( state.trapCorrected )
+                {
+                    addTrapDampSinCorrections( signal.getSignalDataTrapDampSin(), aTimebase.frame * Ts, Ts, values, runFrames );
+                }
+            }
+        }
+
+        aTimebase.frame += runFrames;
+        framesDone += runFrames;
+    }
+}
+
+
+//!************************************************************************
+//! Get the value of an exponential RiseFall signal
+//! The rise and fall exponentials are the envelopes of the state.
+//!
+//! @returns The signal value at a specified moment
+//!************************************************************************
+double AudioSource::getSignalValueRiseFall
+    (
+    const SignalItem::SignalRiseFall&   aSignalData,    //!< RiseFall signal data
+    const ComponentState&               aState,         //!< component state
+    const double                        aTime           //!< time
+    ) const
+{
+    double y = 0;
+
+    if( aTime <= aSignalData.tDelayRise )
+    {
+        y = aSignalData.yMin;
+    }
+    else if( aTime > aSignalData.tDelayRise
+          && aTime <= aSignalData.tDelayFall
+           )
+    {
+        y = aSignalData.yMin
+            + ( aSignalData.yMax - aSignalData.yMin ) * ( 1. - aState.envelope );
+
+    }
+    else if( aTime > aSignalData.tDelayFall )
+    {
+        y = aSignalData.yMin
+            + ( aSignalData.yMax - aSignalData.yMin ) * ( 1. - aState.envelope )
+            + ( aSignalData.yMin - aSignalData.yMax ) * ( 1. - aState.auxEnvelope );
+    }
+
+    return y;
+}
+
+
+//!************************************************************************
+//! Get the value of a SinDamp signal
+//!
+//! @returns The signal value at the current frame
+//!************************************************************************
+double AudioSource::getSignalValueSinDamp
+    (
+    const SignalItem::SignalSinDamp&    aSignalData,    //!< SinDamp signal data
+    const ComponentState&               aState          //!< component state
+    ) const
+{
+    return aSignalData.offset
+           + aSignalData.amplit * sin( 2 * M_PI * aState.phase + aSignalData.phiRad ) * aState.envelope;
+}
+
+
+//!************************************************************************
+//! Get the value of a SinRise signal
+//!
+//! @returns The signal value at the current frame
+//!************************************************************************
+double AudioSource::getSignalValueSinRise
+    (
+    const SignalItem::SignalSinRise&    aSignalData,    //!< SinRise signal data
+    const ComponentState&               aState,         //!< component state
+    const double                        aTime           //!< time
+    ) const
+{
+    double y = 0;
+
+    if( aTime < aSignalData.tEnd )
+    {
+        y = aSignalData.offset
+            + aSignalData.amplit * sin( 2 * M_PI * aState.phase + aSignalData.phiRad ) * aState.envelope;
+    }
+    else
+    {
+        y = aSignalData.offset;
+    }
+
+    return y;
+}
+
+
+//!************************************************************************
+//! Get the value of a WavSin signal
+//!
+//! @returns The signal value at the current frame
+//!************************************************************************
+double AudioSource::getSignalValueWavSin
+    (
+    const SignalItem::SignalWavSin&     aSignalData,    //!< WavSin signal data
+    const ComponentState&               aState,         //!< component state
+    const double                        aTime           //!< time
+    ) const
+{
+    double y = 0;
+    double T = 0.5 * getWavSinIndex( aSignalData ) / aSignalData.freqHz;
+
+    if( aTime < T + aSignalData.tDelay )
+    {
+        y = aSignalData.offset
+            + aSignalData.amplit * sin( 2 * M_PI * aState.auxPhase ) * sin( 2 * M_PI * aState.phase );
     }
 
     return y;
@@ -843,150 +1330,1808 @@ double AudioSource::getSignalValueSmc
 
 
 //!************************************************************************
-//! Check if the audio source is started
+//! Get the value of a AmSin signal
+//!
+//! @returns The signal value at the current frame
+//!************************************************************************
+double AudioSource::getSignalValueAmSin
+    (
+    const SignalItem::SignalAmSin&      aSignalData,    //!< AmSin signal data
+    const ComponentState&               aState          //!< component state
+    ) const
+{
+    return aSignalData.carrierOffset
+           + aSignalData.carrierAmplitude * sin( 2 * M_PI * aState.phase )
+           * ( 1 + aSignalData.modulationIndex * cos( 2 * M_PI * aState.auxPhase + aSignalData.modulationPhiRad ) );
+}
+
+
+//!************************************************************************
+//! Get the value of a SinDampSin signal
+//!
+//! @returns The signal value at the current frame
+//!************************************************************************
+double AudioSource::getSignalValueSinDampSin
+    (
+    const SignalItem::SignalSinDampSin& aSignalData,    //!< SinDampSin signal data
+    const ComponentState&               aState          //!< component state
+    ) const
+{
+    // the exponential damping is the envelope of the state
+    double eyeAmplit = aSignalData.amplit * aState.envelope;
+    const double kPer = 1.0 + aState.periodIndex;
+
+    switch( aSignalData.dampingType )
+    {
+        case -2:
+            eyeAmplit *= kPer * kPer;
+            break;
+
+        case -1:
+            eyeAmplit *= kPer;
+            break;
+
+        case 1:
+            eyeAmplit /= kPer;
+            break;
+
+        case 2:
+            eyeAmplit /= kPer * kPer;
+            break;
+
+        default:
+            break;
+    }
+
+    // the envelope half-wave changes its sign with every period
+    double yEnv = sin( M_PI / aSignalData.tPeriodEnv * aState.periodPos );
+
+    if( aState.periodIndex % 2 )
+    {
+        yEnv = -yEnv;
+    }
+
+    return aSignalData.offset
+           + eyeAmplit * yEnv * sin( 2 * M_PI * aState.phase );
+}
+
+
+//!************************************************************************
+//! Get the value of a TrapDampSin signal
+//!
+//! @returns The signal value at the current frame
+//!************************************************************************
+double AudioSource::getSignalValueTrapDampSin
+    (
+    const SignalItem::SignalTrapDampSin&    aSignalData,    //!< TrapDampSin signal data
+    const ComponentState&                   aState,         //!< component state
+    const double                            aTime           //!< time
+    ) const
+{
+    double y = 0;
+    const double tInPer = aState.periodPos;
+    const double tPerStart = aSignalData.tDelay + aState.periodIndex * aSignalData.tPeriod;
+
+    if( aTime >= aSignalData.tCross
+     || tInPer > aSignalData.tRise + aSignalData.tWidth + aSignalData.tFall
+      )
+    {
+        y = aSignalData.offset;
+    }
+    else
+    {
+        double yEnv = 0;
+
+        if( tInPer <= aSignalData.tRise )
+        {
+            yEnv = aSignalData.amplit * ( aSignalData.tCross - tPerStart - aSignalData.tRise );
+            yEnv /= aSignalData.tCross;
+
+            y = tInPer / aSignalData.tRise;
+            y *= yEnv;
+        }
+        else if( tInPer <= aSignalData.tRise + aSignalData.tWidth )
+        {
+            yEnv = aSignalData.amplit * ( aSignalData.tCross - tPerStart - aSignalData.tRise );
+            yEnv /= aSignalData.tCross;
+
+            y = yEnv - aSignalData.amplit * ( tInPer - aSignalData.tRise ) / aSignalData.tCross;
+        }
+        else
+        {
+            yEnv = aSignalData.amplit * ( aSignalData.tCross - tPerStart - aSignalData.tRise - aSignalData.tWidth );
+            yEnv /= aSignalData.tCross;
+
+            y = 1 - ( tInPer - aSignalData.tRise - aSignalData.tWidth ) / aSignalData.tFall;
+            y *= yEnv;
+        }
+
+        y *= sin( 2 * M_PI * aSignalData.freqHz * tInPer );
+        y += aSignalData.offset;
+    }
+
+    return y;
+}
+
+
+//!************************************************************************
+//! Get the value of a white Noise signal
+//! An array of such values can be filtered for obtaining violet, blue,
+//! pink, or brown noise.
+//!
+//! @returns The signal value at a specified moment
+//!************************************************************************
+double AudioSource::getSignalValueNoise
+    (
+    const SignalItem::SignalNoise&      aSignalData,    //!< Noise signal data
+    RandomState&                        aRandom,        //!< random generators of the noise
+    const double                        aTime           //!< time
+    ) const
+{
+    double y = 0;
+
+    if( aTime >= aSignalData.tDelay )
+    {
+        switch( aSignalData.noiseType )
+        {
+            case SignalItem::NOISE_TYPE_DEK:
+                {
+                    y = generateRandomDek( aRandom );   // [0..1]
+                    y = 2 * y - 1;                      // [-1..1]
+                    y *= aSignalData.amplit;            // [-a..a]
+                    y += aSignalData.offset;
+                }
+                break;
+
+            case SignalItem::NOISE_TYPE_NAG:
+                {
+                    y = generateRandomNag( aRandom );   // [0..1]
+                    y = 2 * y - 1;                      // [-1..1]
+                    y *= aSignalData.amplit;            // [-a..a]
+                    y += aSignalData.offset;
+                }
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    return y;
+}
+
+
+//!************************************************************************
+//! Get the value of a SMC signal
+//!
+//! @returns The signal value at a specified moment
+//!************************************************************************
+double AudioSource::getSignalValueSmc
+    (
+    const SignalItem::SignalSmc&        aSignalData,    //!< SMC signal data
+    const double                        aTime           //!< time
+    ) const
+{
+    double y = 0;
+    double tSmc = aTime - aSignalData.tStart;
+
+    if( aSignalData.sps > 0
+     && aSignalData.nrPoints
+     && aSignalData.dataVec.size()
+     && aSignalData.fullScale > 0
+     && tSmc >= 0
+      )
+    {
+        double smcSignalDuration = aSignalData.nrPoints / aSignalData.sps;
+
+        if( tSmc <= smcSignalDuration )
+        {
+            double dt = 1.0 / aSignalData.sps;
+            uint32_t kSample = std::floor( tSmc / dt );
+            double tInSample = tSmc - kSample * dt;
+
+            if( kSample < aSignalData.dataVec.size() )
+            {
+                double yL = ( kSample > 0 ) ? aSignalData.dataVec.at( kSample - 1 ) : 0;
+                double yR = aSignalData.dataVec.at( kSample );
+                y = yL + ( tInSample / dt ) * ( yR - yL );
+                y /= aSignalData.fullScale;
+            }
+        }
+    }
+
+    return y;
+}
+
+
+//!************************************************************************
+//! Get the next value of an audified SMC trace
+//!
+//! The trace plays sps * speedUp samples per second. It is resampled to
+//! the output rate in chunks, only when the previous chunk was played.
+//!
+//! @returns: the value at the output frame
+//!************************************************************************
+double AudioSource::getSmcStreamValue
+    (
+    SmcStream&                          aStream,        //!< audified SMC trace
+    const uint64_t                      aFrame          //!< output frame
+    ) const
+{
+    double y = 0;
+
+    if( aFrame >= aStream.startFrame && aStream.signal.fullScale > 0 )
+    {
+        const std::vector<double>& dataVec = aStream.signal.dataVec;
+
+        while( aStream.outputPos >= aStream.outputVec.size() && !aStream.flushed )
+        {
+            aStream.outputVec.clear();
+            aStream.outputPos = 0;
+
+            if( aStream.inputPos < dataVec.size() )
+            {
+                size_t count = std::min<size_t>( SMC_STREAM_CHUNK, dataVec.size() - aStream.inputPos );
+                aStream.resampler.process( dataVec.data() + aStream.inputPos, count, aStream.outputVec );
+                aStream.inputPos += count;
+            }
+            else
+            {
+                aStream.resampler.flush( aStream.outputVec );
+                aStream.flushed = true;
+            }
+        }
+
+        if( aStream.outputPos < aStream.outputVec.size() )
+        {
+            y = aStream.outputVec.at( aStream.outputPos++ ) / aStream.signal.fullScale;
+        }
+    }
+
+    return y;
+}
+
+
+//!************************************************************************
+//! Get the number of carrier half-waves of a WavSin signal
+//!
+//! @returns: an odd index, at least 3
+//!************************************************************************
+uint8_t AudioSource::getWavSinIndex
+    (
+    const SignalItem::SignalWavSin&     aSignalData     //!< WavSin signal data
+    )
+{
+    uint8_t N = aSignalData.index;
+
+    if( N < 3
+     || N % 2 != 1
+      )
+    {
+        N = 3;
+    }
+
+    return N;
+}
+
+
+//!************************************************************************
+//! Get the value of a component at the current frame of its state
+//!
+//! @returns The component value
+//!************************************************************************
+double AudioSource::getComponentValue
+    (
+    const SignalItem&                   aSignal,        //!< signal
+    const ComponentState&               aState,         //!< component state
+    const double                        aTime           //!< time
+    ) const
+{
+    double y = 0;
+
+    switch( aSignal.getType() )
+    {
+        case SignalItem::SIGNAL_TYPE_RISEFALL:
+            y = getSignalValueRiseFall( aSignal.getSignalDataRiseFall(), aState, aTime );
+            break;
+
+        case SignalItem::SIGNAL_TYPE_SINDAMP:
+            y = getSignalValueSinDamp( aSignal.getSignalDataSinDamp(), aState );
+            break;
+
+        case SignalItem::SIGNAL_TYPE_SINRISE:
+            y = getSignalValueSinRise( aSignal.getSignalDataSinRise(), aState, aTime );
+            break;
+
+        case SignalItem::SIGNAL_TYPE_WAVSIN:
+            y = getSignalValueWavSin( aSignal.getSignalDataWavSin(), aState, aTime );
+            break;
+
+        case SignalItem::SIGNAL_TYPE_AMSIN:
+            y = getSignalValueAmSin( aSignal.getSignalDataAmSin(), aState );
+            break;
+
+        case SignalItem::SIGNAL_TYPE_SINDAMPSIN:
+            y = getSignalValueSinDampSin( aSignal.getSignalDataSinDampSin(), aState );
+            break;
+
+        case SignalItem::SIGNAL_TYPE_TRAPDAMPSIN:
+            y = getSignalValueTrapDampSin( aSignal.getSignalDataTrapDampSin(), aState, aTime );
+            break;
+
+        case SignalItem::SIGNAL_TYPE_SMC:
+            {
+                const SignalItem::SignalSmc& sig = aSignal.getSignalDataSmc();
+
+                // channel-specific traces are added by addChannelSignalValues(),
+                // audified traces are streamed by getSmcStreamValue()
+                if( sig.channel < 0 && sig.speedUp <= 1 )
+                {
+                    y = getSignalValueSmc( sig, aTime );
+                }
+            }
+            break;
+
+        case SignalItem::SIGNAL_TYPE_TRIANGLE: // piecewise-linear signals are added by addSegmentValues()
+        case SignalItem::SIGNAL_TYPE_RECTANGLE:
+        case SignalItem::SIGNAL_TYPE_PULSE:
+        case SignalItem::SIGNAL_TYPE_NOISE: // noise is added by generateBlock()
+        default:
+            break;
+    }
+
+    return y;
+}
+
+
+//!************************************************************************
+//! Get the first frame from which a component keeps its settled value
+//! A time within rounding of a frame counts as before it, so that the
+//! frame is still evaluated.
+//!
+//! @returns: the frame, NEVER_FRAME if the time is not finite
+//!************************************************************************
+uint64_t AudioSource::getEndFrame
+    (
+    const double        aEndTime,       //!< time from which a component is settled [s]
+    const double        aSamplePeriod   //!< time between frames [s]
+    )
+{
+    const double frames = std::ceil( aEndTime / aSamplePeriod + FRAME_ROUNDING );
+    uint64_t endFrame = NEVER_FRAME;
+
+    if( frames <= 0 )
+    {
+        endFrame = 0;
+    }
+    else if( frames < static_cast<double>( NEVER_FRAME ) )
+    {
+        endFrame = static_cast<uint64_t>( frames );
+    }
+
+    return endFrame;
+}
+
+
+//!************************************************************************
+//! Get the output frames rendered since the start
+//! This is the time base of SWITCH_AT_FRAME.
+//!
+//! @returns: the rendered frames
+//!************************************************************************
+uint64_t AudioSource::getFramesRendered() const
+{
+    return mFramesRendered;
+}
+
+
+//!************************************************************************
+//! Get the seconds of audio rendered ahead of the device
+//!
+//! @returns: the ring fill [s]
+//!************************************************************************
+double AudioSource::getRingFillSeconds() const
+{
+    const double bytesPerSecond = static_cast<double>( mRingChannels * sizeof( float ) ) * mAudioFormat.sampleRate();
+    return ( bytesPerSecond > 0 ) ? mRing.getFilledBytes() / bytesPerSecond : 0;
+}
+
+
+//!************************************************************************
+//! Get how many times the device read more than was rendered
+//!
+//! @returns: the underruns count
+//!************************************************************************
+uint32_t AudioSource::getUnderrunsCount() const
+{
+    return mUnderrunsCount;
+}
+
+
+//!************************************************************************
+//! Find the corners of a piecewise-linear component
+//! Each piece which is not empty starts with a corner, whose value and
+//! slope changes come from the previous such piece, cyclically.
+//!
+//! @returns: nothing
+//!************************************************************************
+void AudioSource::initCorners
+    (
+    ComponentState&     aState          //!< component state
+    )
+{
+    const double period = aState.period;
+    std::vector<Segment> pieces;
+
+    for( const Segment& segment : aState.segmentVec )
+    {
+        if( segment.tStart < period && std::min( segment.tEnd, period ) > segment.tStart )
+        {
+            pieces.push_back( segment );
+            pieces.back().tEnd = std::min( segment.tEnd, period );
+        }
+    }
+
+    for( size_t k = 0; k < pieces.size(); k++ )
+    {
+        const Segment& left = pieces.at( ( k + pieces.size() - 1 ) % pieces.size() );
+        const Segment& right = pieces.at( k );
+
+        Corner corner;
+        corner.t = right.tStart;
+        corner.step = right.yStart - ( left.yStart + left.slope * ( left.tEnd - left.tStart ) );
+        corner.slopeStep = right.slope - left.slope;
+
+        if( corner.step || corner.slopeStep )
+        {
+            aState.cornerVec.push_back( corner );
+        }
+    }
+}
+
+
+//!************************************************************************
+//! Prepare a generator for a signal list, at frame 0
+//! The signals are copied, so that the list may be edited while the
+//! generator is played.
+//!
+//! @returns: nothing
+//!************************************************************************
+void AudioSource::initGenerator
+    (
+    Generator&                      aGenerator, //!< generator
+    const SignalList::Snapshot&     aSignals    //!< signals
+    ) const
+{
+    aGenerator.snapshot = aSignals ? aSignals : std::make_shared<const std::vector<SignalItem>>();
+    aGenerator.channelTraces.clear();
+    aGenerator.smcStreams.clear();
+    aGenerator.noiseStreams.clear();
+
+    initTimebase( aGenerator.timebase, *aGenerator.snapshot, 0 );
+
+    bool isMono = true;
+
+    for( const SignalItem& signal : *aGenerator.snapshot )
+    {
+        if( SignalItem::SIGNAL_TYPE_NOISE == signal.getType() )
+        {
+            aGenerator.noiseStreams.emplace_back( signal.getSignalDataNoise(), signal.getChannel() );
+        }
+        else if( SignalItem::SIGNAL_TYPE_SMC == signal.getType() )
+        {
+            const SignalItem::SignalSmc& sig = signal.getSignalDataSmc();
+
+            if( sig.speedUp > 1 )
+            {
+                aGenerator.smcStreams.emplace_back( sig, mAudioFormat.sampleRate() );
+            }
+            else if( sig.channel >= 0 )
+            {
+                aGenerator.channelTraces.push_back( &sig );
+            }
+        }
+
+        if( signal.getChannel() >= 0 )
+        {
+            isMono = false;
+        }
+    }
+
+    aGenerator.planesCount = ( isMono && mChannelDelayVec.empty() ) ? 1 : std::max( mAudioFormat.channelCount(), 1 );
+
+    // a channel array renders the plane of all channels once, into a history
+    // which each channel reads at its own delay
+    aGenerator.delayVec.clear();
+    aGenerator.historyVec.clear();
+
+    if( mChannelDelayVec.size() )
+    {
+        bool isFractional = false;
+        double delayMax = 0;
+
+        aGenerator.delayVec.assign( aGenerator.planesCount, 0 );
+
+        for( size_t j = 0; j < aGenerator.planesCount && j < mChannelDelayVec.size(); j++ )
+        {
+            double delay = std::max( mChannelDelayVec.at( j ), 0.0 ) * mAudioFormat.sampleRate();
+
+            if( std::abs( delay - std::round( delay ) ) < FRAME_ROUNDING )
+            {
+                delay = std::round( delay );
+            }
+
+            isFractional = isFractional || ( delay != std::floor( delay ) );
+            aGenerator.delayVec.at( j ) = delay;
+        }
+
+        // a fractional delay also reads the frame after its position, so
+        // that all channels are delayed by one more frame
+        for( double& delay : aGenerator.delayVec )
+        {
+            delay += isFractional ? 1 : 0;
+            delayMax = std::max( delayMax, delay );
+        }
+
+        size_t historyFrames = 1;
+
+        while( historyFrames < static_cast<size_t>( delayMax ) + DELAY_TAPS + RENDER_CHUNK_FRAMES )
+        {
+            historyFrames <<= 1;
+        }
+
+        aGenerator.historyVec.assign( historyFrames, 0 );
+    }
+}
+
+
+//!************************************************************************
+//! Play a piecewise-linear component from a band-limited wavetable
+//! Periods long enough for the top wavetable level to fall short of the
+//! Nyquist frequency keep the pieces, whose aliases are then negligible.
+//!
+//! @returns: true if the component plays a wavetable
+//!************************************************************************
+bool AudioSource::initWavetable
+    (
+    ComponentState&     aState,         //!< component state
+    const double        aSamplePeriod   //!< time between frames [s]
+    )
+{
+    const double period = aState.period;
+    const double harmonicsCount = 0.5 * period / aSamplePeriod;
+
+    if( period <= 0 || harmonicsCount > WavetableBank::HARMONICS_MAX )
+    {
+        return false;
+    }
+
+    std::vector<WavetableBank::Piece> pieces;
+    double yLow = std::numeric_limits<double>::max();
+    double yHigh = std::numeric_limits<double>::lowest();
+
+    for( const Segment& segment : aState.segmentVec )
+    {
+        if( segment.tStart < period )
+        {
+            const double tEnd = std::min( segment.tEnd, period );
+
+            WavetableBank::Piece piece;
+            piece.tStart = segment.tStart / period;
+            piece.tEnd = tEnd / period;
+            piece.yStart = segment.yStart;
+            piece.yEnd = segment.yStart + segment.slope * ( tEnd - segment.tStart );
+            pieces.push_back( piece );
+
+            yLow = std::min( { yLow, piece.yStart, piece.yEnd } );
+            yHigh = std::max( { yHigh, piece.yStart, piece.yEnd } );
+        }
+    }
+
+    // a constant is exact without a wavetable
+    if( pieces.empty() || yHigh <= yLow )
+    {
+        return false;
+    }
+
+    for( WavetableBank::Piece& piece : pieces )
+    {
+        piece.yStart = ( piece.yStart - yLow ) / ( yHigh - yLow );
+        piece.yEnd = ( piece.yEnd - yLow ) / ( yHigh - yLow );
+    }
+
+    aState.wavetable = WavetableBank::getWavetable( pieces );
+    aState.table = aState.wavetable->levelVec.at( WavetableBank::getLevel( harmonicsCount ) ).data();
+    aState.tableScale = yHigh - yLow;
+    aState.tableOffset = yLow;
+    aState.phase = aState.periodPos / period;
+    aState.phaseStep = aSamplePeriod / period;
+
+    return true;
+}
+
+
+//!************************************************************************
+//! Start a timebase at a frame
+//! Each component gets the frame where its delay ends, or the start frame
+//! if later, and its phases at that frame; from there on they only advance
+//! frame by frame. Components which end, or decay below the settled level,
+//! get the frame from which their constant value is used instead.
+//!
+//! @returns: nothing
+//!************************************************************************
+void AudioSource::initTimebase
+    (
+    Timebase&                       aTimebase,  //!< sample clock and component states
+    const std::vector<SignalItem>&  aSignals,   //!< signals
+    const uint64_t                  aFrame      //!< first frame to evaluate
+    ) const
+{
+    const double Ts = 1.0 / mAudioFormat.sampleRate();
+    const double settledLevel = getSettledLevel();
+    const size_t channelsCount = static_cast<size_t>( std::max( mAudioFormat.channelCount(), 1 ) );
+    bool isRouted = false;
+
+    aTimebase.frame = aFrame;
+    aTimebase.samplePeriod = Ts;
+    aTimebase.stateVec.assign( aSignals.size(), ComponentState() );
+
+    for( size_t i = 0; i < aSignals.size(); i++ )
+    {
+        ComponentState& state = aTimebase.stateVec.at( i );
+        double endTime = std::numeric_limits<double>::infinity();
+
+        switch( aSignals.at( i ).getType() )
+        {
+            case SignalItem::SIGNAL_TYPE_TRIANGLE:
+                {
+                    const SignalItem::SignalTriangle& sig = aSignals.at( i ).getSignalDataTriangle();
+                    const double yRange = sig.yMax - sig.yMin;
+                    startComponentState( state, aFrame, sig.tDelay, 0, 0, sig.tPeriod, Ts );
+
+                    addSegment( state, sig.tRise, sig.yMin, ( sig.tRise > 0 ) ? yRange / sig.tRise : 0 );
+                    addSegment( state, std::numeric_limits<double>::infinity(), sig.yMax, ( sig.tFall > 0 ) ? -yRange / sig.tFall : 0 );
+                }
+                break;
+
+            case SignalItem::SIGNAL_TYPE_RECTANGLE:
+                {
+                    const SignalItem::SignalRectangle& sig = aSignals.at( i ).getSignalDataRectangle();
+                    startComponentState( state, aFrame, sig.tDelay, 0, 0, sig.tPeriod, Ts );
+
+                    addSegment( state, sig.tPeriod * sig.fillFactor, sig.yMax, 0 );
+                    addSegment( state, std::numeric_limits<double>::infinity(), sig.yMin, 0 );
+                }
+                break;
+
+            case SignalItem::SIGNAL_TYPE_PULSE:
+                {
+                    const SignalItem::SignalPulse& sig = aSignals.at( i ).getSignalDataPulse();
+                    const double yRange = sig.yMax - sig.yMin;
+                    startComponentState( state, aFrame, sig.tDelay, 0, 0, sig.tPeriod, Ts );
+
+                    addSegment( state, sig.tRise, sig.yMin, ( sig.tRise > 0 ) ? yRange / sig.tRise : 0 );
+                    addSegment( state, sig.tRise + sig.tWidth, sig.yMax, 0 );
+                    addSegment( state, sig.tRise + sig.tWidth + sig.tFall, sig.yMax, ( sig.tFall > 0 ) ? -yRange / sig.tFall : 0 );
+                    addSegment( state, std::numeric_limits<double>::infinity(), sig.yMin, 0 );
+                }
+                break;
+
+            case SignalItem::SIGNAL_TYPE_RISEFALL:
+                {
+                    const SignalItem::SignalRiseFall& sig = aSignals.at( i ).getSignalDataRiseFall();
+                    startComponentState( state, aFrame, sig.tDelay, 0, 0, 0, Ts );
+
+                    // both exponentials below the level, after the fall started
+                    if( sig.tRampRise > 0 && sig.tRampFall > 0 )
+                    {
+                        const double decayRatio = std::log( std::max( std::fabs( sig.yMax - sig.yMin ) / settledLevel, 1.0 ) );
+                        endTime = std::max( sig.tDelayFall, sig.tDelayRise + sig.tRampRise * decayRatio );
+                        endTime = std::max( endTime, sig.tDelayFall + sig.tRampFall * decayRatio );
+                        state.settledValue = sig.yMin;
+                    }
+
+                    // the ramps start with a kink
+                    if( mBandLimited )
+                    {
+                        Corner corner;
+                        corner.step = 0;
+
+                        if( sig.tRampRise > 0 && sig.tDelayRise >= sig.tDelay )
+                        {
+                            corner.t = sig.tDelayRise;
+                            corner.slopeStep = ( sig.yMax - sig.yMin ) / sig.tRampRise;
+                            state.cornerVec.push_back( corner );
+                        }
+
+                        if( sig.tRampFall > 0 && sig.tDelayFall >= sig.tDelay )
+                        {
+                            corner.t = sig.tDelayFall;
+                            corner.slopeStep = ( sig.yMin - sig.yMax ) / sig.tRampFall;
+                            state.cornerVec.push_back( corner );
+                        }
+                    }
+                }
+                break;
+
+            case SignalItem::SIGNAL_TYPE_SINDAMP:
+                {
+                    const SignalItem::SignalSinDamp& sig = aSignals.at( i ).getSignalDataSinDamp();
+                    startComponentState( state, aFrame, sig.tDelay, sig.freqHz, 0, 0, Ts );
+
+                    if( sig.damping > 0 )
+                    {
+                        endTime = sig.tDelay + std::log( std::max( std::fabs( sig.amplit ) / settledLevel, 1.0 ) ) / sig.damping;
+                        state.settledValue = sig.offset;
+                    }
+                }
+                break;
+
+            case SignalItem::SIGNAL_TYPE_SINRISE:
+                {
+                    const SignalItem::SignalSinRise& sig = aSignals.at( i ).getSignalDataSinRise();
+                    startComponentState( state, aFrame, sig.tDelay, sig.freqHz, 0, 0, Ts );
+
+                    // the phase is referred to the end of the rise
+                    const double cycles = sig.freqHz * ( state.startFrame * Ts - sig.tEnd );
+                    state.phase = cycles - std::floor( cycles );
+
+                    endTime = sig.tEnd;
+                    state.settledValue = sig.offset;
+                }
+                break;
+
+            case SignalItem::SIGNAL_TYPE_WAVSIN:
+                {
+                    const SignalItem::SignalWavSin& sig = aSignals.at( i ).getSignalDataWavSin();
+                    startComponentState( state, aFrame, sig.tDelay, sig.freqHz, sig.freqHz / getWavSinIndex( sig ), 0, Ts );
+
+                    endTime = sig.tDelay + 0.5 * getWavSinIndex( sig ) / sig.freqHz;
+                }
+                break;
+
+            case SignalItem::SIGNAL_TYPE_AMSIN:
+                {
+                    const SignalItem::SignalAmSin& sig = aSignals.at( i ).getSignalDataAmSin();
+                    startComponentState( state, aFrame, sig.carrierTDelay, sig.carrierFreqHz, sig.modulationFreqHz, 0, Ts );
+                }
+                break;
+
+            case SignalItem::SIGNAL_TYPE_SINDAMPSIN:
+                {
+                    const SignalItem::SignalSinDampSin& sig = aSignals.at( i ).getSignalDataSinDampSin();
+                    startComponentState( state, aFrame, sig.tDelay, sig.freqSinHz, 0, sig.tPeriodEnv, Ts );
+
+                    // the first period whose amplitude is below the level
+                    const double amplitRatio = std::max( std::fabs( sig.amplit ) / settledLevel, 1.0 );
+                    double settledPeriods = std::numeric_limits<double>::infinity();
+
+                    switch( sig.dampingType )
+                    {
+                        case 1:
+                            settledPeriods = std::floor( amplitRatio );
+                            break;
+
+                        case 2:
+                            settledPeriods = std::floor( std::sqrt( amplitRatio ) );
+                            break;
+
+                        case 3:
+                            settledPeriods = std::floor( std::log( amplitRatio ) ) + 1;
+                            break;
+
+                        default:
+                            // unknown damping types have no amplitude
+                            if( sig.dampingType < -3 || sig.dampingType > 3 )
+                            {
+                                settledPeriods = 0;
+                            }
+                            break;
+                    }
+
+                    if( sig.tPeriodEnv > 0 )
+                    {
+                        endTime = ( settledPeriods > 0 ) ? sig.tDelay + settledPeriods * sig.tPeriodEnv : 0;
+                        state.settledValue = sig.offset;
+                    }
+                }
+                break;
+
+            case SignalItem::SIGNAL_TYPE_TRAPDAMPSIN:
+                {
+                    const SignalItem::SignalTrapDampSin& sig = aSignals.at( i ).getSignalDataTrapDampSin();
+                    startComponentState( state, aFrame, sig.tDelay, 0, 0, sig.tPeriod, Ts );
+
+                    endTime = sig.tCross;
+                    state.settledValue = sig.offset;
+                    state.trapCorrected = mBandLimited;
+                }
+                break;
+
+            case SignalItem::SIGNAL_TYPE_SMC:
+                {
+                    const SignalItem::SignalSmc& sig = aSignals.at( i ).getSignalDataSmc();
+                    endTime = 0;
+
+                    // only the traces mixed into all channels are evaluated here
+                    if( sig.channel < 0 && sig.speedUp <= 1 && sig.sps > 0 )
+                    {
+                        startComponentState( state, aFrame, sig.tStart, 0, 0, 0, Ts );
+                        endTime = sig.tStart + sig.nrPoints / sig.sps;
+                    }
+                }
+                break;
+
+            case SignalItem::SIGNAL_TYPE_NOISE: // noise is added by generateBlock()
+            default:
+                endTime = 0;
+                break;
+        }
+
+        state.endFrame = getEndFrame( endTime, Ts );
+
+        // traces are routed to their channels by generateBlock()
+        if( aSignals.at( i ).getChannel() >= 0
+         && SignalItem::SIGNAL_TYPE_SMC != aSignals.at( i ).getType()
+          )
+        {
+            state.plane = 1 + static_cast<size_t>( aSignals.at( i ).getChannel() );
+            isRouted = true;
+        }
+
+        // pulses have too many shapes to cache, so their corners are smoothed,
+        // as are those of cycles too long for a wavetable
+        if( mBandLimited && state.segmentVec.size() )
+        {
+            if( SignalItem::SIGNAL_TYPE_PULSE == aSignals.at( i ).getType()
+             || !initWavetable( state, Ts )
+              )
+            {
+                initCorners( state );
+            }
+        }
+    }
+
+    aTimebase.activeVec.clear();
+    aTimebase.waitingVec.clear();
+    aTimebase.planesCount = isRouted ? 1 + channelsCount : 1;
+    aTimebase.settledOffsetVec.assign( aTimebase.planesCount, 0 );
+
+    // the components of channels missing from the output are not heard
+    for( size_t i = 0; i < aSignals.size(); i++ )
+    {
+        if( aTimebase.stateVec.at( i ).plane < aTimebase.planesCount )
+        {
+            aTimebase.waitingVec.push_back( i );
+        }
+    }
+
+    std::stable_sort( aTimebase.waitingVec.begin(), aTimebase.waitingVec.end(),
+                      [&aTimebase]( const size_t aLeft, const size_t aRight )
+                      {
+                          return aTimebase.stateVec.at( aLeft ).startFrame > aTimebase.stateVec.at( aRight ).startFrame;
+                      } );
+
+    updateActiveComponents( aTimebase );
+}
+
+
+//!************************************************************************
+//! Check if the audio source is started
+//!
+//! @returns: If the device is open
+//!************************************************************************
+bool AudioSource::isStarted() const
+{
+    return isOpen();
+}
+
+
+//!************************************************************************
+//! Check if a cued waveform still waits for its boundary
+//!
+//! @returns: true until the switch has happened
+//!************************************************************************
+bool AudioSource::isSwitchPending() const
+{
+    return mSwitchPending;
+}
+
+
+//!************************************************************************
+//! Pseudo DES (Data Encryption Standard)
+//! adapted from Press, W.H. et al - Numerical Recipes in C. The Art of Scientific Computing
+//!                                  2nd Ed, Cambridge Univ. Press, 1992
+//! see psdes(), subchapter 7.5, page 302
+//!
+//! This function is used by generateRandomNag()
+//!
+//! @returns: nothing
+//!************************************************************************
+void AudioSource::pseudoDes
+    (
+    uint32_t*   lword,      //!< left word
+    uint32_t*   irword      //!< right word
+    ) const
+{
+    const uint8_t NITER = 4;
+    const uint32_t C1[NITER] = { 0xbaa96887, 0x1e17d32c, 0x03bcdc3c, 0x0f33d1b2 };
+    const uint32_t C2[NITER] = { 0x4b0f3b58, 0xe874f0c3, 0x6955c5a6, 0x55a7ca46 };
+    uint32_t iswap = 0;
+
+    for( uint8_t i = 0; i < NITER; i++ )
+    {
+        uint32_t ia = ( iswap = ( *irword ) ) ^ C1[i];
+        uint32_t itmpl = ia & 0xffff;
+        uint32_t itmph = ia >> 16;
+        uint32_t ib = itmpl * itmpl + ~( itmph * itmph );
+        *irword = ( *lword ) ^ ( ( ( ia = ( ib >> 16 ) | ( ( ib & 0xffff ) << 16 ) ) ^ C2[i] ) + itmpl * itmph );
+        *lword = iswap;
+    }
+}
+
+
+//!************************************************************************
+//! Crossfade from the waveform fading out into the rendered frames
+//!
+//! @returns: nothing
+//!************************************************************************
+void AudioSource::rampFromPreviousWaveform
+    (
+    float*          aFrames,        //!< rendered frames of the new waveform
+    const size_t    aFramesCount    //!< number of frames
+    )
+{
+    const size_t CHANNELS_COUNT = mRingChannels;
+    const size_t framesCount = std::min( aFramesCount, mRampFramesLeft );
+    const std::vector<std::vector<float>>& planes = mPreviousWaveform->planeVec;
+
+    for( size_t i = 0; i < framesCount; i++ )
+    {
+        const float gain = 1.0f - static_cast<float>( mRampFramesLeft - i ) / mRampFrames;
+
+        for( size_t j = 0; j < CHANNELS_COUNT; j++ )
+        {
+            float& value = aFrames[i * CHANNELS_COUNT + j];
+            value = gain * value + ( 1.0f - gain ) * planes[std::min( j, planes.size() - 1 )][mPreviousPos];
+        }
+
+        mPreviousPos = ( mPreviousPos + 1 ) % mPreviousWaveform->framesCount;
+    }
+
+    mRampFramesLeft -= framesCount;
+
+    if( 0 == mRampFramesLeft )
+    {
+        mPreviousWaveform.reset();
+    }
+}
+
+
+//!************************************************************************
+//! Reads up to aLength bytes from the device into aData
+//! see QIODevice::readData()
+//! The ring holds float frames of all channels; they are converted to the
+//! device format here.
+//!
+//! @returns: Number of bytes read
+//!************************************************************************
+qint64 AudioSource::readData
+    (
+    char*   aData,          //!< data content
+    qint64  aLength         //!< data length
+    )
+{
+    // only copies and converts, the samples are produced by the render thread
+    const qint64 FRAME_BYTES = std::max( mAudioFormat.bytesPerFrame(), 1 );
+    const size_t RING_FRAME_BYTES = mRingChannels * sizeof( float );
+    const qint64 framesCount = aLength / FRAME_BYTES;
+    unsigned char* bufferData = reinterpret_cast<unsigned char*>( aData );
+    qint64 framesDone = 0;
+    bool isUnderrun = false;
+
+    while( framesCount > framesDone )
+    {
+        const size_t chunkFrames = std::min<size_t>( framesCount - framesDone, READ_CHUNK_FRAMES );
+        const size_t readFrames = mRing.read( reinterpret_cast<char*>( mReadFrames.data() ), chunkFrames * RING_FRAME_BYTES ) / RING_FRAME_BYTES;
+
+        if( readFrames < chunkFrames )
+        {
+            std::fill( mReadFrames.begin() + readFrames * mRingChannels, mReadFrames.begin() + chunkFrames * mRingChannels, 0.0f );
+            isUnderrun = true;
+        }
+
+        if( mConvertFrames )
+        {
+            ( this->*mConvertFrames )( mReadFrames.data(), chunkFrames, bufferData );
+        }
+        else
+        {
+            memset( bufferData, 0, chunkFrames * FRAME_BYTES );
+        }
+
+        bufferData += chunkFrames * FRAME_BYTES;
+
+        framesDone += chunkFrames;
+    }
+
+    if( isUnderrun )
+    {
+        mUnderrunsCount++;
+    }
+
+    return framesCount * FRAME_BYTES;
+}
+
+
+//!************************************************************************
+//! Read the plane of all channels of a channel array at a delay
+//! Whole delays are copied from the history. Fractional ones are
+//! interpolated from four frames by a cubic Lagrange polynomial, whose
+//! weights are the same for all frames of the channel. Frames before the
+//! generator start read 0; a loop adds its tail to them afterwards.
+//!
+//! @returns: nothing
+//!************************************************************************
+void AudioSource::readHistory
+    (
+    const Generator&    aGenerator,     //!< generator of a channel array
+    const double        aDelay,         //!< delay [frames]
+    const uint64_t      aFirstFrame,    //!< first frame to read
+    double*             aValues,        //!< delayed values
+    const size_t        aFramesCount    //!< number of frames
+    )
+{
+    const std::vector<double>& history = aGenerator.historyVec;
+    const uint64_t mask = history.size() - 1;
+    const uint64_t wholeDelay = static_cast<uint64_t>( aDelay );
+    const double mu = aDelay - wholeDelay;
+
+    // wraps around below frame 0, onto history not written yet
+    const uint64_t firstPos = aFirstFrame - wholeDelay;
+
+    if( 0 == mu )
+    {
+        for( size_t i = 0; i < aFramesCount; i++ )
+        {
+            aValues[i] = history[( firstPos + i ) & mask];
+        }
+    }
+    else
+    {
+        // weights of the frames after, at, one before and two before the position
+        const double wNext = -mu * ( mu - 1 ) * ( mu - 2 ) / 6;
+        const double wAt = ( mu + 1 ) * ( mu - 1 ) * ( mu - 2 ) / 2;
+        const double wPrev = -( mu + 1 ) * mu * ( mu - 2 ) / 2;
+        const double wPrev2 = ( mu + 1 ) * mu * ( mu - 1 ) / 6;
+
+        for( size_t i = 0; i < aFramesCount; i++ )
+        {
+            const uint64_t pos = firstPos + i;
+
+            aValues[i] = wNext * history[( pos + 1 ) & mask]
+                       + wAt * history[pos & mask]
+                       + wPrev * history[( pos - 1 ) & mask]
+                       + wPrev2 * history[( pos - 2 ) & mask];
+        }
+    }
+}
+
+
+//!************************************************************************
+//! Produce aFramesCount ring frames of the waveform
+//! Called by the render thread, and before it starts to prefill the ring.
+//!
+//! @returns: nothing
+//!************************************************************************
+void AudioSource::renderFrames
+    (
+    float*          aFrames,        //!< destination, interleaved ring frames
+    const size_t    aFramesCount    //!< number of frames
+    )
+{
+    size_t framesDone = 0;
+
+    if( mSmcPlaylist )
+    {
+        while( aFramesCount > framesDone )
+        {
+            const size_t chunkFrames = std::min<size_t>( aFramesCount - framesDone, PLAYLIST_CHUNK_FRAMES );
+            mSmcPlaylist->render( mPlaylistFrames.data(), chunkFrames );
+            std::copy( mPlaylistFrames.begin(), mPlaylistFrames.begin() + chunkFrames * mRingChannels, aFrames + framesDone * mRingChannels );
+
+            framesDone += chunkFrames;
+        }
+    }
+    else
+    {
+        while( aFramesCount > framesDone )
+        {
+            // a published snapshot is taken once, then waits for its boundary
+            if( !mActiveSwitch )
+            {
+                mActiveSwitch = std::atomic_exchange( &mPendingSwitch, std::shared_ptr<const SwitchRequest>() );
+                mSwitchWaitFrames = 0;
+            }
+
+            const size_t blockFrames = aFramesCount - framesDone;
+            size_t segmentFrames = blockFrames;
+
+            if( mActiveSwitch )
+            {
+                segmentFrames = findSwitchOffset( blockFrames );
+
+                if( 0 == segmentFrames )
+                {
+                    switchWaveform( *mActiveSwitch );
+                    mActiveSwitch.reset();
+                    mSwitchPending = false;
+                    segmentFrames = blockFrames;
+                }
+            }
+
+            if( mGenerator )
+            {
+                generateFrames( aFrames + framesDone * mRingChannels, segmentFrames );
+            }
+            else
+            {
+                copyWaveform( aFrames + framesDone * mRingChannels, segmentFrames );
+            }
+
+            framesDone += segmentFrames;
+            mFramesRendered += segmentFrames;
+            mSwitchWaitFrames += segmentFrames;
+        }
+    }
+}
+
+
+//!************************************************************************
+//! Prepare the current signal list for playing
+//! Loop mode renders a waveform; continuous mode makes a generator which
+//! is evaluated while playing.
+//!
+//! @returns: nothing
+//!************************************************************************
+void AudioSource::renderSnapshot
+    (
+    SwitchRequest&  aRequest        //!< filled with a waveform or a generator
+    )
+{
+    if( mContinuous && mAudioFormat.isValid() )
+    {
+        std::shared_ptr<Generator> generator = std::make_shared<Generator>();
+        initGenerator( *generator, mSignals );
+        aRequest.generator = generator;
+    }
+    else
+    {
+        std::shared_ptr<Waveform> waveform = std::make_shared<Waveform>();
+
+        if( mAudioFormat.isValid() )
+        {
+            fillWaveform( *waveform );
+        }
+
+        aRequest.waveform = waveform;
+    }
+}
+
+
+//!************************************************************************
+//! Render thread loop
+//! Fills the ring up to the high-water mark, then sleeps until the
+//! consumer drains it below the low-water mark.
+//!
+//! @returns: nothing
+//!************************************************************************
+void AudioSource::runRender()
+{
+    bool refilling = true;
+
+    while( !mStopRender )
+    {
+        const qint64 filled = mRing.getFilledBytes();
+
+        if( filled < mLowWaterBytes )
+        {
+            refilling = true;
+        }
+        else if( filled >= mHighWaterBytes )
+        {
+            refilling = false;
+        }
+
+        if( refilling )
+        {
+            // the ring has room for a whole block above the high-water mark
+            renderFrames( mRenderFrames.data(), RENDER_CHUNK_FRAMES );
+            mRing.write( reinterpret_cast<const char*>( mRenderFrames.data() ), mRenderFrames.size() * sizeof( float ) );
+        }
+        else
+        {
+            std::this_thread::sleep_for( std::chrono::milliseconds( RENDER_POLL_MS ) );
+        }
+    }
+}
+
+
+//!************************************************************************
+//! Move a generator to a frame
+//! The components continue as if evaluated from frame 0; noise continues
+//! and audified traces start playing at that frame. The history of a
+//! channel array is refilled with the components before that frame.
+//!
+//! @returns: nothing
+//!************************************************************************
+void AudioSource::seekGenerator
+    (
+    Generator&      aGenerator,     //!< generator
+    const uint64_t  aFrame          //!< next frame to evaluate
+    ) const
+{
+    uint64_t historyFrames = 0;
+
+    if( aGenerator.delayVec.size() )
+    {
+        const double delayMax = *std::max_element( aGenerator.delayVec.begin(), aGenerator.delayVec.end() );
+        historyFrames = std::min<uint64_t>( static_cast<uint64_t>( delayMax ) + DELAY_TAPS, aFrame );
+        std::fill( aGenerator.historyVec.begin(), aGenerator.historyVec.end(), 0 );
+    }
+
+    initTimebase( aGenerator.timebase, *aGenerator.snapshot, aFrame - historyFrames );
+
+    if( historyFrames )
+    {
+        std::vector<double>& block = aGenerator.blockVec;
+        block.resize( static_cast<size_t>( historyFrames ) * aGenerator.timebase.planesCount );
+        getSignalValues( *aGenerator.snapshot, aGenerator.timebase, block.data(), historyFrames );
+        writeHistory( aGenerator, block.data(), aFrame - historyFrames, historyFrames );
+    }
+}
+
+
+//!************************************************************************
+//! Set the audio buffer length [seconds]
+//! The length only applies to loop mode.
 //!
-//! @returns: If the device is open
+//! @returns: nothing
 //!************************************************************************
-bool AudioSource::isStarted() const
+void AudioSource::setBufferLength
+    (
+    const double aLength          //!< a length in seconds
+    )
 {
-    return isOpen();
+    mAudioBufferLengthSeconds = aLength;
+
+    stopRenderThread();
+    mWaveformPos = 0;
+    close();
+
+    mWaveform.reset();
+    mGenerator.reset();
+
+    if( mAudioFormat.isValid() )
+    {
+        SwitchRequest snapshot;
+        renderSnapshot( snapshot );
+        mWaveform = snapshot.waveform;
+        mGenerator = snapshot.generator;
+    }
 }
 
 
 //!************************************************************************
-//! Pseudo DES (Data Encryption Standard)
-//! adapted from Press, W.H. et al - Numerical Recipes in C. The Art of Scientific Computing
-//!                                  2nd Ed, Cambridge Univ. Press, 1992
-//! see psdes(), subchapter 7.5, page 302
+//! Select band-limited signals with edges
+//! Triangle and Rectangle are then played from wavetables holding only the
+//! harmonics below the Nyquist frequency, instead of being sampled from
+//! their pieces, whose edges alias at high frequencies. Pulse, RiseFall
+//! and TrapDampSin get the frames around their corners smoothed instead.
+//! Applied by the next setData().
 //!
-//! This function is used by generateRandomNag()
+//! @returns: nothing
+//!************************************************************************
+void AudioSource::setBandLimited
+    (
+    const bool      aBandLimited    //!< true to play band-limited piecewise-linear signals
+    )
+{
+    mBandLimited = aBandLimited;
+}
+
+
+//!************************************************************************
+//! Select a channel array, in which every channel plays the signals of
+//! all channels delayed by its own delay
+//! The signals are evaluated once for all the channels. Phase offsets are
+//! given as the delays they make at the signal frequency. Applied by the
+//! next setData().
 //!
 //! @returns: nothing
 //!************************************************************************
-void AudioSource::pseudoDes
+void AudioSource::setChannelArray
     (
-    uint32_t*   lword,      //!< left word
-    uint32_t*   irword      //!< right word
-    ) const
+    const std::vector<double>&  aDelayVec   //!< delay of each channel [s], empty for no array
+    )
 {
-    const uint8_t NITER = 4;
-    const uint32_t C1[NITER] = { 0xbaa96887, 0x1e17d32c, 0x03bcdc3c, 0x0f33d1b2 };
-    const uint32_t C2[NITER] = { 0x4b0f3b58, 0xe874f0c3, 0x6955c5a6, 0x55a7ca46 };
-    uint32_t iswap = 0;
+    mChannelDelayVec = aDelayVec;
+}
 
-    for( uint8_t i = 0; i < NITER; i++ )
+
+//!************************************************************************
+//! Select continuous mode, in which the signals are evaluated forward in
+//! time while playing instead of looping a waveform of the buffer length
+//! Non-periodic signals then play once and noise never repeats. Applied
+//! by the next setData().
+//!
+//! @returns: nothing
+//!************************************************************************
+void AudioSource::setContinuous
+    (
+    const bool      aContinuous     //!< true to generate forward in time instead of looping
+    )
+{
+    mContinuous = aContinuous;
+}
+
+
+//!************************************************************************
+//! Set the data for entire waveform
+//! While playing, the new waveform is rendered here and published as an
+//! immutable snapshot; the render thread switches to it at its next
+//! block, so the output never stops.
+//!
+//! @returns: nothing
+//!************************************************************************
+void AudioSource::setData
+    (
+    const SignalList::Snapshot&     aSignals        //!< signals
+    )
+{
+    const bool isLive = mRenderThread.joinable() && !mSmcPlaylist;
+
+    if( !isLive )
     {
-        uint32_t ia = ( iswap = ( *irword ) ) ^ C1[i];
-        uint32_t itmpl = ia & 0xffff;
-        uint32_t itmph = ia >> 16;
-        uint32_t ib = itmpl * itmpl + ~( itmph * itmph );
-        *irword = ( *lword ) ^ ( ( ( ia = ( ib >> 16 ) | ( ( ib & 0xffff ) << 16 ) ) ^ C2[i] ) + itmpl * itmph );
-        *lword = iswap;
+        stopRenderThread();
+        mWaveformPos = 0;
+        close();
+
+        mWaveform.reset();
+        mGenerator.reset();
+        mSmcPlaylist.reset();
+    }
+
+    mSignals = aSignals;
+
+    std::shared_ptr<SwitchRequest> request = std::make_shared<SwitchRequest>();
+    renderSnapshot( *request );
+
+    if( isLive )
+    {
+        request->settings.crossfadeSeconds = mRampSeconds;
+        request->settings.restart = false;
+
+        mSwitchPending = true;
+        std::atomic_store( &mPendingSwitch, std::shared_ptr<const SwitchRequest>( request ) );
+    }
+    else
+    {
+        mWaveform = request->waveform;
+        mGenerator = request->generator;
     }
 }
 
 
 //!************************************************************************
-//! Reads up to aLength bytes from the device into aData
-//! see QIODevice::readData()
+//! Set the crossfade between waveform snapshots published while playing
+//! Zero switches at once.
 //!
-//! @returns: Number of bytes read
+//! @returns: nothing
 //!************************************************************************
-qint64 AudioSource::readData
+void AudioSource::setRampSeconds
     (
-    char*   aData,          //!< data content
-    qint64  aLength         //!< data length
+    const double    aSeconds        //!< crossfade duration [s]
+    )
+{
+    mRampSeconds = std::max( aSeconds, 0.0 );
+}
+
+
+//!************************************************************************
+//! Play a playlist of strong-motion records instead of the signals
+//! The playlist is rendered by the render thread while playing.
+//!
+//! @returns: nothing
+//!************************************************************************
+void AudioSource::setSmcPlaylist
+    (
+    std::shared_ptr<SmcPlaylist>    aPlaylist       //!< playlist
+    )
+{
+    stopRenderThread();
+    mWaveformPos = 0;
+    close();
+
+    mWaveform.reset();
+    mGenerator.reset();
+    mSignals.reset();
+    mSmcPlaylist = aPlaylist;
+    mPlaylistFrames.assign( static_cast<size_t>( PLAYLIST_CHUNK_FRAMES ) * std::max( mAudioFormat.channelCount(), 1 ), 0 );
+}
+
+
+//!************************************************************************
+//! Set how much rendered audio is kept ahead of the audio device
+//! The render thread refills the ring when it drops below the low-water
+//! mark and stops at the high-water mark. Applied on the next start.
+//!
+//! @returns: nothing
+//!************************************************************************
+void AudioSource::setWaterMarks
+    (
+    const double    aLowSeconds,    //!< low-water mark [s]
+    const double    aHighSeconds    //!< high-water mark [s]
     )
 {
-    qint64 bytesRead = 0;
+    mLowWaterSeconds = std::max( aLowSeconds, 0.0 );
+    mHighWaterSeconds = std::max( aHighSeconds, mLowWaterSeconds );
+}
+
+
+//!************************************************************************
+//! Start the audio source
+//! The ring holds all device channels from the start, so that its layout
+//! never changes while readData() runs, whatever is routed while playing.
+//!
+//! @returns: nothing
+//!************************************************************************
+void AudioSource::start()
+{
+    stopRenderThread();
+
+    mRingChannels = std::max( mAudioFormat.channelCount(), 1 );
 
-    if( !mAudioBuffer.isEmpty() )
+    const qint64 ringFrameBytes = mRingChannels * sizeof( float );
+    const qint64 renderLength = static_cast<qint64>( RENDER_CHUNK_FRAMES ) * ringFrameBytes;
+    mLowWaterBytes = static_cast<qint64>( mLowWaterSeconds * mAudioFormat.sampleRate() ) * ringFrameBytes;
+    mHighWaterBytes = std::max( static_cast<qint64>( mHighWaterSeconds * mAudioFormat.sampleRate() ) * ringFrameBytes, mLowWaterBytes + renderLength );
+
+    mRenderFrames.resize( static_cast<size_t>( RENDER_CHUNK_FRAMES ) * mRingChannels );
+    mRing.setCapacity( mHighWaterBytes + renderLength );
+    mUnderrunsCount = 0;
+    mFramesRendered = 0;
+    mLastValue = 0;
+    mLastCrossed = false;
+
+    // prefill up to the low-water mark, so that playback starts with data
+    while( static_cast<qint64>( mRing.getFilledBytes() ) < mLowWaterBytes )
     {
-        while( aLength - bytesRead > 0 )
-        {
-            const qint64 chunk = qMin( ( mAudioBuffer.size() - mBufferPos ), aLength - bytesRead );
-            memcpy( aData + bytesRead, mAudioBuffer.constData() + mBufferPos, chunk );
-            mBufferPos = ( mBufferPos + chunk ) % mAudioBuffer.size();
-            bytesRead += chunk;
-        }
+        renderFrames( mRenderFrames.data(), RENDER_CHUNK_FRAMES );
+        mRing.write( reinterpret_cast<const char*>( mRenderFrames.data() ), renderLength );
     }
 
-    return bytesRead;
+    mStopRender = false;
+    mRenderThread = std::thread( &AudioSource::runRender, this );
+
+    open( QIODevice::ReadOnly );
 }
 
 
 //!************************************************************************
-//! Set the audio buffer length [seconds]
+//! Set the state of a component at the first frame after its delay, or at
+//! the first frame to evaluate if later
 //!
 //! @returns: nothing
 //!************************************************************************
-void AudioSource::setBufferLength
+void AudioSource::startComponentState
     (
-    const double aLength          //!< a length in seconds
+    ComponentState&     aState,         //!< component state
+    const uint64_t      aFrame,         //!< first frame to evaluate
+    const double        aDelay,         //!< delay of the component [s]
+    const double        aFreqHz,        //!< frequency of the main oscillator [Hz]
+    const double        aAuxFreqHz,     //!< frequency of the second oscillator [Hz]
+    const double        aPeriod,        //!< repetition period, 0 if not periodic [s]
+    const double        aSamplePeriod   //!< time between frames [s]
     )
 {
-    mAudioBufferLengthSeconds = aLength;
+    // a delay on a frame, within rounding, starts on that frame
+    aState.startFrame = ( aDelay > 0 ) ? static_cast<uint64_t>( std::ceil( aDelay / aSamplePeriod - FRAME_ROUNDING ) ) : 0;
+    aState.startFrame = std::max( aState.startFrame, aFrame );
 
-    mBufferPos = 0;
-    close();
+    const double dt0 = std::max( aState.startFrame * aSamplePeriod - aDelay, 0.0 );
+    const double cycles = aFreqHz * dt0;
+    const double auxCycles = aAuxFreqHz * dt0;
 
-    mAudioBuffer.clear();
+    aState.phase = cycles - std::floor( cycles );
+    aState.phaseStep = aFreqHz * aSamplePeriod;
+    aState.auxPhase = auxCycles - std::floor( auxCycles );
+    aState.auxPhaseStep = aAuxFreqHz * aSamplePeriod;
+    aState.period = aPeriod;
 
-    if( mAudioFormat.isValid() )
+    if( aPeriod > 0 )
     {
-        fillDataBuffer();
+        aState.periodIndex = static_cast<uint64_t>( dt0 / aPeriod );
+        aState.periodPos = dt0 - aState.periodIndex * aPeriod;
     }
 }
 
 
 //!************************************************************************
-//! Set the data for entire waveform
+//! Start the exponential envelopes of a component at a frame
+//! Each envelope gets its exact value at the frame, from which it only
+//! takes one multiplication per frame, so that the rounding errors cannot
+//! build up beyond a run. An envelope which starts later gets the frame it
+//! starts on, at which it is started again.
 //!
 //! @returns: nothing
 //!************************************************************************
-void AudioSource::setData
+void AudioSource::startEnvelopes
     (
-    const std::vector<SignalItem*>  aSignalsVector  //!< signals vector
+    const SignalItem&   aSignal,        //!< signal
+    ComponentState&     aState,         //!< component state
+    const uint64_t      aFrame,         //!< frame the envelopes are started at
+    const double        aSamplePeriod   //!< time between frames [s]
     )
 {
-    mBufferPos = 0;
+    const double time = aFrame * aSamplePeriod;
+
+    // first frame after a time
+    auto frameAfter = [aFrame, aSamplePeriod]( const double aTime )
+    {
+        const double frames = std::floor( aTime / aSamplePeriod ) + 1;
+        return ( frames < static_cast<double>( NEVER_FRAME ) ) ? std::max( static_cast<uint64_t>( frames ), aFrame + 1 ) : NEVER_FRAME;
+    };
+
+    aState.envelopeFrame = NEVER_FRAME;
+
+    switch( aSignal.getType() )
+    {
+        case SignalItem::SIGNAL_TYPE_RISEFALL:
+            {
+                const SignalItem::SignalRiseFall& sig = aSignal.getSignalDataRiseFall();
+                aState.envelopeRatio = exp( -aSamplePeriod / sig.tRampRise );
+                aState.auxEnvelopeRatio = exp( -aSamplePeriod / sig.tRampFall );
+
+                if( time > sig.tDelayRise )
+                {
+                    aState.envelope = exp( -( time - sig.tDelayRise ) / sig.tRampRise );
+                }
+                else
+                {
+                    aState.envelope = 1;
+                    aState.envelopeFrame = frameAfter( sig.tDelayRise );
+                }
+
+                if( time > sig.tDelayFall )
+                {
+                    aState.auxEnvelope = exp( -( time - sig.tDelayFall ) / sig.tRampFall );
+                }
+                else
+                {
+                    aState.auxEnvelope = 1;
+                    aState.envelopeFrame = std::min( aState.envelopeFrame, frameAfter( sig.tDelayFall ) );
+                }
+            }
+            break;
+
+        case SignalItem::SIGNAL_TYPE_SINDAMP:
+            {
+                const SignalItem::SignalSinDamp& sig = aSignal.getSignalDataSinDamp();
+                aState.envelopeRatio = exp( -sig.damping * aSamplePeriod );
+                aState.envelope = exp( -sig.damping * ( time - sig.tDelay ) );
+            }
+            break;
+
+        case SignalItem::SIGNAL_TYPE_SINRISE:
+            {
+                const SignalItem::SignalSinRise& sig = aSignal.getSignalDataSinRise();
+                aState.envelopeRatio = exp( sig.damping * aSamplePeriod );
+                aState.envelope = exp( sig.damping * ( time - sig.tEnd ) );
+            }
+            break;
+
+        case SignalItem::SIGNAL_TYPE_SINDAMPSIN:
+            {
+                // the exponential damping changes once per period
+                const SignalItem::SignalSinDampSin& sig = aSignal.getSignalDataSinDampSin();
+
+                switch( sig.dampingType )
+                {
+                    case -3:
+                        aState.periodRatio = exp( 1.0 );
+                        aState.envelope = exp( static_cast<double>( aState.periodIndex ) );
+                        break;
+
+                    case 3:
+                        aState.periodRatio = exp( -1.0 );
+                        aState.envelope = exp( -static_cast<double>( aState.periodIndex ) );
+                        break;
+
+                    default:
+                        aState.envelope = ( sig.dampingType < -3 || sig.dampingType > 3 ) ? 0 : 1;
+                        break;
+                }
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+
+//!************************************************************************
+//! Stop the audio source
+//! A generator starts again from frame 0.
+//!
+//! @returns: nothing
+//!************************************************************************
+void AudioSource::stop()
+{
+    stopRenderThread();
+    mWaveformPos = 0;
     close();
 
-    mAudioBuffer.clear();
-    mSignalsVector.clear();
+    if( mGenerator )
+    {
+        std::shared_ptr<Generator> generator = std::make_shared<Generator>();
+        initGenerator( *generator, mGenerator->snapshot );
+        mGenerator = generator;
+    }
+}
+
+
+//!************************************************************************
+//! Stop the render thread and drop the rendered audio
+//!
+//! @returns: nothing
+//!************************************************************************
+void AudioSource::stopRenderThread()
+{
+    mStopRender = true;
 
-    for( size_t i = 0; i < aSignalsVector.size(); i++ )
+    if( mRenderThread.joinable() )
     {
-        mSignalsVector.push_back( aSignalsVector.at( i ) );
+        mRenderThread.join();
     }
 
-    if( mAudioFormat.isValid() )
+    // a queued waveform replaces the current one, the newest wins
+    std::shared_ptr<const SwitchRequest> pendingSwitch = std::atomic_exchange( &mPendingSwitch, std::shared_ptr<const SwitchRequest>() );
+
+    if( !pendingSwitch )
+    {
+        pendingSwitch = mActiveSwitch;
+    }
+
+    if( pendingSwitch )
     {
-        fillDataBuffer();
+        mWaveform = pendingSwitch->waveform;
+        mGenerator = pendingSwitch->generator;
     }
+
+    mActiveSwitch.reset();
+    mSwitchPending = false;
+    mPreviousWaveform.reset();
+    mPreviousGenerator.reset();
+    mRampFramesLeft = 0;
+    mRing.reset();
 }
 
 
 //!************************************************************************
-//! Start the audio source
+//! Switch the render thread to a published snapshot
+//! The position either restarts or is kept modulo the new length, so that
+//! the time base continues; a generator is moved to the frame of the one
+//! it replaces. The previous snapshot fades out if requested.
 //!
 //! @returns: nothing
 //!************************************************************************
-void AudioSource::start()
+void AudioSource::switchWaveform
+    (
+    const SwitchRequest&    aRequest    //!< new snapshot and how to switch
+    )
 {
-    open( QIODevice::ReadOnly );
+    const size_t rampFrames = static_cast<size_t>( aRequest.settings.crossfadeSeconds * mAudioFormat.sampleRate() );
+
+    if( aRequest.generator )
+    {
+        if( !aRequest.settings.restart && mGenerator )
+        {
+            seekGenerator( *aRequest.generator, mGenerator->timebase.frame );
+        }
+
+        if( rampFrames && mGenerator )
+        {
+            mPreviousGenerator = mGenerator;
+            mRampFrames = rampFrames;
+            mRampFramesLeft = rampFrames;
+        }
+        else
+        {
+            mPreviousGenerator.reset();
+            mRampFramesLeft = 0;
+        }
+
+        mGenerator = aRequest.generator;
+        mWaveform.reset();
+        mPreviousWaveform.reset();
+        return;
+    }
+
+    const std::shared_ptr<const Waveform>& waveform = aRequest.waveform;
+
+    if( rampFrames && mWaveform && mWaveform->framesCount && waveform->framesCount )
+    {
+        mPreviousWaveform = mWaveform;
+        mPreviousPos = mWaveformPos;
+        mRampFrames = rampFrames;
+        mRampFramesLeft = rampFrames;
+    }
+    else
+    {
+        mPreviousWaveform.reset();
+        mRampFramesLeft = 0;
+    }
+
+    mWaveform = waveform;
+    mGenerator.reset();
+    mPreviousGenerator.reset();
+
+    if( aRequest.settings.restart || 0 == waveform->framesCount )
+    {
+        mWaveformPos = 0;
+    }
+    else
+    {
+        mWaveformPos %= waveform->framesCount;
+    }
 }
 
 
 //!************************************************************************
-//! Stop the audio source
+//! Update the active components at the current frame of a timebase
+//! Components whose start frame came are activated, and those whose end
+//! frame came are folded into the settled offset.
 //!
 //! @returns: nothing
 //!************************************************************************
-void AudioSource::stop()
+void AudioSource::updateActiveComponents
+    (
+    Timebase&   aTimebase   //!< sample clock and component states
+    )
 {
-    mBufferPos = 0;
-    close();
+    const uint64_t frame = aTimebase.frame;
+    std::vector<size_t>& activeVec = aTimebase.activeVec;
+    std::vector<size_t>& waitingVec = aTimebase.waitingVec;
+
+    while( waitingVec.size() && aTimebase.stateVec.at( waitingVec.back() ).startFrame <= frame )
+    {
+        // the signals order is kept, so that the sum does not depend on the start order
+        activeVec.insert( std::lower_bound( activeVec.begin(), activeVec.end(), waitingVec.back() ), waitingVec.back() );
+        waitingVec.pop_back();
+    }
+
+    uint64_t nextEventFrame = waitingVec.size() ? aTimebase.stateVec.at( waitingVec.back() ).startFrame : NEVER_FRAME;
+    size_t activeCount = 0;
+
+    for( size_t i = 0; i < activeVec.size(); i++ )
+    {
+        const ComponentState& state = aTimebase.stateVec.at( activeVec.at( i ) );
+
+        if( state.endFrame <= frame )
+        {
+            aTimebase.settledOffsetVec.at( state.plane ) += state.settledValue;
+        }
+        else
+        {
+            activeVec.at( activeCount++ ) = activeVec.at( i );
+            nextEventFrame = std::min( nextEventFrame, state.endFrame );
+        }
+    }
+
+    activeVec.resize( activeCount );
+    aTimebase.nextEventFrame = nextEventFrame;
 }
 
 
@@ -1006,3 +3151,26 @@ qint64 AudioSource::writeData
     Q_UNUSED( aLength );
     return 0;
 }
+
+
+//!************************************************************************
+//! Write the plane of all channels of a channel array to its history
+//!
+//! @returns: nothing
+//!************************************************************************
+void AudioSource::writeHistory
+    (
+    Generator&          aGenerator,     //!< generator of a channel array
+    const double*       aValues,        //!< values of the plane of all channels
+    const uint64_t      aFirstFrame,    //!< frame of the first value
+    const size_t        aFramesCount    //!< number of frames
+    )
+{
+    std::vector<double>& history = aGenerator.historyVec;
+    const uint64_t mask = history.size() - 1;
+
+    for( size_t i = 0; i < aFramesCount; i++ )
+    {
+        history[( aFirstFrame + i ) & mask] = aValues[i];
+    }
+}
@@ -28,10 +28,22 @@ This file contains the definitions for the audio source.
 #include <QByteArray>
 #include <QIODevice>
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
 #include <cstdint>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <type_traits>
 #include <vector>
 
-#include "SignalItem.h"
+#include "AudioRingBuffer.h"
+#include "NoisePwrSpectrum.h"
+#include "PolyphaseResampler.h"
+#include "SignalList.h"
+#include "SmcPlaylist.h"
+#include "WavetableBank.h"
 
 
 //************************************************************************
@@ -40,6 +52,273 @@ This file contains the definitions for the audio source.
 class AudioSource : public QIODevice
 {
     Q_OBJECT
+    //************************************************************************
+    // constants and types
+    //************************************************************************
+    public:
+        static constexpr double LOW_WATER_SECONDS_DEFAULT = 0.1;    //!< render thread refills below this [s]
+        static constexpr double HIGH_WATER_SECONDS_DEFAULT = 0.5;   //!< render thread pauses above this [s]
+        static constexpr double RAMP_SECONDS_DEFAULT = 0.02;        //!< crossfade of live waveform updates [s]
+
+        typedef enum : uint8_t
+        {
+            SWITCH_AT_BLOCK,            //!< at the next rendered block
+            SWITCH_AT_PERIOD,           //!< at the next multiple of a period of the waveform time
+            SWITCH_AT_ZERO_CROSSING,    //!< where the first channel crosses zero
+            SWITCH_AT_FRAME             //!< at an output frame, see getFramesRendered()
+        }SwitchBoundary;
+
+        // where and how a cued waveform replaces the one being played
+        struct SwitchSettings
+        {
+            SwitchBoundary  boundary;           //!< switching boundary
+            double          periodSeconds;      //!< period for SWITCH_AT_PERIOD [s]
+            uint64_t        frame;              //!< output frame for SWITCH_AT_FRAME
+            double          crossfadeSeconds;   //!< crossfade, 0 to switch at once [s]
+            bool            restart;            //!< true to play the new waveform from its beginning
+
+            SwitchSettings()
+            {
+                boundary = SWITCH_AT_BLOCK;
+                periodSeconds = 0;
+                frame = 0;
+                crossfadeSeconds = 0;
+                restart = true;
+            }
+        };
+
+    private:
+        // looped waveform as floats in [-1..1]; a single plane is played on all channels
+        struct Waveform
+        {
+            std::vector<std::vector<float>> planeVec;       //!< one plane, or one plane for each channel
+            size_t                          framesCount;    //!< frames in each plane
+
+            Waveform()
+            {
+                framesCount = 0;
+            }
+        };
+
+        struct Generator;
+
+        // snapshot published to the render thread
+        struct SwitchRequest
+        {
+            std::shared_ptr<const Waveform>     waveform;   //!< rendered waveform, in loop mode
+            std::shared_ptr<Generator>          generator;  //!< generator, in continuous mode
+            SwitchSettings                      settings;   //!< where and how to switch
+        };
+
+        static const uint16_t RENDER_CHUNK_FRAMES = 512;    //!< frames rendered at once by the render thread
+        static const uint16_t READ_CHUNK_FRAMES = 512;      //!< ring frames converted at once by readData()
+        static const uint8_t RENDER_POLL_MS = 5;            //!< render thread sleep above the high-water mark
+        static const uint16_t SMC_STREAM_CHUNK = 256;   //!< SMC samples resampled at once
+        static const uint16_t PLAYLIST_CHUNK_FRAMES = 1024; //!< playlist frames rendered at once
+
+        static constexpr double FRAME_ROUNDING = 1e-6;      //!< delays and period ends this close to a frame [frames] fall on it
+        static const uint8_t DELAY_TAPS = 4;                //!< frames read for a fractional delay of a channel array
+        static constexpr double ZERO_CROSSING_WAIT_SECONDS = 1.0;   //!< continuous mode switches at once without a crossing this long [s]
+
+        static constexpr uint64_t NEVER_FRAME = std::numeric_limits<uint64_t>::max();    //!< frame of an event which never comes
+
+        // linear piece of a periodic piecewise-linear signal
+        struct Segment
+        {
+            double      tStart;         //!< start in the period [s]
+            double      tEnd;           //!< end in the period, included [s]
+            double      yStart;         //!< value at the start
+            double      slope;          //!< value change per second [1/s]
+        };
+
+        // value and slope change of a component at a discontinuity or kink
+        struct Corner
+        {
+            double      t;              //!< time, in the period if periodic [s]
+            double      step;           //!< value change
+            double      slopeStep;      //!< slope change [1/s]
+        };
+
+        // state of one signal component along the sample clock
+        struct ComponentState
+        {
+            uint64_t    startFrame;     //!< first frame at or after the delay
+            uint64_t    endFrame;       //!< first frame where the component keeps its settled value
+            double      settledValue;   //!< constant value from the end frame on
+            double      phase;          //!< wrapped phase of the main oscillator [cycles]
+            double      phaseStep;      //!< phase advance of the main oscillator per frame [cycles]
+            double      auxPhase;       //!< wrapped phase of the second oscillator [cycles]
+            double      auxPhaseStep;   //!< phase advance of the second oscillator per frame [cycles]
+            double      period;         //!< repetition period, 0 if not periodic [s]
+            double      periodPos;      //!< time into the current period [s]
+            uint64_t    periodIndex;    //!< periods completed since the delay
+            double      envelope;       //!< main exponential envelope
+            double      envelopeRatio;  //!< change of the main envelope per frame
+            double      auxEnvelope;    //!< second exponential envelope
+            double      auxEnvelopeRatio;   //!< change of the second envelope per frame
+            double      periodRatio;    //!< change of the main envelope per period
+            uint64_t    envelopeFrame;  //!< next frame where an envelope starts
+            std::vector<Segment> segmentVec;    //!< pieces of a piecewise-linear signal, in period order
+            std::shared_ptr<const WavetableBank::Wavetable> wavetable;  //!< band-limited cycle played instead of the pieces
+            const float*        table;          //!< level of the wavetable being played
+            double              tableScale;     //!< value range of the wavetable
+            double              tableOffset;    //!< value of the wavetable bottom
+            std::vector<Corner> cornerVec;      //!< corners smoothed in band-limited mode
+            bool                trapCorrected;  //!< TrapDampSin corners smoothed in band-limited mode
+            size_t              plane;          //!< values plane, 0 for all channels or 1 + the channel
+
+            ComponentState()
+            {
+                startFrame = 0;
+                endFrame = NEVER_FRAME;
+                settledValue = 0;
+                phase = 0;
+                phaseStep = 0;
+                auxPhase = 0;
+                auxPhaseStep = 0;
+                period = 0;
+                periodPos = 0;
+                periodIndex = 0;
+                envelope = 1;
+                envelopeRatio = 1;
+                auxEnvelope = 1;
+                auxEnvelopeRatio = 1;
+                periodRatio = 1;
+                envelopeFrame = NEVER_FRAME;
+                table = nullptr;
+                tableScale = 0;
+                tableOffset = 0;
+                trapCorrected = false;
+                plane = 0;
+            }
+        };
+
+        // 64-bit sample clock, with the state of each signal component;
+        // only the components inside their active interval are evaluated,
+        // into the plane of all channels or into the plane of their channel
+        struct Timebase
+        {
+            uint64_t                    frame;          //!< next frame to evaluate
+            double                      samplePeriod;   //!< time between frames [s]
+            std::vector<ComponentState> stateVec;       //!< one state for each signal, in the signals order
+            std::vector<size_t>         activeVec;      //!< indexes of the active components, in the signals order
+            std::vector<size_t>         waitingVec;     //!< indexes of the components not started, the latest start first
+            size_t                      planesCount;    //!< 1, or 1 + one plane for each channel
+            std::vector<double>         settledOffsetVec;   //!< sum of the settled values of the ended components, for each plane
+            uint64_t                    nextEventFrame; //!< next frame where a component starts or ends
+
+            Timebase()
+            {
+                frame = 0;
+                samplePeriod = 0;
+                planesCount = 1;
+                settledOffsetVec.assign( 1, 0 );
+                nextEventFrame = 0;
+            }
+        };
+
+        // converter of ring frames to device frames, specialized for one sample format
+        typedef void ( AudioSource::*ConvertFrames )( const float*, const size_t, unsigned char* ) const;
+
+        // audified SMC trace, resampled while the buffer is filled
+        struct SmcStream
+        {
+            const SignalItem::SignalSmc&    signal; //!< SMC trace, held by the generator signals
+            PolyphaseResampler      resampler;      //!< resampler to the output rate
+            size_t                  inputPos;       //!< next SMC sample to resample
+            std::vector<double>     outputVec;      //!< resampled values
+            size_t                  outputPos;      //!< next resampled value to play
+            uint64_t                startFrame;     //!< output frame of the first SMC sample
+            bool                    flushed;        //!< true if the resampler tail was pushed out
+
+            SmcStream
+                (
+                const SignalItem::SignalSmc&    aSignal,        //!< SMC trace
+                const double                    aOutputRate     //!< output sampling rate [SPS]
+                )
+                : signal( aSignal )
+                , resampler( aSignal.sps * aSignal.speedUp, aOutputRate )
+            {
+                inputPos = 0;
+                outputPos = 0;
+                startFrame = static_cast<uint64_t>( std::llround( aSignal.tStart / aSignal.speedUp * aOutputRate ) );
+                flushed = false;
+            }
+        };
+
+        // state of the random generators of one noise component
+        struct RandomState
+        {
+            int32_t     dekSeed;        //!< seed of generateRandomDek()
+            int32_t     dekNext;        //!< next table index of generateRandomDek()
+            int32_t     dekNextP;       //!< second table index of generateRandomDek()
+            int32_t     dekTable[56];   //!< table of generateRandomDek()
+            int32_t     dekReady;       //!< 0 until the table is seeded
+            int32_t     nagSeed;        //!< counter of generateRandomNag()
+            int32_t     nagKey;         //!< key of generateRandomNag()
+
+            RandomState
+                (
+                const int32_t   aSeed       //!< seed
+                )
+                : dekTable()
+            {
+                dekSeed = aSeed;
+                dekNext = 0;
+                dekNextP = 0;
+                dekReady = 0;
+                nagSeed = aSeed;
+                nagKey = 0;
+            }
+        };
+
+        // noise component, filtered sample by sample
+        struct NoiseStream
+        {
+            SignalItem::SignalNoise     signal;         //!< noise signal
+            NoisePwrSpectrum            spectrum;       //!< coloring filter, used if gamma is not 0
+            std::vector<double>         delayLine;      //!< state of the coloring filter
+            RandomState                 random;         //!< random generators, own to the stream
+            int8_t                      channel;        //!< output channel, -1 for all channels
+
+            NoiseStream
+                (
+                const SignalItem::SignalNoise&  aSignal,    //!< noise signal
+                const int8_t                    aChannel    //!< output channel, -1 for all channels
+                )
+                : signal( aSignal )
+                , spectrum( aSignal.gamma )
+                , random( rand() )
+            {
+                channel = aChannel;
+            }
+        };
+
+        // signal list evaluated forward in time; it shares an immutable
+        // snapshot of the signals, which its streams refer to
+        struct Generator
+        {
+            SignalList::Snapshot                snapshot;       //!< signals, shared with the list they were taken from
+            Timebase                            timebase;       //!< sample clock and component states
+            std::vector<const SignalItem::SignalSmc*>   channelTraces;  //!< traces routed to channels
+            std::vector<SmcStream>              smcStreams;     //!< audified traces
+            std::vector<NoiseStream>            noiseStreams;   //!< noise components
+            size_t                              planesCount;    //!< 1, or one value for each channel
+            std::vector<double>                 blockVec;       //!< values of the block being generated, plane after plane
+            std::vector<double>                 rowVec;         //!< values of the planes at one frame
+            std::vector<double>                 delayVec;       //!< delay of each channel of a channel array [frames], empty if not an array
+            std::vector<double>                 historyVec;     //!< past values of the plane of all channels, at their frame modulo its power-of-2 size
+            std::vector<double>                 delayedVec;     //!< values of the block delayed for each channel, plane after plane
+
+            Generator()
+            {
+                planesCount = 1;
+            }
+
+            Generator( const Generator& ) = delete;
+            Generator& operator=( const Generator& ) = delete;
+        };
+
     //************************************************************************
     // functions
     //************************************************************************
@@ -50,10 +329,26 @@ class AudioSource : public QIODevice
             const uint32_t      aBufferLengthSeconds    //!< audio buffer length [seconds]
             );
 
+        ~AudioSource();
+
         qint64 bytesAvailable() const override;
 
+        void cueData
+            (
+            const SignalList::Snapshot&     aSignals,           //!< signals
+            const SwitchSettings&           aSettings           //!< where and how to switch
+            );
+
+        uint64_t getFramesRendered() const;
+
+        double getRingFillSeconds() const;
+
+        uint32_t getUnderrunsCount() const;
+
         bool isStarted() const;
 
+        bool isSwitchPending() const;
+
         qint64 readData
             (
             char*       aData,              //!< data content
@@ -65,9 +360,40 @@ class AudioSource : public QIODevice
             const double aLength            //!< a length in seconds
             );
 
+        void setBandLimited
+            (
+            const bool      aBandLimited    //!< true to play band-limited piecewise-linear signals
+            );
+
+        void setChannelArray
+            (
+            const std::vector<double>&  aDelayVec   //!< delay of each channel [s], empty for no array
+            );
+
+        void setContinuous
+            (
+            const bool      aContinuous     //!< true to generate forward in time instead of looping
+            );
+
         void setData
             (
-            const std::vector<SignalItem*>  aSignalsVector  //!< signals vector
+            const SignalList::Snapshot&     aSignals        //!< signals
+            );
+
+        void setRampSeconds
+            (
+            const double    aSeconds        //!< crossfade duration [s]
+            );
+
+        void setSmcPlaylist
+            (
+            std::shared_ptr<SmcPlaylist>    aPlaylist       //!< playlist
+            );
+
+        void setWaterMarks
+            (
+            const double    aLowSeconds,    //!< low-water mark [s]
+            const double    aHighSeconds    //!< high-water mark [s]
             );
 
         void start();
@@ -82,97 +408,227 @@ class AudioSource : public QIODevice
 
 
     private:
-        void fillDataBuffer();
+        void addChannelSignalValues
+            (
+            const std::vector<const SignalItem::SignalSmc*>&    aChannelTraces,     //!< traces routed to channels
+            const double                                        aTime,              //!< time
+            std::vector<double>&                                aChannelValues      //!< values for each output channel
+            ) const;
 
-        double generateRandomDek
+        static void addCornerCorrections
             (
-            int32_t*   pIdum                //!< seed value
+            const ComponentState&   aState,         //!< component state
+            const double            aStartTime,     //!< time of the first frame, in the period if periodic [s]
+            const double            aSamplePeriod,  //!< time between frames [s]
+            double*                 aValues,        //!< values the corrections are added to
+            const size_t            aFramesCount    //!< number of frames
+            );
+
+        static void addEdgeCorrection
+            (
+            const double        aPosition,      //!< corner position from the first frame [frames]
+            const double        aStep,          //!< value change at the corner
+            const double        aSlopeStep,     //!< slope change at the corner [1/frame]
+            double*             aValues,        //!< values the correction is added to
+            const size_t        aFramesCount    //!< number of frames
+            );
+
+        static void addSegment
+            (
+            ComponentState&     aState,         //!< component state
+            const double        aEnd,           //!< end in the period, included [s]
+            const double        aStartValue,    //!< value at the start
+            const double        aSlope          //!< value change per second [1/s]
+            );
+
+        static void addSegmentValues
+            (
+            ComponentState&     aState,         //!< component state
+            const double        aSamplePeriod,  //!< time between frames [s]
+            double*             aValues,        //!< values the signal is added to
+            const size_t        aFramesCount    //!< number of frames
+            );
+
+        static void addTrapDampSinCorrections
+            (
+            const SignalItem::SignalTrapDampSin&    aSignalData,    //!< TrapDampSin signal data
+            const double                            aStartTime,     //!< time of the first frame [s]
+            const double                            aSamplePeriod,  //!< time between frames [s]
+            double*                                 aValues,        //!< values the corrections are added to
+            const size_t                            aFramesCount    //!< number of frames
+            );
+
+        static void addWavetableValues
+            (
+            ComponentState&     aState,         //!< component state
+            double*             aValues,        //!< values the signal is added to
+            const size_t        aFramesCount    //!< number of frames
+            );
+
+        static void advanceComponentState
+            (
+            ComponentState&     aState,         //!< component state
+            const double        aSamplePeriod   //!< time between frames [s]
+            );
+
+        void copyWaveform
+            (
+            float*          aFrames,        //!< destination, interleaved ring frames
+            const size_t    aFramesCount    //!< number of frames
+            );
+
+        void fillWaveform
+            (
+            Waveform&       aWaveform       //!< filled waveform
+            );
+
+        size_t findSwitchOffset
+            (
+            const size_t    aBlockFrames    //!< frames of the block being rendered
             ) const;
 
-        double generateRandomNag
+        void generateBlock
             (
-            int32_t*   pIdum                //!< seed value
+            Generator&      aGenerator,     //!< generator
+            const size_t    aFramesCount,   //!< number of frames
+            double*         aValues         //!< interleaved values of the planes
             ) const;
 
+        void generateFrames
+            (
+            float*          aFrames,        //!< destination, interleaved ring frames
+            const size_t    aFramesCount    //!< number of frames
+            );
 
-        double getSignalValue
+        double generateRandomDek
             (
-            const double         aTime      //!< time
+            RandomState&    aState          //!< state of the generator
             ) const;
 
-
-        double getSignalValueTriangle
+        double generateRandomNag
             (
-            const SignalItem::SignalTriangle    aSignalData,    //!< Triangle signal data
-            const double                        aTime           //!< time
+            RandomState&    aState          //!< state of the generator
             ) const;
 
-        double getSignalValueRectangle
+
+        void getSignalValues
             (
-            const SignalItem::SignalRectangle   aSignalData,    //!< Rectangle signal data
-            const double                        aTime           //!< time
+            const std::vector<SignalItem>&  aSignals,       //!< signals
+            Timebase&                       aTimebase,      //!< sample clock and component states
+            double*                         aValues,        //!< sums of the signal values
+            const size_t                    aFramesCount    //!< number of frames
             ) const;
 
-        double getSignalValuePulse
+        double getComponentValue
             (
-            const SignalItem::SignalPulse       aSignalData,    //!< Pulse signal data
+            const SignalItem&                   aSignal,        //!< signal
+            const ComponentState&               aState,         //!< component state
             const double                        aTime           //!< time
             ) const;
 
+
+        static uint64_t getEndFrame
+            (
+            const double        aEndTime,       //!< time from which a component is settled [s]
+            const double        aSamplePeriod   //!< time between frames [s]
+            );
+
+        double getSettledLevel() const;
+
         double getSignalValueRiseFall
             (
-            const SignalItem::SignalRiseFall    aSignalData,    //!< RiseFall signal data
+            const SignalItem::SignalRiseFall&   aSignalData,    //!< RiseFall signal data
+            const ComponentState&               aState,         //!< component state
             const double                        aTime           //!< time
             ) const;
 
         double getSignalValueSinDamp
             (
-            const SignalItem::SignalSinDamp     aSignalData,    //!< SinDamp signal data
-            const double                        aTime           //!< time
+            const SignalItem::SignalSinDamp&    aSignalData,    //!< SinDamp signal data
+            const ComponentState&               aState          //!< component state
             ) const;
 
         double getSignalValueSinRise
             (
-            const SignalItem::SignalSinRise     aSignalData,    //!< SinRise signal data
+            const SignalItem::SignalSinRise&    aSignalData,    //!< SinRise signal data
+            const ComponentState&               aState,         //!< component state
             const double                        aTime           //!< time
             ) const;
 
         double getSignalValueWavSin
             (
-            const SignalItem::SignalWavSin      aSignalData,    //!< WavSin signal data
+            const SignalItem::SignalWavSin&     aSignalData,    //!< WavSin signal data
+            const ComponentState&               aState,         //!< component state
             const double                        aTime           //!< time
             ) const;
 
         double getSignalValueAmSin
             (
-            const SignalItem::SignalAmSin       aSignalData,    //!< AmSin signal data
-            const double                        aTime           //!< time
+            const SignalItem::SignalAmSin&      aSignalData,    //!< AmSin signal data
+            const ComponentState&               aState          //!< component state
             ) const;
 
         double getSignalValueSinDampSin
             (
-            const SignalItem::SignalSinDampSin  aSignalData,    //!< SinDampSin signal data
-            const double                        aTime           //!< time
+            const SignalItem::SignalSinDampSin& aSignalData,    //!< SinDampSin signal data
+            const ComponentState&               aState          //!< component state
             ) const;
 
         double getSignalValueTrapDampSin
             (
-            const SignalItem::SignalTrapDampSin aSignalData,    //!< TrapDampSin signal data
-            const double                        aTime           //!< time
+            const SignalItem::SignalTrapDampSin&    aSignalData,    //!< TrapDampSin signal data
+            const ComponentState&                   aState,         //!< component state
+            const double                            aTime           //!< time
             ) const;
 
         double getSignalValueNoise
             (
-            const SignalItem::SignalNoise       aSignalData,    //!< Noise signal data
+            const SignalItem::SignalNoise&      aSignalData,    //!< Noise signal data
+            RandomState&                        aRandom,        //!< random generators of the noise
             const double                        aTime           //!< time
             ) const;
 
         double getSignalValueSmc
             (
-            const SignalItem::SignalSmc         aSignalData,    //!< SMC signal data
+            const SignalItem::SignalSmc&        aSignalData,    //!< SMC signal data
             const double                        aTime           //!< time
             ) const;
 
+        double getSmcStreamValue
+            (
+            SmcStream&                          aStream,        //!< audified SMC trace
+            const uint64_t                      aFrame          //!< output frame
+            ) const;
+
+
+        static uint8_t getWavSinIndex
+            (
+            const SignalItem::SignalWavSin&     aSignalData     //!< WavSin signal data
+            );
+
+        static void initCorners
+            (
+            ComponentState&     aState          //!< component state
+            );
+
+        void initGenerator
+            (
+            Generator&                      aGenerator, //!< generator
+            const SignalList::Snapshot&     aSignals    //!< signals
+            ) const;
+
+        static bool initWavetable
+            (
+            ComponentState&     aState,         //!< component state
+            const double        aSamplePeriod   //!< time between frames [s]
+            );
+
+        void initTimebase
+            (
+            Timebase&                       aTimebase,  //!< sample clock and component states
+            const std::vector<SignalItem>&  aSignals,   //!< signals
+            const uint64_t                  aFrame      //!< first frame to evaluate
+            ) const;
 
         void pseudoDes
             (
@@ -180,6 +636,136 @@ class AudioSource : public QIODevice
             uint32_t*   irword      //!< right word
             ) const;
 
+        static void readHistory
+            (
+            const Generator&    aGenerator,     //!< generator of a channel array
+            const double        aDelay,         //!< delay [frames]
+            const uint64_t      aFirstFrame,    //!< first frame to read
+            double*             aValues,        //!< delayed values
+            const size_t        aFramesCount    //!< number of frames
+            );
+
+        void rampFromPreviousWaveform
+            (
+            float*          aFrames,        //!< rendered frames of the new waveform
+            const size_t    aFramesCount    //!< number of frames
+            );
+
+        void renderFrames
+            (
+            float*          aFrames,        //!< destination, interleaved ring frames
+            const size_t    aFramesCount    //!< number of frames
+            );
+
+        void renderSnapshot
+            (
+            SwitchRequest&  aRequest        //!< filled with a waveform or a generator
+            );
+
+        void runRender();
+
+        void seekGenerator
+            (
+            Generator&      aGenerator,     //!< generator
+            const uint64_t  aFrame          //!< next frame to evaluate
+            ) const;
+
+        static void startComponentState
+            (
+            ComponentState&     aState,         //!< component state
+            const uint64_t      aFrame,         //!< first frame to evaluate
+            const double        aDelay,         //!< delay of the component [s]
+            const double        aFreqHz,        //!< frequency of the main oscillator [Hz]
+            const double        aAuxFreqHz,     //!< frequency of the second oscillator [Hz]
+            const double        aPeriod,        //!< repetition period, 0 if not periodic [s]
+            const double        aSamplePeriod   //!< time between frames [s]
+            );
+
+        static void startEnvelopes
+            (
+            const SignalItem&   aSignal,        //!< signal
+            ComponentState&     aState,         //!< component state
+            const uint64_t      aFrame,         //!< frame the envelopes are started at
+            const double        aSamplePeriod   //!< time between frames [s]
+            );
+
+        void stopRenderThread();
+
+        static void updateActiveComponents
+            (
+            Timebase&   aTimebase           //!< sample clock and component states
+            );
+
+        void switchWaveform
+            (
+            const SwitchRequest&    aRequest    //!< new snapshot and how to switch
+            );
+
+        static void writeHistory
+            (
+            Generator&          aGenerator,     //!< generator of a channel array
+            const double*       aValues,        //!< values of the plane of all channels
+            const uint64_t      aFirstFrame,    //!< frame of the first value
+            const size_t        aFramesCount    //!< number of frames
+            );
+
+        //!************************************************************************
+        //! Convert ring frames to device frames of sample type T
+        //! One instance is made for each sample format, so that the per-sample
+        //! loop holds no format switch.
+        //!
+        //! @returns: nothing
+        //!************************************************************************
+        template<typename T>
+        void convertFrames
+            (
+            const float*    aFrames,        //!< ring frames
+            const size_t    aFramesCount,   //!< number of frames
+            unsigned char*  aData           //!< device frames
+            ) const
+        {
+            const size_t CHANNELS_COUNT = mAudioFormat.channelCount();
+            T* data = reinterpret_cast<T*>( aData );
+
+            for( size_t i = 0; i < aFramesCount * CHANNELS_COUNT; i++ )
+            {
+                data[i] = convertSample<T>( aFrames[i] );
+            }
+        }
+
+        //!************************************************************************
+        //! Convert a value in [-1..1] to a sample of type T
+        //! Integer samples are clipped, as a crossfade or a sum of planes may
+        //! overshoot the range.
+        //!
+        //! @returns: the sample
+        //!************************************************************************
+        template<typename T>
+        static T convertSample
+            (
+            const float     aValue          //!< value in [-1..1]
+            )
+        {
+            const float clipped = std::clamp( aValue, -1.0f, 1.0f );
+
+            if constexpr( std::is_same<T, uint8_t>::value )
+            {
+                return static_cast<uint8_t>( 255 * ( 1.0f + clipped ) / 2 );
+            }
+            else if constexpr( std::is_same<T, int16_t>::value )
+            {
+                return static_cast<int16_t>( clipped * 32767 );
+            }
+            else if constexpr( std::is_same<T, int32_t>::value )
+            {
+                return static_cast<int32_t>( static_cast<double>( clipped ) * std::numeric_limits<int32_t>::max() );
+            }
+            else
+            {
+                return aValue;
+            }
+        }
+
 
     //************************************************************************
     // variables
@@ -187,9 +773,45 @@ class AudioSource : public QIODevice
     private:
         QAudioFormat                mAudioFormat;               //!< audio format
         double                      mAudioBufferLengthSeconds;  //!< length of audio buffer [seconds]
-        qint64                      mBufferPos;                 //!< current position in data buffer
-        QByteArray                  mAudioBuffer;               //!< audio data buffer
-        std::vector<SignalItem*>    mSignalsVector;             //!< signals vector
+        size_t                      mWaveformPos;               //!< current frame in the waveform
+        std::shared_ptr<const Waveform> mWaveform;              //!< waveform being played
+        bool                        mContinuous;                //!< true to generate forward in time instead of looping
+        bool                        mBandLimited;               //!< true to play band-limited piecewise-linear signals
+        std::vector<double>         mChannelDelayVec;           //!< delay of each channel of a channel array [s], empty if not an array
+        std::shared_ptr<Generator>  mGenerator;                 //!< generator being played in continuous mode
+        std::vector<double>         mGeneratorValues;           //!< frame produced by the generator
+        float                       mLastValue;                 //!< last generated value of the first channel
+        bool                        mLastCrossed;               //!< true if the last generated frame crossed zero
+        SignalList::Snapshot        mSignals;                   //!< signals
+        std::shared_ptr<SmcPlaylist> mSmcPlaylist;              //!< playlist played instead of the signals
+        std::vector<double>         mPlaylistFrames;            //!< interleaved frames rendered by the playlist
+
+        double                      mLowWaterSeconds;           //!< render thread refills below this [s]
+        double                      mHighWaterSeconds;          //!< render thread pauses above this [s]
+        qint64                      mLowWaterBytes;             //!< low-water mark of the current start [ring bytes]
+        qint64                      mHighWaterBytes;            //!< high-water mark of the current start [ring bytes]
+        AudioRingBuffer             mRing;                      //!< rendered float frames waiting for the device
+        size_t                      mRingChannels;              //!< channels of a ring frame, those of the device
+        std::vector<float>          mRenderFrames;              //!< block produced by the render thread
+        std::vector<float>          mReadFrames;                //!< ring frames being converted by readData()
+        ConvertFrames               mConvertFrames;             //!< converter for the device sample format
+        std::thread                 mRenderThread;              //!< thread producing the audio
+        std::atomic<bool>           mStopRender;                //!< true to end the render thread
+        std::atomic<uint32_t>       mUnderrunsCount;            //!< reads which found the ring short
+
+        double                      mRampSeconds;               //!< crossfade of live waveform updates [s]
+        std::shared_ptr<const Waveform> mPreviousWaveform;      //!< snapshot fading out
+        size_t                      mPreviousPos;               //!< frame in the snapshot fading out
+        std::shared_ptr<Generator>  mPreviousGenerator;         //!< generator fading out
+        std::vector<double>         mPreviousValues;            //!< frame produced by the generator fading out
+        size_t                      mRampFrames;                //!< length of the current crossfade [frames]
+        size_t                      mRampFramesLeft;            //!< frames left of the current crossfade
+
+        std::shared_ptr<const SwitchRequest> mPendingSwitch;    //!< snapshot published while playing, swapped atomically
+        std::shared_ptr<const SwitchRequest> mActiveSwitch;     //!< snapshot waiting for its boundary in the render thread
+        std::atomic<uint64_t>       mFramesRendered;            //!< output frames rendered since the start
+        uint64_t                    mSwitchWaitFrames;          //!< frames rendered while waiting for a boundary
+        std::atomic<bool>           mSwitchPending;             //!< true while a cued snapshot was not switched to
 };
 
 #endif // AudioSource_h
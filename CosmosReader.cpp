@@ -0,0 +1,444 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2025 Mihai Ursu                                                 //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+/*
+CosmosReader.cpp
+This file contains the sources for reading COSMOS V1/V2 strong-motion files.
+*/
+
+#include "CosmosReader.h"
+
+#include "Smc.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+
+
+//!************************************************************************
+//! Check if the data starts with a COSMOS text header
+//!
+//! @returns: true if the first line declares a COSMOS format version
+//!************************************************************************
+bool CosmosReader::canRead
+    (
+    const char*     aData,          //!< file content
+    const size_t    aLength         //!< file length
+    ) const
+{
+    const char* pos = aData;
+    std::string firstLine;
+
+    return ( getLine( pos, aData + aLength, firstLine )
+          && std::string::npos != firstLine.find( "(Format v" )
+          && std::string::npos != firstLine.find( "text lines" ) );
+}
+
+
+//!************************************************************************
+//! Get the name of the file format
+//!
+//! @returns: format name
+//!************************************************************************
+std::string CosmosReader::getFormatName() const
+{
+    return "COSMOS";
+}
+
+
+//!************************************************************************
+//! Parse a Fortran format, e.g. "(8F10.5)", "(10I8)" or "(1P5E15.7)"
+//!
+//! @returns: true if the format was recognized
+//!************************************************************************
+bool CosmosReader::parseFortranFormat
+    (
+    const std::string&  aLine,          //!< line ending with a format, e.g. "Format=(8F10.5)"
+    FortranFormat&      aFormat         //!< parsed format
+    ) const
+{
+    bool status = false;
+    const size_t openPos = aLine.rfind( '(' );
+
+    if( std::string::npos != openPos )
+    {
+        std::string format = aLine.substr( openPos + 1 );
+        std::transform( format.begin(), format.end(), format.begin(), []( unsigned char ch )
+        {
+            return static_cast<char>( std::toupper( ch ) );
+        });
+
+        // scale factor of E formats
+        const size_t scalePos = format.find( 'P' );
+
+        if( std::string::npos != scalePos )
+        {
+            format.erase( 0, scalePos + 1 );
+        }
+
+        const size_t typePos = format.find_first_of( "IFEDG" );
+
+        if( std::string::npos != typePos && typePos > 0 )
+        {
+            aFormat.valuesPerLine = std::strtoul( format.c_str(), nullptr, 10 );
+            aFormat.valueLength = std::strtoul( format.c_str() + typePos + 1, nullptr, 10 );
+
+            status = ( aFormat.valuesPerLine > 0 && aFormat.valueLength > 0 );
+        }
+    }
+
+    return status;
+}
+
+
+//!************************************************************************
+//! Parse a COSMOS V1 or V2 file into a record
+//! The text header gives the earthquake and the data type, the integer
+//! and real headers give the start time, orientation and sampling, and
+//! the first data block is the acceleration.
+//!
+//! @returns: true if a record was appended
+//!************************************************************************
+bool CosmosReader::read
+    (
+    const char*         aData,          //!< file content
+    const size_t        aLength,        //!< file length
+    std::vector<Smc>&   aRecordVec,     //!< records are appended
+    std::string&        aError          //!< error message
+    ) const
+{
+    const char* pos = aData;
+    const char* end = aData + aLength;
+
+    aError.clear();
+
+    Smc record;
+    record.mNoValueInteger = NO_VALUE_INTEGER;
+    record.mNoValueReal = NO_VALUE_REAL;
+    initializeRecord( record );
+    record.mTextDataSourceStr = getFormatName();
+
+    std::string currentLine;
+    int crtLineNr = 0;
+    bool status = true;
+
+    ///////////////////////
+    // text header
+    ///////////////////////
+    size_t textLinesCount = 0;
+
+    if( getLine( pos, end, currentLine ) )
+    {
+        crtLineNr++;
+
+        std::string dataType = currentLine.substr( 0, 25 );
+        std::transform( dataType.begin(), dataType.end(), dataType.begin(), []( unsigned char ch )
+        {
+            return static_cast<char>( std::tolower( ch ) );
+        });
+
+        if( std::string::npos == dataType.find( "accel" ) || std::string::npos != dataType.find( "spectr" ) )
+        {
+            status = false;
+            aError = "Current file is not an accelerogram in COSMOS format.";
+        }
+        else if( std::string::npos != dataType.find( "raw" ) || std::string::npos != dataType.find( "count" ) )
+        {
+            record.mTextDataTypeFile = Smc::DATA_TYPE_FILE_UNCORRECTED_ACCELEROGRAM;
+            record.mDataCalibrated = false;
+        }
+        else if( std::string::npos != dataType.find( "uncorrected" ) )
+        {
+            record.mTextDataTypeFile = Smc::DATA_TYPE_FILE_UNCORRECTED_ACCELEROGRAM;
+        }
+        else
+        {
+            record.mTextDataTypeFile = Smc::DATA_TYPE_FILE_CORRECTED_ACCELEROGRAM;
+        }
+
+        const size_t withPos = currentLine.find( "with" );
+
+        if( std::string::npos != withPos )
+        {
+            textLinesCount = std::strtoul( currentLine.c_str() + withPos + 4, nullptr, 10 );
+        }
+
+        if( status && textLinesCount < 2 )
+        {
+            status = false;
+            aError = "No valid number of text lines found in COSMOS file.";
+        }
+    }
+
+    while( status && crtLineNr < static_cast<int>( textLinesCount ) && getLine( pos, end, currentLine ) )
+    {
+        crtLineNr++;
+
+        switch( crtLineNr )
+        {
+            case 2:
+                {
+                    std::string tmpStr = currentLine.substr( 0, 40 );
+                    trim( tmpStr );
+                    record.mTextEarthquakeName = tmpStr;
+
+                    tmpStr = currentLine.size() > 40 ? currentLine.substr( 40 ) : "";
+                    trim( tmpStr );
+                    record.mEarthquakeTimeStamp = tmpStr;
+                }
+                break;
+
+            case 5:
+                trim( currentLine );
+                record.mTextStationName = currentLine;
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    ///////////////////////
+    // integer header
+    ///////////////////////
+    std::vector<double> intHeaderVec;
+    FortranFormat format;
+
+    if( status )
+    {
+        status = getLine( pos, end, currentLine ) && parseFortranFormat( currentLine, format );
+        crtLineNr++;
+
+        if( status )
+        {
+            const size_t count = std::strtoul( currentLine.c_str(), nullptr, 10 );
+            status = readValues( pos, end, count, format, intHeaderVec, crtLineNr );
+        }
+    }
+
+    ///////////////////////
+    // real header
+    ///////////////////////
+    std::vector<double> realHeaderVec;
+
+    if( status )
+    {
+        status = getLine( pos, end, currentLine ) && parseFortranFormat( currentLine, format );
+        crtLineNr++;
+
+        if( status )
+        {
+            const size_t count = std::strtoul( currentLine.c_str(), nullptr, 10 );
+            status = readValues( pos, end, count, format, realHeaderVec, crtLineNr );
+        }
+    }
+
+    ///////////////////////
+    // comments
+    ///////////////////////
+    if( status )
+    {
+        status = getLine( pos, end, currentLine );
+        crtLineNr++;
+
+        const size_t commentLinesCount = std::strtoul( currentLine.c_str(), nullptr, 10 );
+
+        for( size_t i = 0; status && i < commentLinesCount; i++ )
+        {
+            status = getLine( pos, end, currentLine );
+            crtLineNr++;
+        }
+    }
+
+    if( status )
+    {
+        status = ( intHeaderVec.size() > INT_FIELD_ORIENTATION && realHeaderVec.size() > REAL_FIELD_SAMPLING_INTERVAL );
+
+        if( !status )
+        {
+            aError = "COSMOS headers are too short.";
+        }
+    }
+
+    if( status )
+    {
+        const double samplingInterval = realHeaderVec.at( REAL_FIELD_SAMPLING_INTERVAL );
+        const double samplingRate = realHeaderVec.at( REAL_FIELD_SAMPLING_RATE );
+
+        if( record.isValidReal( samplingInterval ) && samplingInterval > 0 )
+        {
+            record.mSamplingRate = 1.0 / samplingInterval;
+        }
+        else if( record.isValidReal( samplingRate ) && samplingRate > 0 )
+        {
+            record.mSamplingRate = samplingRate;
+        }
+        else
+        {
+            status = false;
+            aError = "No data sampling rate found in COSMOS file.";
+        }
+
+        const double second = realHeaderVec.at( REAL_FIELD_SECOND );
+
+        if( record.isValidReal( second ) )
+        {
+            record.mRecordStart.year = static_cast<int16_t>( intHeaderVec.at( INT_FIELD_YEAR ) );
+            record.mRecordStart.julianDay = static_cast<int16_t>( intHeaderVec.at( INT_FIELD_JULIAN_DAY ) );
+            record.mRecordStart.hour = static_cast<int16_t>( intHeaderVec.at( INT_FIELD_HOUR ) );
+            record.mRecordStart.minute = static_cast<int16_t>( intHeaderVec.at( INT_FIELD_MINUTE ) );
+            record.mRecordStart.second = static_cast<int16_t>( std::floor( second ) );
+            record.mRecordStart.millisecond = static_cast<int16_t>( 1000 * ( second - std::floor( second ) ) );
+        }
+
+        const int16_t orientation = static_cast<int16_t>( intHeaderVec.at( INT_FIELD_ORIENTATION ) );
+
+        if( orientation >= 0 && orientation <= 360 )
+        {
+            record.mVerticalOrientation = 90;
+            record.mHorizontalOrientation = orientation;
+            record.mTextComponentOrientation = std::to_string( orientation );
+        }
+        else if( ORIENTATION_UP == orientation || ORIENTATION_DOWN == orientation )
+        {
+            record.mVerticalOrientation = ( ORIENTATION_UP == orientation ) ? 0 : 180;
+            record.mTextComponentOrientation = ( ORIENTATION_UP == orientation ) ? "Up" : "Down";
+        }
+    }
+
+    ///////////////////////
+    // data
+    ///////////////////////
+    if( status )
+    {
+        status = getLine( pos, end, currentLine ) && parseFortranFormat( currentLine, format );
+        crtLineNr++;
+
+        const size_t count = std::strtoul( currentLine.c_str(), nullptr, 10 );
+
+        std::string units;
+        const size_t unitsPos = currentLine.find( "units=" );
+
+        if( std::string::npos != unitsPos )
+        {
+            units = currentLine.substr( unitsPos + 6 );
+            units = units.substr( 0, units.find_first_of( "(, " ) );
+            std::transform( units.begin(), units.end(), units.begin(), []( unsigned char ch )
+            {
+                return static_cast<char>( std::tolower( ch ) );
+            });
+        }
+
+        double scale = 1;
+
+        if( "g" == units )
+        {
+            scale = G_TO_MS2;
+        }
+        else if( 0 == units.find( "cm/s" ) || "gal" == units )
+        {
+            scale = 1.e-2;
+        }
+        else if( 0 == units.find( "counts" ) )
+        {
+            record.mDataCalibrated = false;
+        }
+        else if( 0 != units.find( "m/s" ) )
+        {
+            status = false;
+            aError = "Unknown data units \"" + units + "\" found in COSMOS file.";
+        }
+
+        if( status && 0 == count )
+        {
+            status = false;
+            aError = "No data values specified in COSMOS file.";
+        }
+
+        if( status )
+        {
+            status = readValues( pos, end, count, format, record.mDataVector, crtLineNr );
+        }
+
+        if( status )
+        {
+            for( double& value : record.mDataVector )
+            {
+                value *= scale; // m/s2
+            }
+
+            finalizeRecord( record );
+            aRecordVec.push_back( std::move( record ) );
+        }
+    }
+
+    if( !status )
+    {
+        if( aError.size() )
+        {
+            aError += "\n";
+        }
+
+        aError += "COSMOS format is wrong at line " + std::to_string( crtLineNr ) + ".";
+    }
+
+    return status;
+}
+
+
+//!************************************************************************
+//! Read a block of values written with a Fortran format
+//!
+//! @returns: true if all values were read
+//!************************************************************************
+bool CosmosReader::readValues
+    (
+    const char*&            aPos,           //!< current position
+    const char*             aEnd,           //!< end of data
+    const size_t            aCount,         //!< number of values
+    const FortranFormat&    aFormat,        //!< line format
+    std::vector<double>&    aValueVec,      //!< read values
+    int&                    aCrtLineNr      //!< current line number
+    ) const
+{
+    bool status = true;
+    std::string currentLine;
+
+    aValueVec.clear();
+    aValueVec.reserve( aCount );
+
+    while( status && aValueVec.size() < aCount )
+    {
+        status = getLine( aPos, aEnd, currentLine );
+        aCrtLineNr++;
+
+        if( status )
+        {
+            status = parseFixedWidthValues( currentLine, aFormat.valueLength, aValueVec );
+        }
+    }
+
+    if( status )
+    {
+        // the last line may have trailing fields
+        status = ( aValueVec.size() - aCount < aFormat.valuesPerLine );
+        aValueVec.resize( aCount );
+    }
+
+    return status;
+}
@@ -0,0 +1,114 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2025 Mihai Ursu                                                 //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+/*
+CosmosReader.h
+This file contains the definitions for reading COSMOS V1/V2 strong-motion files.
+*/
+
+#ifndef CosmosReader_h
+#define CosmosReader_h
+
+#include "StrongMotionReader.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+//************************************************************************
+// Class for reading COSMOS Strong-Motion Data Format files
+// Only the first time series of a file is read, which is the
+// acceleration for both uncorrected (V1) and corrected (V2) files.
+//
+// [1] COSMOS Strong-Motion Data Format, version 1.20,
+//     Consortium of Organizations for Strong-Motion Observation Systems, 2001
+//************************************************************************
+class CosmosReader : public StrongMotionReader
+{
+    //************************************************************************
+    // constants and types
+    //************************************************************************
+    private:
+        static const int16_t NO_VALUE_INTEGER = -999;               //!< null integer header value
+        static constexpr double NO_VALUE_REAL = -999.0;            //!< null real header value
+
+        // integer header fields, zero-based
+        static const uint8_t INT_FIELD_YEAR = 39;
+        static const uint8_t INT_FIELD_JULIAN_DAY = 40;
+        static const uint8_t INT_FIELD_HOUR = 43;
+        static const uint8_t INT_FIELD_MINUTE = 44;
+        static const uint8_t INT_FIELD_ORIENTATION = 53;
+
+        // real header fields, zero-based
+        static const uint8_t REAL_FIELD_SECOND = 29;
+        static const uint8_t REAL_FIELD_SAMPLING_RATE = 33;
+        static const uint8_t REAL_FIELD_SAMPLING_INTERVAL = 61;
+
+        // orientation codes beyond azimuths
+        static const int16_t ORIENTATION_UP = 400;
+        static const int16_t ORIENTATION_DOWN = 500;
+
+        static constexpr double G_TO_MS2 = 9.80665;                //!< standard gravity [m/s2]
+
+        typedef struct
+        {
+            size_t  valuesPerLine;      //!< values on a full line
+            size_t  valueLength;        //!< width of a value
+        }FortranFormat;
+
+
+    //************************************************************************
+    // functions
+    //************************************************************************
+    public:
+        bool canRead
+            (
+            const char*     aData,          //!< file content
+            const size_t    aLength         //!< file length
+            ) const override;
+
+        std::string getFormatName() const override;
+
+        bool read
+            (
+            const char*         aData,          //!< file content
+            const size_t        aLength,        //!< file length
+            std::vector<Smc>&   aRecordVec,     //!< records are appended
+            std::string&        aError          //!< error message
+            ) const override;
+
+    private:
+        bool parseFortranFormat
+            (
+            const std::string&  aLine,          //!< line ending with a format, e.g. "Format=(8F10.5)"
+            FortranFormat&      aFormat         //!< parsed format
+            ) const;
+
+        bool readValues
+            (
+            const char*&            aPos,           //!< current position
+            const char*             aEnd,           //!< end of data
+            const size_t            aCount,         //!< number of values
+            const FortranFormat&    aFormat,        //!< line format
+            std::vector<double>&    aValueVec,      //!< read values
+            int&                    aCrtLineNr      //!< current line number
+            ) const;
+};
+
+#endif // CosmosReader_h
@@ -0,0 +1,224 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2025 Mihai Ursu                                                 //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+/*
+FourierSpectrum.cpp
+This file contains the sources for the Fourier amplitude spectrum.
+*/
+
+#include "FourierSpectrum.h"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+
+#include "RealFft.h"
+
+
+//!************************************************************************
+//! Constructor
+//!************************************************************************
+FourierSpectrum::FourierSpectrum
+    (
+    const WindowType    aWindowType,    //!< window applied before the FFT
+    const double        aBandwidth      //!< Konno-Ohmachi bandwidth, 0 for no smoothing
+    )
+    : mWindowType( aWindowType )
+    , mBandwidth( std::clamp( aBandwidth, 0.0, KONNO_OHMACHI_BANDWIDTH_MAX ) )
+{
+}
+
+
+//!************************************************************************
+//! Apply the window over the record, the zero padding is left untouched
+//!
+//! @returns: nothing
+//!************************************************************************
+void FourierSpectrum::applyWindow
+    (
+    std::vector<double>&    aDataVec,   //!< padded record
+    const size_t            aLength     //!< record length
+    ) const
+{
+    if( aLength < 2 )
+    {
+        return;
+    }
+
+    switch( mWindowType )
+    {
+        case WINDOW_HANN:
+            for( size_t i = 0; i < aLength; i++ )
+            {
+                aDataVec[i] *= 0.5 * ( 1.0 - cos( 2.0 * M_PI * i / ( aLength - 1 ) ) );
+            }
+            break;
+
+        case WINDOW_TUKEY:
+            {
+                const size_t taperLength = std::max<size_t>( 1, TUKEY_TAPER_RATIO * aLength );
+
+                for( size_t i = 0; i < taperLength && i < aLength / 2; i++ )
+                {
+                    const double w = 0.5 * ( 1.0 - cos( M_PI * i / taperLength ) );
+                    aDataVec[i] *= w;
+                    aDataVec[aLength - 1 - i] *= w;
+                }
+            }
+            break;
+
+        case WINDOW_RECTANGULAR:
+        default:
+            break;
+    }
+}
+
+
+//!************************************************************************
+//! Compute the Fourier amplitude spectrum of a record
+//!
+//! The record is windowed, zero padded to a power of 2 and transformed
+//! with a real-input FFT. Amplitudes are |X(f)| * dt.
+//! With smoothing, the spectrum is returned at log-spaced frequencies.
+//!
+//! @returns: nothing
+//!************************************************************************
+void FourierSpectrum::compute
+    (
+    const std::vector<double>&  aDataVec,       //!< record
+    const double                aSamplingRate,  //!< sampling rate [SPS]
+    std::vector<double>&        aFrequencyVec,  //!< frequencies [Hz]
+    std::vector<double>&        aAmplitudeVec   //!< amplitudes [data unit * s]
+    ) const
+{
+    aFrequencyVec.clear();
+    aAmplitudeVec.clear();
+
+    if( aSamplingRate <= 0 || aDataVec.size() < 2 )
+    {
+        return;
+    }
+
+    RealFft fft( aDataVec.size() );
+
+    std::vector<double> paddedVec( fft.getSize(), 0 );
+    std::copy( aDataVec.begin(), aDataVec.end(), paddedVec.begin() );
+    applyWindow( paddedVec, aDataVec.size() );
+
+    std::vector<std::complex<double>> spectrumVec;
+    fft.forward( paddedVec.data(), spectrumVec );
+
+    const double dt = 1.0 / aSamplingRate;
+    const double df = aSamplingRate / fft.getSize();
+
+    aFrequencyVec.resize( spectrumVec.size() );
+    aAmplitudeVec.resize( spectrumVec.size() );
+
+    for( size_t k = 0; k < spectrumVec.size(); k++ )
+    {
+        aFrequencyVec[k] = k * df;
+        aAmplitudeVec[k] = dt * std::abs( spectrumVec[k] );
+    }
+
+    if( mBandwidth > 0 )
+    {
+        smoothKonnoOhmachi( aFrequencyVec, aAmplitudeVec );
+    }
+}
+
+
+//!************************************************************************
+//! Smooth the spectrum with the Konno-Ohmachi window
+//!
+//! W(f, fc) = [ sin( b * log10( f / fc ) ) / ( b * log10( f / fc ) ) ]^4
+//!
+//! The smoothed spectrum is evaluated at log-spaced center frequencies,
+//! between the first nonzero FFT frequency and the Nyquist frequency.
+//! The window is truncated after a few lobes, so for each center frequency
+//! only the FFT bins within a fixed frequency ratio are summed.
+//!
+//! References:
+//! [1] Konno, K., Ohmachi, T. - Ground-Motion Characteristics Estimated from
+//!                              Spectral Ratio between Horizontal and Vertical
+//!                              Components of Microtremor,
+//!                              Bull. Seism. Soc. Am. 88 (1), 1998, pp. 228-241
+//!
+//! @returns: nothing
+//!************************************************************************
+void FourierSpectrum::smoothKonnoOhmachi
+    (
+    std::vector<double>&        aFrequencyVec,  //!< FFT frequencies, replaced by center frequencies [Hz]
+    std::vector<double>&        aAmplitudeVec   //!< amplitudes, replaced by smoothed amplitudes
+    ) const
+{
+    const size_t count = aFrequencyVec.size();
+
+    if( count < 3 )
+    {
+        return;
+    }
+
+    const double df = aFrequencyVec[1] - aFrequencyVec[0];
+    const double fMin = aFrequencyVec[1];
+    const double fMax = aFrequencyVec[count - 1];
+    const double ratioSpan = std::pow( 10.0, KONNO_OHMACHI_LOBES * M_PI / mBandwidth );
+
+    std::vector<double> logFrequencyVec( count, 0 );
+
+    for( size_t k = 1; k < count; k++ )
+    {
+        logFrequencyVec[k] = std::log10( aFrequencyVec[k] );
+    }
+
+    std::vector<double> centerVec( SMOOTHED_POINTS_COUNT );
+    std::vector<double> smoothedVec( SMOOTHED_POINTS_COUNT );
+
+    const double logStep = std::log10( fMax / fMin ) / ( SMOOTHED_POINTS_COUNT - 1 );
+
+    for( uint16_t c = 0; c < SMOOTHED_POINTS_COUNT; c++ )
+    {
+        const double logFc = std::log10( fMin ) + c * logStep;
+        const double fc = std::pow( 10.0, logFc );
+
+        const size_t kFirst = std::max<size_t>( 1, static_cast<size_t>( std::ceil( fc / ratioSpan / df ) ) );
+        const size_t kLast = std::min<size_t>( count - 1, static_cast<size_t>( std::floor( fc * ratioSpan / df ) ) );
+
+        double sumW = 0;
+        double sumWA = 0;
+
+        for( size_t k = kFirst; k <= kLast; k++ )
+        {
+            const double x = mBandwidth * ( logFrequencyVec[k] - logFc );
+            double w = 1;
+
+            if( std::fabs( x ) > 1.e-9 )
+            {
+                const double sinc = std::sin( x ) / x;
+                w = sinc * sinc * sinc * sinc;
+            }
+
+            sumW += w;
+            sumWA += w * aAmplitudeVec[k];
+        }
+
+        centerVec[c] = fc;
+        smoothedVec[c] = sumW > 0 ? sumWA / sumW : 0;
+    }
+
+    aFrequencyVec.swap( centerVec );
+    aAmplitudeVec.swap( smoothedVec );
+}
@@ -0,0 +1,97 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2025 Mihai Ursu                                                 //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+/*
+FourierSpectrum.h
+This file contains the definitions for the Fourier amplitude spectrum.
+*/
+
+#ifndef FourierSpectrum_h
+#define FourierSpectrum_h
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+//************************************************************************
+// Class for computing Fourier amplitude spectra of records
+//************************************************************************
+class FourierSpectrum
+{
+    //************************************************************************
+    // constants and types
+    //************************************************************************
+    public:
+        typedef enum : uint8_t
+        {
+            WINDOW_RECTANGULAR,
+            WINDOW_HANN,
+            WINDOW_TUKEY
+        }WindowType;
+
+        static constexpr double TUKEY_TAPER_RATIO = 0.05;           //!< tapered fraction at each end
+
+        static constexpr double KONNO_OHMACHI_BANDWIDTH = 40;       //!< usual smoothing bandwidth
+        static constexpr double KONNO_OHMACHI_BANDWIDTH_MAX = 200;  //!< maximum smoothing bandwidth
+
+    private:
+        static const uint8_t KONNO_OHMACHI_LOBES = 3;               //!< smoothing window truncated after 3 lobes
+        static const uint16_t SMOOTHED_POINTS_COUNT = 500;          //!< log-spaced frequencies of the smoothed spectrum
+
+
+    //************************************************************************
+    // functions
+    //************************************************************************
+    public:
+        FourierSpectrum
+            (
+            const WindowType    aWindowType,    //!< window applied before the FFT
+            const double        aBandwidth      //!< Konno-Ohmachi bandwidth, 0 for no smoothing
+            );
+
+        void compute
+            (
+            const std::vector<double>&  aDataVec,       //!< record
+            const double                aSamplingRate,  //!< sampling rate [SPS]
+            std::vector<double>&        aFrequencyVec,  //!< frequencies [Hz]
+            std::vector<double>&        aAmplitudeVec   //!< amplitudes [data unit * s]
+            ) const;
+
+    private:
+        void applyWindow
+            (
+            std::vector<double>&    aDataVec,   //!< padded record
+            const size_t            aLength     //!< record length
+            ) const;
+
+        void smoothKonnoOhmachi
+            (
+            std::vector<double>&        aFrequencyVec,  //!< FFT frequencies, replaced by center frequencies [Hz]
+            std::vector<double>&        aAmplitudeVec   //!< amplitudes, replaced by smoothed amplitudes
+            ) const;
+
+
+    //************************************************************************
+    // variables
+    //************************************************************************
+    private:
+        WindowType      mWindowType;    //!< window applied before the FFT
+        double          mBandwidth;     //!< Konno-Ohmachi bandwidth, 0 for no smoothing
+};
+
+#endif // FourierSpectrum_h
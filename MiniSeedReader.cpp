@@ -0,0 +1,663 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2025 Mihai Ursu                                                 //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+/*
+MiniSeedReader.cpp
+This file contains the sources for reading miniSEED waveform files.
+*/
+
+#include "MiniSeedReader.h"
+
+#include "Smc.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <map>
+
+
+// Steim-1: 1 = four 8-bit, 2 = two 16-bit, 3 = one 32-bit differences
+const MiniSeedReader::SteimPacking MiniSeedReader::STEIM1_PACKING[4] =
+{
+    { 0, 0 }, { 4, 8 }, { 2, 16 }, { 1, 32 }
+};
+
+// Steim-2, indexed by 4 * code + dnib
+// code 1: four 8-bit differences, no dnib
+// code 2: dnib 1 = one 30-bit, 2 = two 15-bit, 3 = three 10-bit differences
+// code 3: dnib 0 = five 6-bit, 1 = six 5-bit, 2 = seven 4-bit differences
+const MiniSeedReader::SteimPacking MiniSeedReader::STEIM2_PACKING[16] =
+{
+    { 0, 0 }, { 0, 0 },  { 0, 0 },  { 0, 0 },
+    { 4, 8 }, { 4, 8 },  { 4, 8 },  { 4, 8 },
+    { 0, 0 }, { 1, 30 }, { 2, 15 }, { 3, 10 },
+    { 5, 6 }, { 6, 5 },  { 7, 4 },  { 0, 0 }
+};
+
+
+//!************************************************************************
+//! Check if the data starts with a miniSEED record
+//!
+//! @returns: true if the fixed header has a valid sequence and quality
+//!************************************************************************
+bool MiniSeedReader::canRead
+    (
+    const char*     aData,          //!< file content
+    const size_t    aLength         //!< file length
+    ) const
+{
+    return ( aLength >= FIXED_HEADER_LENGTH
+          && isRecordStart( reinterpret_cast<const uint8_t*>( aData ) ) );
+}
+
+
+//!************************************************************************
+//! Decode the samples of a data record
+//!
+//! @returns: true if all samples were decoded
+//!************************************************************************
+bool MiniSeedReader::decodeData
+    (
+    const uint8_t*          aData,          //!< data of the record
+    const size_t            aLength,        //!< data length
+    const RecordHeader&     aHeader,        //!< record header
+    std::vector<double>&    aSampleVec,     //!< decoded samples
+    std::string&            aError          //!< error message
+    ) const
+{
+    bool status = true;
+    const size_t count = aHeader.samplesCount;
+    const bool bigEndian = aHeader.dataBigEndian;
+
+    aSampleVec.resize( count );
+
+    switch( aHeader.encoding )
+    {
+        case ENCODING_INT16:
+            status = ( aLength >= 2 * count );
+
+            for( size_t i = 0; status && i < count; i++ )
+            {
+                aSampleVec[i] = static_cast<int16_t>( readUint16( aData + 2 * i, bigEndian ) );
+            }
+            break;
+
+        case ENCODING_INT32:
+            status = ( aLength >= 4 * count );
+
+            for( size_t i = 0; status && i < count; i++ )
+            {
+                aSampleVec[i] = static_cast<int32_t>( readUint32( aData + 4 * i, bigEndian ) );
+            }
+            break;
+
+        case ENCODING_FLOAT32:
+            status = ( aLength >= 4 * count );
+
+            for( size_t i = 0; status && i < count; i++ )
+            {
+                const uint32_t word = readUint32( aData + 4 * i, bigEndian );
+                float value = 0;
+                memcpy( &value, &word, sizeof( value ) );
+                aSampleVec[i] = value;
+            }
+            break;
+
+        case ENCODING_FLOAT64:
+            status = ( aLength >= 8 * count );
+
+            for( size_t i = 0; status && i < count; i++ )
+            {
+                const uint64_t word = readUint64( aData + 8 * i, bigEndian );
+                double value = 0;
+                memcpy( &value, &word, sizeof( value ) );
+                aSampleVec[i] = value;
+            }
+            break;
+
+        case ENCODING_STEIM1:
+        case ENCODING_STEIM2:
+            {
+                std::vector<int32_t> intSampleVec;
+                status = decodeSteim( aData, aLength, bigEndian, ENCODING_STEIM2 == aHeader.encoding, count, intSampleVec, aError );
+
+                if( status )
+                {
+                    std::copy( intSampleVec.begin(), intSampleVec.end(), aSampleVec.begin() );
+                }
+            }
+            break;
+
+        default:
+            status = false;
+            aError = "Unsupported miniSEED data encoding " + std::to_string( aHeader.encoding ) + ".";
+            break;
+    }
+
+    if( !status && aError.empty() )
+    {
+        aError = "miniSEED data record is too short.";
+    }
+
+    return status;
+}
+
+
+//!************************************************************************
+//! Decode Steim-1 or Steim-2 compressed samples
+//! The differences of all frames are first unpacked with the packing
+//! tables into a flat array, then integrated with a running sum starting
+//! at the forward integration constant. The last sample must match the
+//! reverse integration constant.
+//!
+//! @returns: true if all samples were decoded
+//!************************************************************************
+bool MiniSeedReader::decodeSteim
+    (
+    const uint8_t*          aData,          //!< Steim frames
+    const size_t            aLength,        //!< frames length
+    const bool              aBigEndian,     //!< true if the words are big endian
+    const bool              aSteim2,        //!< true for Steim-2, false for Steim-1
+    const size_t            aSamplesCount,  //!< number of samples
+    std::vector<int32_t>&   aSampleVec,     //!< decoded samples
+    std::string&            aError          //!< error message
+    ) const
+{
+    const size_t FRAME_LENGTH = 4 * STEIM_FRAME_WORDS;
+    const size_t framesCount = aLength / FRAME_LENGTH;
+
+    // room for a whole word after the last needed difference
+    std::vector<int32_t> differenceVec( aSamplesCount + STEIM_DIFFERENCES_MAX );
+    size_t differencesCount = 0;
+
+    int32_t forwardConstant = 0;
+    int32_t reverseConstant = 0;
+    bool status = ( framesCount > 0 );
+
+    for( size_t frame = 0; status && frame < framesCount && differencesCount < aSamplesCount; frame++ )
+    {
+        const uint8_t* frameData = aData + frame * FRAME_LENGTH;
+        const uint32_t codes = readUint32( frameData, aBigEndian );
+
+        for( uint8_t word = 1; status && word < STEIM_FRAME_WORDS && differencesCount < aSamplesCount; word++ )
+        {
+            const uint32_t dataWord = readUint32( frameData + 4 * word, aBigEndian );
+            const uint8_t code = ( codes >> ( 30 - 2 * word ) ) & 0x03;
+
+            if( 0 == frame && 1 == word )
+            {
+                forwardConstant = static_cast<int32_t>( dataWord );
+            }
+            else if( 0 == frame && 2 == word )
+            {
+                reverseConstant = static_cast<int32_t>( dataWord );
+            }
+            else if( code )
+            {
+                const SteimPacking packing = aSteim2 ? STEIM2_PACKING[4 * code + ( dataWord >> 30 )] : STEIM1_PACKING[code];
+                int32_t* differences = differenceVec.data() + differencesCount;
+
+                switch( packing.bits )
+                {
+                    case 4:     unpackDifferences<7, 4>( dataWord, differences );   break;
+                    case 5:     unpackDifferences<6, 5>( dataWord, differences );   break;
+                    case 6:     unpackDifferences<5, 6>( dataWord, differences );   break;
+                    case 8:     unpackDifferences<4, 8>( dataWord, differences );   break;
+                    case 10:    unpackDifferences<3, 10>( dataWord, differences );  break;
+                    case 15:    unpackDifferences<2, 15>( dataWord, differences );  break;
+                    case 16:    unpackDifferences<2, 16>( dataWord, differences );  break;
+                    case 30:    unpackDifferences<1, 30>( dataWord, differences );  break;
+                    case 32:    unpackDifferences<1, 32>( dataWord, differences );  break;
+
+                    default:
+                        status = false;
+                        aError = "Invalid Steim difference code found in miniSEED record.";
+                        break;
+                }
+
+                differencesCount += packing.count;
+            }
+        }
+    }
+
+    if( status && differencesCount < aSamplesCount )
+    {
+        status = false;
+        aError = "Steim data ends after " + std::to_string( differencesCount )
+                + " of " + std::to_string( aSamplesCount ) + " samples.";
+    }
+
+    if( status )
+    {
+        // the first difference refers to the previous record and is skipped;
+        // the running sum wraps like the 32-bit encoder
+        aSampleVec.resize( aSamplesCount );
+        uint32_t sample = static_cast<uint32_t>( forwardConstant );
+        aSampleVec[0] = forwardConstant;
+
+        for( size_t i = 1; i < aSamplesCount; i++ )
+        {
+            sample += static_cast<uint32_t>( differenceVec[i] );
+            aSampleVec[i] = static_cast<int32_t>( sample );
+        }
+
+        status = ( aSampleVec.back() == reverseConstant );
+
+        if( !status )
+        {
+            aError = "Steim integrity check failed: last sample is " + std::to_string( aSampleVec.back() )
+                    + ", expected " + std::to_string( reverseConstant ) + ".";
+        }
+    }
+
+    return status;
+}
+
+
+//!************************************************************************
+//! Get the name of the file format
+//!
+//! @returns: format name
+//!************************************************************************
+std::string MiniSeedReader::getFormatName() const
+{
+    return "miniSEED";
+}
+
+
+//!************************************************************************
+//! Check if a fixed header starts at the given data
+//! The sequence number has digits or spaces, followed by a quality
+//! indicator and a reserved byte.
+//!
+//! @returns: true if a record starts here
+//!************************************************************************
+bool MiniSeedReader::isRecordStart
+    (
+    const uint8_t*  aData           //!< record data, at least the fixed header
+    ) const
+{
+    bool status = ( nullptr != strchr( "DRQM", aData[6] ) && 0 != aData[6] )
+               && ( ' ' == aData[7] || 0 == aData[7] );
+
+    for( uint8_t i = 0; status && i < 6; i++ )
+    {
+        status = ( ( aData[i] >= '0' && aData[i] <= '9' ) || ' ' == aData[i] );
+    }
+
+    return status;
+}
+
+
+//!************************************************************************
+//! Parse the fixed header and the blockettes of a data record
+//! The header byte order is detected from the year, which must be
+//! plausible in one of the two orders.
+//!
+//! @returns: true if the header is valid
+//!************************************************************************
+bool MiniSeedReader::parseHeader
+    (
+    const uint8_t*  aData,          //!< record data
+    const size_t    aLength,        //!< length available from the record start
+    RecordHeader&   aHeader,        //!< parsed header
+    std::string&    aError          //!< error message
+    ) const
+{
+    const uint16_t YEAR_MIN = 1900;
+    const uint16_t YEAR_MAX = 2100;
+
+    bool headerBigEndian = true;
+    uint16_t year = readUint16( aData + 20, headerBigEndian );
+
+    if( year < YEAR_MIN || year > YEAR_MAX )
+    {
+        headerBigEndian = false;
+        year = readUint16( aData + 20, headerBigEndian );
+    }
+
+    bool status = ( year >= YEAR_MIN && year <= YEAR_MAX );
+
+    if( !status )
+    {
+        aError = "Invalid record start time found in miniSEED file.";
+    }
+    else
+    {
+        auto getCode = [&]( const size_t aOffset, const size_t aCount )
+        {
+            std::string code( reinterpret_cast<const char*>( aData + aOffset ), aCount );
+            code.erase( std::find_if( code.rbegin(), code.rend(), []( char ch )
+            {
+                return ' ' != ch && 0 != ch;
+            } ).base(), code.end() );
+            return code;
+        };
+
+        aHeader.station = getCode( 8, 5 );
+        aHeader.location = getCode( 13, 2 );
+        aHeader.channel = getCode( 15, 3 );
+        aHeader.network = getCode( 18, 2 );
+        aHeader.channelId = aHeader.network + "." + aHeader.station + "." + aHeader.location + "." + aHeader.channel;
+
+        aHeader.year = year;
+        aHeader.julianDay = readUint16( aData + 22, headerBigEndian );
+        aHeader.hour = aData[24];
+        aHeader.minute = aData[25];
+        aHeader.second = aData[26];
+        aHeader.tenthMillisecond = readUint16( aData + 28, headerBigEndian );
+
+        aHeader.samplesCount = readUint16( aData + 30, headerBigEndian );
+
+        const int16_t rateFactor = static_cast<int16_t>( readUint16( aData + 32, headerBigEndian ) );
+        const int16_t rateMultiplier = static_cast<int16_t>( readUint16( aData + 34, headerBigEndian ) );
+
+        aHeader.samplingRate = 0;
+
+        if( rateFactor > 0 && rateMultiplier > 0 )
+        {
+            aHeader.samplingRate = static_cast<double>( rateFactor ) * rateMultiplier;
+        }
+        else if( rateFactor > 0 && rateMultiplier < 0 )
+        {
+            aHeader.samplingRate = -static_cast<double>( rateFactor ) / rateMultiplier;
+        }
+        else if( rateFactor < 0 && rateMultiplier > 0 )
+        {
+            aHeader.samplingRate = -static_cast<double>( rateMultiplier ) / rateFactor;
+        }
+        else if( rateFactor < 0 && rateMultiplier < 0 )
+        {
+            aHeader.samplingRate = 1.0 / ( static_cast<double>( rateFactor ) * rateMultiplier );
+        }
+
+        const uint8_t activityFlags = aData[36];
+        const uint8_t blockettesCount = aData[39];
+        const int32_t timeCorrection = static_cast<int32_t>( readUint32( aData + 40, headerBigEndian ) );
+        aHeader.dataOffset = readUint16( aData + 44, headerBigEndian );
+
+        // time of the first sample
+        const int64_t y = aHeader.year - 1;
+        const int64_t daysBeforeYear = 365 * y + y / 4 - y / 100 + y / 400;
+
+        aHeader.startSeconds = 86400.0 * ( daysBeforeYear + aHeader.julianDay - 1 );
+        aHeader.startSeconds += 3600.0 * aHeader.hour + 60.0 * aHeader.minute + aHeader.second;
+        aHeader.startSeconds += 1.e-4 * aHeader.tenthMillisecond;
+
+        // correction not yet applied to the start time
+        if( 0 == ( activityFlags & 0x02 ) )
+        {
+            aHeader.startSeconds += 1.e-4 * timeCorrection;
+        }
+
+        // blockettes
+        bool dataOnlyFound = false;
+        uint16_t blocketteOffset = readUint16( aData + 46, headerBigEndian );
+
+        for( uint8_t i = 0; i < blockettesCount && blocketteOffset >= FIXED_HEADER_LENGTH && blocketteOffset + 8u <= aLength; i++ )
+        {
+            const uint8_t* blockette = aData + blocketteOffset;
+            const uint16_t blocketteType = readUint16( blockette, headerBigEndian );
+
+            if( BLOCKETTE_DATA_ONLY == blocketteType )
+            {
+                dataOnlyFound = true;
+                aHeader.encoding = blockette[4];
+                aHeader.dataBigEndian = ( 0 != blockette[5] );
+
+                const uint8_t exponent = blockette[6];
+
+                if( exponent < RECORD_LENGTH_EXPONENT_MIN || exponent > RECORD_LENGTH_EXPONENT_MAX )
+                {
+                    status = false;
+                    aError = "Invalid miniSEED record length.";
+                }
+                else
+                {
+                    aHeader.recordLength = static_cast<size_t>( 1 ) << exponent;
+                }
+            }
+            else if( BLOCKETTE_SAMPLE_RATE == blocketteType )
+            {
+                const uint32_t word = readUint32( blockette + 4, headerBigEndian );
+                float actualRate = 0;
+                memcpy( &actualRate, &word, sizeof( actualRate ) );
+
+                if( actualRate > 0 )
+                {
+                    aHeader.samplingRate = actualRate;
+                }
+            }
+
+            const uint16_t nextOffset = readUint16( blockette + 2, headerBigEndian );
+
+            // blockettes follow each other, which also stops loops
+            blocketteOffset = ( nextOffset > blocketteOffset ) ? nextOffset : 0;
+        }
+
+        if( status && !dataOnlyFound )
+        {
+            status = false;
+            aError = "miniSEED record without blockette 1000 is not supported.";
+        }
+
+        if( status && aHeader.recordLength > aLength )
+        {
+            status = false;
+            aError = "miniSEED file ends inside a record.";
+        }
+
+        if( status && aHeader.samplesCount
+         && ( aHeader.dataOffset < FIXED_HEADER_LENGTH || aHeader.dataOffset >= aHeader.recordLength ) )
+        {
+            status = false;
+            aError = "Invalid miniSEED data offset.";
+        }
+    }
+
+    return status;
+}
+
+
+//!************************************************************************
+//! Parse a miniSEED file into one record for each channel
+//! Consecutive data records of a channel are joined. Gaps are filled with
+//! zeros and overlapping samples are dropped, so that the sample index
+//! stays aligned with time.
+//!
+//! @returns: true if at least one record was appended
+//!************************************************************************
+bool MiniSeedReader::read
+    (
+    const char*         aData,          //!< file content
+    const size_t        aLength,        //!< file length
+    std::vector<Smc>&   aRecordVec,     //!< records are appended
+    std::string&        aError          //!< error message
+    ) const
+{
+    const uint8_t* data = reinterpret_cast<const uint8_t*>( aData );
+
+    std::vector<Smc> channelVec;
+    std::vector<double> channelStartVec;
+    std::map<std::string, size_t> channelIndexMap;
+
+    std::vector<double> sampleVec;
+    RecordHeader header;
+    size_t pos = 0;
+    bool status = true;
+
+    aError.clear();
+
+    while( status && pos + FIXED_HEADER_LENGTH <= aLength )
+    {
+        header = RecordHeader();
+        status = isRecordStart( data + pos ) && parseHeader( data + pos, aLength - pos, header, aError );
+
+        if( status && header.samplesCount && header.samplingRate > 0 )
+        {
+            status = decodeData( data + pos + header.dataOffset, header.recordLength - header.dataOffset, header, sampleVec, aError );
+        }
+
+        if( status && header.samplesCount && header.samplingRate > 0 )
+        {
+            auto channelIt = channelIndexMap.find( header.channelId );
+
+            if( channelIndexMap.end() == channelIt )
+            {
+                Smc record;
+                initializeRecord( record );
+                record.mTextDataTypeFile = Smc::DATA_TYPE_FILE_UNCORRECTED_ACCELEROGRAM;
+                record.mSmcTypeAccelerogram = ( header.channel.size() > 1 && 'N' == header.channel.at( 1 ) );
+                record.mDataCalibrated = false;
+                record.mTextDataSourceStr = getFormatName();
+                record.mTextStationCodeStr = header.network + "." + header.station;
+                record.mTextStationName = header.station;
+                record.mTextComponentOrientation = header.location.empty() ? header.channel : header.location + "." + header.channel;
+                record.mSamplingRate = header.samplingRate;
+
+                // the record start keeps milliseconds only
+                record.mRecordStart.year = header.year;
+                record.mRecordStart.julianDay = header.julianDay;
+                record.mRecordStart.hour = header.hour;
+                record.mRecordStart.minute = header.minute;
+                record.mRecordStart.second = header.second;
+                record.mRecordStart.millisecond = header.tenthMillisecond / 10;
+
+                channelIt = channelIndexMap.insert( std::make_pair( header.channelId, channelVec.size() ) ).first;
+                channelVec.push_back( std::move( record ) );
+                channelStartVec.push_back( header.startSeconds );
+            }
+
+            Smc& record = channelVec.at( channelIt->second );
+            const double channelStart = channelStartVec.at( channelIt->second );
+
+            if( std::fabs( header.samplingRate - record.mSamplingRate ) > 1.e-6 * record.mSamplingRate )
+            {
+                status = false;
+                aError = "Sampling rate changes in miniSEED channel " + header.channelId + ".";
+            }
+            else
+            {
+                const double expectedStart = channelStart + record.mDataVector.size() / record.mSamplingRate;
+                const int64_t gapSamples = std::llround( ( header.startSeconds - expectedStart ) * record.mSamplingRate );
+                size_t skippedSamples = 0;
+
+                if( gapSamples > GAP_SAMPLES_MAX )
+                {
+                    status = false;
+                    aError = "Too long gap found in miniSEED channel " + header.channelId + ".";
+                }
+                else if( gapSamples > 0 )
+                {
+                    record.mDataVector.resize( record.mDataVector.size() + gapSamples, 0 );
+                }
+                else
+                {
+                    skippedSamples = std::min( static_cast<size_t>( -gapSamples ), sampleVec.size() );
+                }
+
+                record.mDataVector.insert( record.mDataVector.end(), sampleVec.begin() + skippedSamples, sampleVec.end() );
+            }
+        }
+
+        if( status )
+        {
+            pos += header.recordLength;
+        }
+        else if( aError.empty() )
+        {
+            aError = "No miniSEED record found at byte " + std::to_string( pos ) + ".";
+        }
+    }
+
+    if( status && channelVec.empty() )
+    {
+        status = false;
+        aError = "No data samples found in miniSEED file.";
+    }
+
+    if( status )
+    {
+        for( Smc& record : channelVec )
+        {
+            finalizeRecord( record );
+            aRecordVec.push_back( std::move( record ) );
+        }
+    }
+
+    return status;
+}
+
+
+//!************************************************************************
+//! Read an unsigned 16-bit value
+//!
+//! @returns: value
+//!************************************************************************
+uint16_t MiniSeedReader::readUint16
+    (
+    const uint8_t*  aData,          //!< first byte
+    const bool      aBigEndian      //!< true if big endian
+    )
+{
+    return aBigEndian ? static_cast<uint16_t>( ( aData[0] << 8 ) | aData[1] )
+                      : static_cast<uint16_t>( ( aData[1] << 8 ) | aData[0] );
+}
+
+
+//!************************************************************************
+//! Read an unsigned 32-bit value
+//!
+//! @returns: value
+//!************************************************************************
+uint32_t MiniSeedReader::readUint32
+    (
+    const uint8_t*  aData,          //!< first byte
+    const bool      aBigEndian      //!< true if big endian
+    )
+{
+    uint32_t value = 0;
+
+    for( uint8_t i = 0; i < 4; i++ )
+    {
+        value = ( value << 8 ) | aData[aBigEndian ? i : 3 - i];
+    }
+
+    return value;
+}
+
+
+//!************************************************************************
+//! Read an unsigned 64-bit value
+//!
+//! @returns: value
+//!************************************************************************
+uint64_t MiniSeedReader::readUint64
+    (
+    const uint8_t*  aData,          //!< first byte
+    const bool      aBigEndian      //!< true if big endian
+    )
+{
+    uint64_t value = 0;
+
+    for( uint8_t i = 0; i < 8; i++ )
+    {
+        value = ( value << 8 ) | aData[aBigEndian ? i : 7 - i];
+    }
+
+    return value;
+}
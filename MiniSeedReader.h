@@ -0,0 +1,200 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2025 Mihai Ursu                                                 //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+/*
+MiniSeedReader.h
+This file contains the definitions for reading miniSEED waveform files.
+*/
+
+#ifndef MiniSeedReader_h
+#define MiniSeedReader_h
+
+#include "StrongMotionReader.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+//************************************************************************
+// Class for reading miniSEED (SEED 2.4 data-only) files
+// Records are grouped by network, station, location and channel, and
+// each channel becomes one record with the raw counts.
+//
+// [1] SEED Reference Manual, version 2.4,
+//     Incorporated Research Institutions for Seismology, 2012
+//************************************************************************
+class MiniSeedReader : public StrongMotionReader
+{
+    //************************************************************************
+    // constants and types
+    //************************************************************************
+    private:
+        static const uint8_t FIXED_HEADER_LENGTH = 48;
+
+        static const uint16_t BLOCKETTE_DATA_ONLY = 1000;
+        static const uint16_t BLOCKETTE_SAMPLE_RATE = 100;
+
+        static const uint8_t RECORD_LENGTH_EXPONENT_MIN = 7;
+        static const uint8_t RECORD_LENGTH_EXPONENT_MAX = 20;
+
+        static const uint8_t STEIM_FRAME_WORDS = 16;
+        static const uint8_t STEIM_DIFFERENCES_MAX = 7;        //!< most differences in a word
+
+        static const uint32_t GAP_SAMPLES_MAX = 100000000;     //!< longest gap filled with zeros
+
+        typedef enum : uint8_t
+        {
+            ENCODING_INT16 = 1,
+            ENCODING_INT32 = 3,
+            ENCODING_FLOAT32 = 4,
+            ENCODING_FLOAT64 = 5,
+            ENCODING_STEIM1 = 10,
+            ENCODING_STEIM2 = 11
+        }Encoding;
+
+        // differences packed in a Steim data word
+        typedef struct
+        {
+            uint8_t     count;          //!< number of differences
+            uint8_t     bits;           //!< bits for each difference
+        }SteimPacking;
+
+        // header of a data record
+        typedef struct
+        {
+            std::string     channelId;          //!< network.station.location.channel
+            std::string     network;            //!< network code
+            std::string     station;            //!< station code
+            std::string     location;           //!< location code
+            std::string     channel;            //!< channel code
+            uint16_t        year;               //!< year of the first sample
+            uint16_t        julianDay;          //!< day of year of the first sample
+            uint8_t         hour;               //!< hour of the first sample
+            uint8_t         minute;             //!< minute of the first sample
+            uint8_t         second;             //!< second of the first sample
+            uint16_t        tenthMillisecond;   //!< 0.0001 s of the first sample
+            double          startSeconds;       //!< time of the first sample, time correction included [s]
+            uint16_t        samplesCount;       //!< number of samples
+            double          samplingRate;       //!< sampling rate [SPS]
+            uint16_t        dataOffset;         //!< offset of the data from the record start
+            uint8_t         encoding;           //!< data encoding
+            bool            dataBigEndian;      //!< true if the data words are big endian
+            size_t          recordLength;       //!< record length in bytes
+        }RecordHeader;
+
+        static const SteimPacking STEIM1_PACKING[4];    //!< packing for each Steim-1 code
+        static const SteimPacking STEIM2_PACKING[16];   //!< packing for each Steim-2 code and dnib
+
+
+    //************************************************************************
+    // functions
+    //************************************************************************
+    public:
+        bool canRead
+            (
+            const char*     aData,          //!< file content
+            const size_t    aLength         //!< file length
+            ) const override;
+
+        std::string getFormatName() const override;
+
+        bool read
+            (
+            const char*         aData,          //!< file content
+            const size_t        aLength,        //!< file length
+            std::vector<Smc>&   aRecordVec,     //!< records are appended
+            std::string&        aError          //!< error message
+            ) const override;
+
+    private:
+        bool decodeData
+            (
+            const uint8_t*          aData,          //!< data of the record
+            const size_t            aLength,        //!< data length
+            const RecordHeader&     aHeader,        //!< record header
+            std::vector<double>&    aSampleVec,     //!< decoded samples
+            std::string&            aError          //!< error message
+            ) const;
+
+        bool decodeSteim
+            (
+            const uint8_t*          aData,          //!< Steim frames
+            const size_t            aLength,        //!< frames length
+            const bool              aBigEndian,     //!< true if the words are big endian
+            const bool              aSteim2,        //!< true for Steim-2, false for Steim-1
+            const size_t            aSamplesCount,  //!< number of samples
+            std::vector<int32_t>&   aSampleVec,     //!< decoded samples
+            std::string&            aError          //!< error message
+            ) const;
+
+        bool isRecordStart
+            (
+            const uint8_t*  aData           //!< record data, at least the fixed header
+            ) const;
+
+        bool parseHeader
+            (
+            const uint8_t*  aData,          //!< record data
+            const size_t    aLength,        //!< length available from the record start
+            RecordHeader&   aHeader,        //!< parsed header
+            std::string&    aError          //!< error message
+            ) const;
+
+        static uint16_t readUint16
+            (
+            const uint8_t*  aData,          //!< first byte
+            const bool      aBigEndian      //!< true if big endian
+            );
+
+        static uint32_t readUint32
+            (
+            const uint8_t*  aData,          //!< first byte
+            const bool      aBigEndian      //!< true if big endian
+            );
+
+        static uint64_t readUint64
+            (
+            const uint8_t*  aData,          //!< first byte
+            const bool      aBigEndian      //!< true if big endian
+            );
+
+        //!************************************************************************
+        //! Unpack the differences of a Steim data word
+        //! The count and width are compile-time constants, so that each packing
+        //! becomes a fixed sequence of shifts without branches.
+        //!
+        //! @returns: nothing
+        //!************************************************************************
+        template<uint8_t COUNT, uint8_t BITS>
+        static void unpackDifferences
+            (
+            const uint32_t  aWord,          //!< data word
+            int32_t*        aDifferences    //!< unpacked differences
+            )
+        {
+            for( uint8_t i = 0; i < COUNT; i++ )
+            {
+                // move the difference to the top bits, then sign-extend it
+                const uint32_t shiftedWord = aWord << ( 32 - BITS * ( COUNT - i ) );
+                aDifferences[i] = static_cast<int32_t>( shiftedWord ) >> ( 32 - BITS );
+            }
+        }
+};
+
+#endif // MiniSeedReader_h
@@ -261,44 +261,59 @@ void NoisePwrSpectrum::filterData
     std::vector<double>&        aOutSignal       //!< output signal
     ) const
 {
-    size_t nrPoints = aInSignal.size();
-    
-    if( nrPoints )
+    std::vector<double> delayLine;
+
+    for( size_t i = 0; i < aInSignal.size(); i++ )
     {
-        std::vector<double> coeffVec( 1 + mFilter.N );
-        
-        for( size_t i = 0; i < nrPoints; i++ )
-        {
-            if( 0 == i % 512 )
-            {
-                std::fill( coeffVec.begin(), coeffVec.end(), 0 );
-            }
-
-            int j = 0;
-            
-            for( j = mFilter.N; j >= 1; j-- )
-            {
-                coeffVec[j] = coeffVec[j - 1];
-            }
-
-            coeffVec[0] = aInSignal[i];
-
-            for( j = 1; j <= mFilter.N; j++ )
-            {
-                coeffVec[0] -= mFilter.a[j] * coeffVec[j];
-            }
-
-            aOutSignal[i] = 0;
-    
-            for( j = 0; j <= mFilter.N; j++ )
-            {
-                aOutSignal[i] += mFilter.b[j] * coeffVec[j];
-            }
-        }
+        aOutSignal[i] = filterSample( aInSignal[i], i, delayLine );
     }
 }
 
 
+//!************************************************************************
+//! Filter one sample of a stream
+//! The filter state is kept by the caller, so that a stream of any length
+//! can be filtered block by block with the same result as filterData().
+//!
+//! @returns: the filtered sample
+//!************************************************************************
+double NoisePwrSpectrum::filterSample
+    (
+    const double            aInSample,      //!< input sample
+    const uint64_t          aIndex,         //!< index of the sample in the stream
+    std::vector<double>&    aDelayLine      //!< filter state
+    ) const
+{
+    if( 0 == aIndex % RESET_SAMPLES || aDelayLine.size() != static_cast<size_t>( 1 + mFilter.N ) )
+    {
+        aDelayLine.assign( 1 + mFilter.N, 0 );
+    }
+
+    int j = 0;
+
+    for( j = mFilter.N; j >= 1; j-- )
+    {
+        aDelayLine[j] = aDelayLine[j - 1];
+    }
+
+    aDelayLine[0] = aInSample;
+
+    for( j = 1; j <= mFilter.N; j++ )
+    {
+        aDelayLine[0] -= mFilter.a[j] * aDelayLine[j];
+    }
+
+    double outSample = 0;
+
+    for( j = 0; j <= mFilter.N; j++ )
+    {
+        outSample += mFilter.b[j] * aDelayLine[j];
+    }
+
+    return outSample;
+}
+
+
 //!************************************************************************
 //! Set the frequency exponent
 //!
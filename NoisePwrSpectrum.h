@@ -52,6 +52,7 @@ class NoisePwrSpectrum
 
     private:
         static const int NR_OF_FILTER_BLOCKS = 7;    //!< N = number of digital filter blocks
+        static const int RESET_SAMPLES = 512;        //!< the filter state is cleared every this many samples
 
         struct DigitalFilter
         {
@@ -83,6 +84,13 @@ class NoisePwrSpectrum
             std::vector<double>&        aOutSignal   //!< output signal
             ) const;
 
+        double filterSample
+            (
+            const double            aInSample,      //!< input sample
+            const uint64_t          aIndex,         //!< index of the sample in the stream
+            std::vector<double>&    aDelayLine      //!< filter state
+            ) const;
+
         void setGamma
             (
             const double aGamma         //!< frequency exponent
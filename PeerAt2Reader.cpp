@@ -0,0 +1,255 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2025 Mihai Ursu                                                 //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+/*
+PeerAt2Reader.cpp
+This file contains the sources for reading PEER NGA AT2 strong-motion files.
+*/
+
+#include "PeerAt2Reader.h"
+
+#include "Smc.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <sstream>
+
+
+//!************************************************************************
+//! Check if the data starts with a PEER header
+//!
+//! @returns: true if the first line names the PEER database
+//!************************************************************************
+bool PeerAt2Reader::canRead
+    (
+    const char*     aData,          //!< file content
+    const size_t    aLength         //!< file length
+    ) const
+{
+    const char* pos = aData;
+    std::string firstLine;
+
+    return ( getLine( pos, aData + aLength, firstLine )
+          && 0 == firstLine.find( "PEER" ) );
+}
+
+
+//!************************************************************************
+//! Get the name of the file format
+//!
+//! @returns: format name
+//!************************************************************************
+std::string PeerAt2Reader::getFormatName() const
+{
+    return "PEER NGA AT2";
+}
+
+
+//!************************************************************************
+//! Parse a PEER NGA AT2 file into a record
+//! Both the "NPTS= n, DT= dt SEC" and the older "n dt NPTS, DT" forms of
+//! the fourth header line are accepted.
+//!
+//! @returns: true if a record was appended
+//!************************************************************************
+bool PeerAt2Reader::read
+    (
+    const char*         aData,          //!< file content
+    const size_t        aLength,        //!< file length
+    std::vector<Smc>&   aRecordVec,     //!< records are appended
+    std::string&        aError          //!< error message
+    ) const
+{
+    const char* pos = aData;
+    const char* end = aData + aLength;
+
+    aError.clear();
+
+    Smc record;
+    initializeRecord( record );
+    record.mTextDataTypeFile = Smc::DATA_TYPE_FILE_CORRECTED_ACCELEROGRAM;
+    record.mTextDataSourceStr = "PEER";
+
+    std::string currentLine;
+    int crtLineNr = 0;
+    bool status = true;
+    double scale = 1;
+    size_t pointsCount = 0;
+
+    while( status && crtLineNr < HEADER_LINES_COUNT && getLine( pos, end, currentLine ) )
+    {
+        crtLineNr++;
+
+        switch( crtLineNr )
+        {
+            case 2:
+                {
+                    // earthquake, date, station, component
+                    std::vector<std::string> fieldVec;
+                    std::istringstream lineStream( currentLine );
+                    std::string field;
+
+                    while( std::getline( lineStream, field, ',' ) )
+                    {
+                        trim( field );
+                        fieldVec.push_back( field );
+                    }
+
+                    if( fieldVec.size() >= 4 )
+                    {
+                        record.mTextEarthquakeName = fieldVec.at( 0 );
+                        record.mEarthquakeTimeStamp = fieldVec.at( 1 );
+                        record.mTextStationName = fieldVec.at( 2 );
+                        record.mTextComponentOrientation = fieldVec.back();
+
+                        const std::string& component = record.mTextComponentOrientation;
+                        char* parsedEnd = nullptr;
+                        const long azimuth = std::strtol( component.c_str(), &parsedEnd, 10 );
+
+                        if( parsedEnd != component.c_str() && 0 == *parsedEnd && azimuth >= 0 && azimuth <= 360 )
+                        {
+                            record.mVerticalOrientation = 90;
+                            record.mHorizontalOrientation = static_cast<int16_t>( azimuth );
+                        }
+                        else if( "UP" == component || "V" == component || "Z" == component )
+                        {
+                            record.mVerticalOrientation = 0;
+                        }
+                    }
+                    else
+                    {
+                        trim( currentLine );
+                        record.mTextEarthquakeName = currentLine;
+                    }
+                }
+                break;
+
+            case 3:
+                {
+                    std::string units = currentLine;
+                    std::transform( units.begin(), units.end(), units.begin(), []( unsigned char ch )
+                    {
+                        return static_cast<char>( std::toupper( ch ) );
+                    });
+
+                    if( std::string::npos == units.find( "ACCELERATION" ) )
+                    {
+                        status = false;
+                        aError = "Current file is not an accelerogram in PEER format.";
+                    }
+                    else if( std::string::npos != units.find( "UNITS OF G" ) )
+                    {
+                        scale = G_TO_MS2;
+                    }
+                    else if( std::string::npos != units.find( "CM/S" ) )
+                    {
+                        scale = 1.e-2;
+                    }
+                    else if( std::string::npos == units.find( "M/S" ) )
+                    {
+                        status = false;
+                        aError = "No known data units found in PEER file.";
+                    }
+                }
+                break;
+
+            case 4:
+                {
+                    double timeStep = 0;
+                    const size_t nptsPos = currentLine.find( "NPTS=" );
+                    const size_t dtPos = currentLine.find( "DT=" );
+
+                    if( std::string::npos != nptsPos && std::string::npos != dtPos )
+                    {
+                        pointsCount = std::strtoul( currentLine.c_str() + nptsPos + 5, nullptr, 10 );
+                        timeStep = std::strtod( currentLine.c_str() + dtPos + 3, nullptr );
+                    }
+                    else
+                    {
+                        char* parsedEnd = nullptr;
+                        pointsCount = std::strtoul( currentLine.c_str(), &parsedEnd, 10 );
+                        timeStep = std::strtod( parsedEnd, nullptr );
+                    }
+
+                    if( 0 == pointsCount )
+                    {
+                        status = false;
+                        aError = "No data values specified in PEER file.";
+                    }
+                    else if( timeStep <= 0 )
+                    {
+                        status = false;
+                        aError = "Invalid time step value found in PEER file.";
+                    }
+                    else
+                    {
+                        record.mSamplingRate = 1.0 / timeStep;
+                    }
+                }
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    if( status && crtLineNr < HEADER_LINES_COUNT )
+    {
+        status = false;
+        aError = "Unexpected end of PEER file.";
+    }
+
+    record.mDataVector.reserve( pointsCount );
+
+    while( status && record.mDataVector.size() < pointsCount && getLine( pos, end, currentLine ) )
+    {
+        crtLineNr++;
+        status = parseFixedWidthValues( currentLine, 0, record.mDataVector );
+    }
+
+    if( status && record.mDataVector.size() < pointsCount )
+    {
+        status = false;
+        aError = "Expected data length was " + std::to_string( pointsCount )
+                + " , it is " + std::to_string( record.mDataVector.size() ) + ".";
+    }
+
+    if( status )
+    {
+        record.mDataVector.resize( pointsCount );
+
+        for( double& value : record.mDataVector )
+        {
+            value *= scale; // m/s2
+        }
+
+        finalizeRecord( record );
+        aRecordVec.push_back( std::move( record ) );
+    }
+    else
+    {
+        if( aError.size() )
+        {
+            aError += "\n";
+        }
+
+        aError += "PEER format is wrong at line " + std::to_string( crtLineNr ) + ".";
+    }
+
+    return status;
+}
@@ -0,0 +1,71 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2025 Mihai Ursu                                                 //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+/*
+PeerAt2Reader.h
+This file contains the definitions for reading PEER NGA AT2 strong-motion files.
+*/
+
+#ifndef PeerAt2Reader_h
+#define PeerAt2Reader_h
+
+#include "StrongMotionReader.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+//************************************************************************
+// Class for reading PEER NGA acceleration time series (AT2 files)
+// The four header lines give the database name, the earthquake and the
+// station, the units and the number of points with the time step.
+//************************************************************************
+class PeerAt2Reader : public StrongMotionReader
+{
+    //************************************************************************
+    // constants and types
+    //************************************************************************
+    private:
+        static const uint8_t HEADER_LINES_COUNT = 4;
+
+        static constexpr double G_TO_MS2 = 9.80665;    //!< standard gravity [m/s2]
+
+
+    //************************************************************************
+    // functions
+    //************************************************************************
+    public:
+        bool canRead
+            (
+            const char*     aData,          //!< file content
+            const size_t    aLength         //!< file length
+            ) const override;
+
+        std::string getFormatName() const override;
+
+        bool read
+            (
+            const char*         aData,          //!< file content
+            const size_t        aLength,        //!< file length
+            std::vector<Smc>&   aRecordVec,     //!< records are appended
+            std::string&        aError          //!< error message
+            ) const override;
+};
+
+#endif // PeerAt2Reader_h
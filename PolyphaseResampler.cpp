@@ -0,0 +1,270 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2025 Mihai Ursu                                                 //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+/*
+PolyphaseResampler.cpp
+This file contains the sources for the streaming rational resampler.
+*/
+
+#include "PolyphaseResampler.h"
+
+#include <cmath>
+#include <numeric>
+
+
+//!************************************************************************
+//! Constructor
+//!************************************************************************
+PolyphaseResampler::PolyphaseResampler
+    (
+    const double aInputRate,        //!< input sampling rate [SPS]
+    const double aOutputRate        //!< output sampling rate [SPS]
+    )
+    : mInterpolation( 1 )
+    , mDecimation( 1 )
+    , mTapsPerPhase( TAPS_PER_PHASE )
+    , mHistoryStart( 0 )
+    , mNextOutput( 0 )
+{
+    findRatio( aInputRate, aOutputRate );
+    designFilter();
+    reset();
+}
+
+
+//!************************************************************************
+//! Modified Bessel function of the first kind, order 0
+//!
+//! @returns: I0(x)
+//!************************************************************************
+double PolyphaseResampler::besselI0
+    (
+    const double aX                 //!< argument
+    )
+{
+    double sum = 1;
+    double term = 1;
+    const double halfX = 0.5 * aX;
+
+    for( int k = 1; k < 50 && term > 1.e-12 * sum; k++ )
+    {
+        term *= ( halfX / k ) * ( halfX / k );
+        sum += term;
+    }
+
+    return sum;
+}
+
+
+//!************************************************************************
+//! Design the Kaiser-windowed sinc low-pass filter at the upsampled rate
+//! and split it into L phases
+//!
+//! The cutoff is below both the input and the output Nyquist frequencies,
+//! so the same filter rejects the interpolation images and the aliases.
+//! The filter spans TAPS_PER_PHASE samples at the lower of the two rates,
+//! so that its transition band stays within the lower Nyquist frequency
+//! when decimating as well.
+//!
+//! @returns: nothing
+//!************************************************************************
+void PolyphaseResampler::designFilter()
+{
+    const uint64_t spanLength = static_cast<uint64_t>( TAPS_PER_PHASE ) * std::max( mInterpolation, mDecimation );
+    mTapsPerPhase = static_cast<uint32_t>( ( spanLength + mInterpolation - 1 ) / mInterpolation );
+    const size_t length = static_cast<size_t>( mTapsPerPhase ) * mInterpolation;
+
+    // centered on the delay used in reset(), the last symmetric tap is left out
+    const double center = 0.5 * length;
+
+    // cycles per upsampled sample
+    const double cutoff = 0.5 * CUTOFF_RATIO / std::max( mInterpolation, mDecimation );
+    const double i0Beta = besselI0( KAISER_BETA );
+
+    mPhaseCoeffVec.assign( length, 0 );
+
+    for( size_t k = 0; k < length; k++ )
+    {
+        const double x = k - center;
+        const double sinc = ( 0 == x ) ? 2.0 * cutoff : sin( 2.0 * M_PI * cutoff * x ) / ( M_PI * x );
+        const double r = x / center;
+        const double window = besselI0( KAISER_BETA * sqrt( std::max( 0.0, 1.0 - r * r ) ) ) / i0Beta;
+
+        // phase p, tap t holds h[t * L + p]; the gain L compensates the inserted zeros
+        const size_t phase = k % mInterpolation;
+        const size_t tap = k / mInterpolation;
+        mPhaseCoeffVec[phase * mTapsPerPhase + tap] = mInterpolation * sinc * window;
+    }
+}
+
+
+//!************************************************************************
+//! Find L/M close to the output/input rate ratio, with L limited to
+//! INTERPOLATION_MAX (best rational approximation by continued fractions)
+//!
+//! @returns: nothing
+//!************************************************************************
+void PolyphaseResampler::findRatio
+    (
+    const double aInputRate,        //!< input sampling rate [SPS]
+    const double aOutputRate        //!< output sampling rate [SPS]
+    )
+{
+    mInterpolation = 1;
+    mDecimation = 1;
+
+    if( aInputRate > 0 && aOutputRate > 0 )
+    {
+        const double ratio = aOutputRate / aInputRate;
+
+        // convergents h/k of the continued fraction of the ratio
+        uint64_t hPrev = 1, h = static_cast<uint64_t>( std::floor( ratio ) );
+        uint64_t kPrev = 0, k = 1;
+        double remainder = ratio - std::floor( ratio );
+
+        while( remainder > 1.e-9 )
+        {
+            const double inverse = 1.0 / remainder;
+            const uint64_t a = static_cast<uint64_t>( std::floor( inverse ) );
+            const uint64_t hNext = a * h + hPrev;
+            const uint64_t kNext = a * k + kPrev;
+
+            if( hNext > INTERPOLATION_MAX )
+            {
+                break;
+            }
+
+            hPrev = h;
+            h = hNext;
+            kPrev = k;
+            k = kNext;
+            remainder = inverse - a;
+        }
+
+        if( 0 == h )
+        {
+            // output rate far below the input rate
+            h = 1;
+            k = static_cast<uint64_t>( std::round( 1.0 / ratio ) );
+        }
+
+        const uint64_t divisor = std::gcd( h, k );
+        mInterpolation = static_cast<uint32_t>( h / divisor );
+        mDecimation = static_cast<uint32_t>( k / divisor );
+    }
+}
+
+
+//!************************************************************************
+//! Push the filter tail out, as if the input continued with zeros
+//!
+//! @returns: nothing
+//!************************************************************************
+void PolyphaseResampler::flush
+    (
+    std::vector<double>&    aOutVec     //!< resampled values are appended
+    )
+{
+    const std::vector<double> zeroVec( mTapsPerPhase / 2, 0 );
+    process( zeroVec.data(), zeroVec.size(), aOutVec );
+}
+
+
+//!************************************************************************
+//! Get the decimation factor
+//!
+//! @returns: M
+//!************************************************************************
+uint32_t PolyphaseResampler::getDecimation() const
+{
+    return mDecimation;
+}
+
+
+//!************************************************************************
+//! Get the interpolation factor
+//!
+//! @returns: L
+//!************************************************************************
+uint32_t PolyphaseResampler::getInterpolation() const
+{
+    return mInterpolation;
+}
+
+
+//!************************************************************************
+//! Resample a block of input values
+//!
+//! Output n is taken at the upsampled index n * M + D, where D is the
+//! filter delay, so the first output is aligned with the first input.
+//! Only the last mTapsPerPhase input values are kept between calls.
+//!
+//! @returns: nothing
+//!************************************************************************
+void PolyphaseResampler::process
+    (
+    const double*           aIn,        //!< input values
+    const size_t            aLength,    //!< number of input values
+    std::vector<double>&    aOutVec     //!< resampled values are appended
+    )
+{
+    mHistoryVec.insert( mHistoryVec.end(), aIn, aIn + aLength );
+
+    const int64_t historyEnd = mHistoryStart + static_cast<int64_t>( mHistoryVec.size() );
+
+    while( static_cast<int64_t>( mNextOutput / mInterpolation ) < historyEnd )
+    {
+        const int64_t newest = static_cast<int64_t>( mNextOutput / mInterpolation );
+        const uint32_t phase = static_cast<uint32_t>( mNextOutput % mInterpolation );
+
+        const double* coeff = mPhaseCoeffVec.data() + phase * mTapsPerPhase;
+        const double* x = mHistoryVec.data() + ( newest - mHistoryStart );
+        double y = 0;
+
+        for( uint32_t t = 0; t < mTapsPerPhase; t++ )
+        {
+            y += coeff[t] * *( x - t );
+        }
+
+        aOutVec.push_back( y );
+        mNextOutput += mDecimation;
+    }
+
+    // keep the values needed by the next outputs
+    if( mHistoryVec.size() > mTapsPerPhase )
+    {
+        const size_t dropped = mHistoryVec.size() - mTapsPerPhase;
+        mHistoryVec.erase( mHistoryVec.begin(), mHistoryVec.begin() + dropped );
+        mHistoryStart += dropped;
+    }
+}
+
+
+//!************************************************************************
+//! Reset the stream state
+//!
+//! @returns: nothing
+//!************************************************************************
+void PolyphaseResampler::reset()
+{
+    // mTapsPerPhase - 1 zeros before the first input value
+    mHistoryVec.assign( mTapsPerPhase - 1, 0 );
+    mHistoryStart = -static_cast<int64_t>( mTapsPerPhase - 1 );
+
+    // filter delay, in upsampled samples
+    mNextOutput = static_cast<uint64_t>( mTapsPerPhase ) * mInterpolation / 2;
+}
@@ -0,0 +1,107 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2025 Mihai Ursu                                                 //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+/*
+PolyphaseResampler.h
+This file contains the definitions for the streaming rational resampler.
+*/
+
+#ifndef PolyphaseResampler_h
+#define PolyphaseResampler_h
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+//************************************************************************
+// Class for streaming resampling by a rational factor L/M
+//************************************************************************
+class PolyphaseResampler
+{
+    //************************************************************************
+    // constants and types
+    //************************************************************************
+    public:
+        static const uint32_t INTERPOLATION_MAX = 512;      //!< largest L of the rational approximation
+        static const uint8_t TAPS_PER_PHASE = 32;           //!< filter taps for each sample at the lower rate
+
+    private:
+        static constexpr double KAISER_BETA = 8.6;          //!< about 90 dB stopband attenuation
+        static constexpr double CUTOFF_RATIO = 0.9;         //!< cutoff relative to the lower Nyquist frequency
+
+
+    //************************************************************************
+    // functions
+    //************************************************************************
+    public:
+        PolyphaseResampler
+            (
+            const double aInputRate,        //!< input sampling rate [SPS]
+            const double aOutputRate        //!< output sampling rate [SPS]
+            );
+
+        void flush
+            (
+            std::vector<double>&    aOutVec     //!< resampled values are appended
+            );
+
+        uint32_t getDecimation() const;
+
+        uint32_t getInterpolation() const;
+
+        void process
+            (
+            const double*           aIn,        //!< input values
+            const size_t            aLength,    //!< number of input values
+            std::vector<double>&    aOutVec     //!< resampled values are appended
+            );
+
+        void reset();
+
+    private:
+        static double besselI0
+            (
+            const double aX                 //!< argument
+            );
+
+        void designFilter();
+
+        void findRatio
+            (
+            const double aInputRate,        //!< input sampling rate [SPS]
+            const double aOutputRate        //!< output sampling rate [SPS]
+            );
+
+
+    //************************************************************************
+    // variables
+    //************************************************************************
+    private:
+        uint32_t                mInterpolation;     //!< L
+        uint32_t                mDecimation;        //!< M
+
+        uint32_t                mTapsPerPhase;      //!< filter taps for each output sample
+
+        std::vector<double>     mPhaseCoeffVec;     //!< filter coefficients, mTapsPerPhase for each of the L phases
+
+        std::vector<double>     mHistoryVec;        //!< input values, the oldest first
+        int64_t                 mHistoryStart;      //!< input index of the first value in history
+        uint64_t                mNextOutput;        //!< upsampled index of the next output value
+};
+
+#endif // PolyphaseResampler_h
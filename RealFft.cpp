@@ -0,0 +1,265 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2025 Mihai Ursu                                                 //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+/*
+RealFft.cpp
+This file contains the sources for the FFT of real-valued data.
+*/
+
+#include "RealFft.h"
+
+#include <cmath>
+#include <map>
+#include <mutex>
+
+
+//!************************************************************************
+//! Constructor
+//!************************************************************************
+RealFft::RealFft
+    (
+    const size_t aSize          //!< transform size, a power of 2
+    )
+    : mPlan( getPlan( nextPowerOfTwo( aSize ) ) )
+{
+}
+
+
+//!************************************************************************
+//! Forward transform of real data
+//!
+//! The N real values are packed into N/2 complex values, transformed,
+//! then split into the spectrum of the even and odd samples.
+//!
+//! X[k] = sum( x[n] * exp(-2*pi*i*k*n/N) ), k = 0...N/2
+//!
+//! @returns: nothing
+//!************************************************************************
+void RealFft::forward
+    (
+    const double*                       aIn,    //!< N real values
+    std::vector<std::complex<double>>&  aOut    //!< N/2+1 spectrum bins
+    ) const
+{
+    const size_t m = mPlan->size / 2;
+    std::vector<std::complex<double>> z( m );
+
+    for( size_t n = 0; n < m; n++ )
+    {
+        z[n] = std::complex<double>( aIn[2 * n], aIn[2 * n + 1] );
+    }
+
+    transformComplex( z.data(), false );
+
+    aOut.resize( m + 1 );
+
+    for( size_t k = 0; k <= m; k++ )
+    {
+        const std::complex<double> zk = z[k % m];
+        const std::complex<double> zmk = std::conj( z[( m - k ) % m] );
+
+        const std::complex<double> even = 0.5 * ( zk + zmk );
+        const std::complex<double> odd = std::complex<double>( 0, -0.5 ) * ( zk - zmk );
+
+        aOut[k] = even + mPlan->splitTwiddleVec[k] * odd;
+    }
+}
+
+
+//!************************************************************************
+//! Get the transform size
+//!
+//! @returns: the number of real values N
+//!************************************************************************
+size_t RealFft::getSize() const
+{
+    return mPlan->size;
+}
+
+
+//!************************************************************************
+//! Get the plan for a transform size, computing it on first use
+//! Plans are immutable and shared between all transforms of the same size.
+//!
+//! @returns: the plan
+//!************************************************************************
+std::shared_ptr<const RealFft::Plan> RealFft::getPlan
+    (
+    const size_t aSize          //!< transform size, a power of 2
+    )
+{
+    static std::mutex cacheMutex;
+    static std::map<size_t, std::shared_ptr<const Plan>> cacheMap;
+
+    std::lock_guard<std::mutex> lock( cacheMutex );
+
+    auto it = cacheMap.find( aSize );
+
+    if( cacheMap.end() != it )
+    {
+        return it->second;
+    }
+
+    std::shared_ptr<Plan> plan = std::make_shared<Plan>();
+    plan->size = aSize;
+
+    const size_t m = aSize / 2;
+    uint8_t bits = 0;
+
+    while( ( static_cast<size_t>( 1 ) << bits ) < m )
+    {
+        bits++;
+    }
+
+    plan->bitReverseVec.resize( m );
+
+    for( size_t i = 0; i < m; i++ )
+    {
+        uint32_t reversed = 0;
+
+        for( uint8_t b = 0; b < bits; b++ )
+        {
+            reversed |= ( ( i >> b ) & 1 ) << ( bits - 1 - b );
+        }
+
+        plan->bitReverseVec[i] = reversed;
+    }
+
+    plan->twiddleVec.resize( m / 2 );
+
+    for( size_t k = 0; k < m / 2; k++ )
+    {
+        plan->twiddleVec[k] = std::polar( 1.0, -2.0 * M_PI * k / m );
+    }
+
+    plan->splitTwiddleVec.resize( m + 1 );
+
+    for( size_t k = 0; k <= m; k++ )
+    {
+        plan->splitTwiddleVec[k] = std::polar( 1.0, -2.0 * M_PI * k / aSize );
+    }
+
+    cacheMap.insert( std::make_pair( aSize, plan ) );
+
+    return plan;
+}
+
+
+//!************************************************************************
+//! Inverse transform to real data, scaled by 1/N
+//!
+//! @returns: nothing
+//!************************************************************************
+void RealFft::inverse
+    (
+    const std::vector<std::complex<double>>&    aIn,    //!< N/2+1 spectrum bins
+    double*                                     aOut    //!< N real values
+    ) const
+{
+    const size_t m = mPlan->size / 2;
+    std::vector<std::complex<double>> z( m );
+
+    for( size_t k = 0; k < m && k < aIn.size(); k++ )
+    {
+        const std::complex<double> xk = aIn[k];
+        const std::complex<double> xmk = ( m - k < aIn.size() ) ? std::conj( aIn[m - k] ) : 0;
+
+        const std::complex<double> even = 0.5 * ( xk + xmk );
+        const std::complex<double> odd = 0.5 * ( xk - xmk ) * std::conj( mPlan->splitTwiddleVec[k] );
+
+        z[k] = even + std::complex<double>( 0, 1 ) * odd;
+    }
+
+    transformComplex( z.data(), true );
+
+    const double scale = 1.0 / m;
+
+    for( size_t n = 0; n < m; n++ )
+    {
+        aOut[2 * n] = scale * z[n].real();
+        aOut[2 * n + 1] = scale * z[n].imag();
+    }
+}
+
+
+//!************************************************************************
+//! Get the smallest power of 2 not less than a value
+//!
+//! @returns: the power of 2, at least SIZE_MIN
+//!************************************************************************
+size_t RealFft::nextPowerOfTwo
+    (
+    const size_t aValue         //!< a value
+    )
+{
+    size_t size = SIZE_MIN;
+
+    while( size < aValue )
+    {
+        size <<= 1;
+    }
+
+    return size;
+}
+
+
+//!************************************************************************
+//! Iterative radix-2 complex FFT of N/2 values
+//!
+//! @returns: nothing
+//!************************************************************************
+void RealFft::transformComplex
+    (
+    std::complex<double>*   aData,      //!< N/2 values, transformed in place
+    const bool              aInverse    //!< true for the inverse transform, not scaled
+    ) const
+{
+    const size_t m = mPlan->size / 2;
+
+    for( size_t i = 0; i < m; i++ )
+    {
+        const size_t j = mPlan->bitReverseVec[i];
+
+        if( i < j )
+        {
+            std::swap( aData[i], aData[j] );
+        }
+    }
+
+    for( size_t len = 2; len <= m; len <<= 1 )
+    {
+        const size_t half = len / 2;
+        const size_t step = m / len;
+
+        for( size_t start = 0; start < m; start += len )
+        {
+            for( size_t j = 0; j < half; j++ )
+            {
+                std::complex<double> w = mPlan->twiddleVec[j * step];
+
+                if( aInverse )
+                {
+                    w = std::conj( w );
+                }
+
+                const std::complex<double> t = w * aData[start + j + half];
+                aData[start + j + half] = aData[start + j] - t;
+                aData[start + j] += t;
+            }
+        }
+    }
+}
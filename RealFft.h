@@ -0,0 +1,107 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2025 Mihai Ursu                                                 //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+/*
+RealFft.h
+This file contains the definitions for the FFT of real-valued data.
+*/
+
+#ifndef RealFft_h
+#define RealFft_h
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+
+//************************************************************************
+// Class for the FFT of real-valued data, with cached twiddle plans
+//************************************************************************
+class RealFft
+{
+    //************************************************************************
+    // constants and types
+    //************************************************************************
+    public:
+        static const size_t SIZE_MIN = 4;                   //!< smallest transform size
+
+    private:
+        struct Plan
+        {
+            size_t                              size;               //!< real transform size N
+            std::vector<uint32_t>               bitReverseVec;      //!< permutation for the N/2 complex FFT
+            std::vector<std::complex<double>>   twiddleVec;         //!< exp(-2*pi*i*k/(N/2)), k < N/4
+            std::vector<std::complex<double>>   splitTwiddleVec;    //!< exp(-2*pi*i*k/N), k <= N/2
+
+            Plan()
+            {
+                size = 0;
+            }
+        };
+
+
+    //************************************************************************
+    // functions
+    //************************************************************************
+    public:
+        RealFft
+            (
+            const size_t aSize          //!< transform size, a power of 2
+            );
+
+        void forward
+            (
+            const double*                       aIn,    //!< N real values
+            std::vector<std::complex<double>>&  aOut    //!< N/2+1 spectrum bins
+            ) const;
+
+        size_t getSize() const;
+
+        void inverse
+            (
+            const std::vector<std::complex<double>>&    aIn,    //!< N/2+1 spectrum bins
+            double*                                     aOut    //!< N real values
+            ) const;
+
+        static size_t nextPowerOfTwo
+            (
+            const size_t aValue         //!< a value
+            );
+
+    private:
+        static std::shared_ptr<const Plan> getPlan
+            (
+            const size_t aSize          //!< transform size, a power of 2
+            );
+
+        void transformComplex
+            (
+            std::complex<double>*   aData,      //!< N/2 values, transformed in place
+            const bool              aInverse    //!< true for the inverse transform, not scaled
+            ) const;
+
+
+    //************************************************************************
+    // variables
+    //************************************************************************
+    private:
+        std::shared_ptr<const Plan>     mPlan;      //!< shared twiddle plan
+};
+
+#endif // RealFft_h
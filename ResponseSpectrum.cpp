@@ -0,0 +1,281 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2025 Mihai Ursu                                                 //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+/*
+ResponseSpectrum.cpp
+This file contains the sources for the elastic response spectrum.
+*/
+
+#include "ResponseSpectrum.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+
+
+const std::vector<double> ResponseSpectrum::DAMPING_RATIOS =
+{
+    0, 0.02, 0.05, 0.1, 0.2
+};
+
+
+//!************************************************************************
+//! Constructor
+//!************************************************************************
+ResponseSpectrum::ResponseSpectrum
+    (
+    const std::vector<double>&  aPeriodVec,     //!< oscillator periods [s]
+    const std::vector<double>&  aDampingVec     //!< fractions of critical damping [-]
+    )
+{
+    for( const double period : aPeriodVec )
+    {
+        if( period > 0 )
+        {
+            mPeriodVec.push_back( period );
+        }
+    }
+
+    for( const double damping : aDampingVec )
+    {
+        if( damping >= 0 && damping < 1 )
+        {
+            mDampingVec.push_back( damping );
+        }
+    }
+}
+
+
+//!************************************************************************
+//! Compute the response spectra of an accelerogram
+//!
+//! Each (damping, period) pair is a linear SDOF oscillator, integrated
+//! exactly for a piecewise linear ground acceleration.
+//! Groups of oscillators are integrated together, so that the recursion
+//! runs over contiguous lanes, and groups are shared between threads.
+//!
+//! References:
+//! [1] Nigam, N. C., Jennings, P. C. - Calculation of Response Spectra from
+//!                                     Strong-Motion Earthquake Records,
+//!                                     Bull. Seism. Soc. Am. 59 (2), 1969, pp. 909-922
+//!
+//! @returns: nothing
+//!************************************************************************
+void ResponseSpectrum::compute
+    (
+    const std::vector<double>&  aAccelerationVec,   //!< ground acceleration [m/s2]
+    const double                aSamplingRate,      //!< sampling rate [SPS]
+    std::vector<Spectrum>&      aSpectrumVec        //!< one spectrum for each damping
+    ) const
+{
+    aSpectrumVec.clear();
+
+    if( aSamplingRate <= 0 || aAccelerationVec.size() < 2 )
+    {
+        return;
+    }
+
+    const double dt = 1.0 / aSamplingRate;
+    const size_t pairsCount = mDampingVec.size() * mPeriodVec.size();
+
+    std::vector<OscillatorGroup> groupVec( ( pairsCount + LANES - 1 ) / LANES );
+
+    for( size_t i = 0; i < pairsCount; i++ )
+    {
+        OscillatorGroup& group = groupVec.at( i / LANES );
+        uint8_t lane = group.count++;
+
+        group.index[lane] = i;
+        setGroupLane( group, lane, mPeriodVec.at( i % mPeriodVec.size() ), mDampingVec.at( i / mPeriodVec.size() ), dt );
+    }
+
+    std::vector<double> maxDisplVec( pairsCount, 0 );
+    std::atomic<size_t> nextGroup( 0 );
+
+    auto worker = [&]()
+    {
+        for( size_t g = nextGroup++; g < groupVec.size(); g = nextGroup++ )
+        {
+            integrateGroup( groupVec[g], aAccelerationVec.data(), aAccelerationVec.size(), maxDisplVec.data() );
+        }
+    };
+
+    const size_t threadsCount = std::min<size_t>( std::max( 1u, std::thread::hardware_concurrency() ), groupVec.size() );
+    std::vector<std::thread> threadVec;
+
+    for( size_t t = 1; t < threadsCount; t++ )
+    {
+        threadVec.emplace_back( worker );
+    }
+
+    worker();
+
+    for( std::thread& crtThread : threadVec )
+    {
+        crtThread.join();
+    }
+
+    for( size_t d = 0; d < mDampingVec.size(); d++ )
+    {
+        Spectrum spectrum;
+        spectrum.damping = mDampingVec.at( d );
+        spectrum.sdVec.resize( mPeriodVec.size() );
+        spectrum.psvVec.resize( mPeriodVec.size() );
+        spectrum.psaVec.resize( mPeriodVec.size() );
+
+        for( size_t p = 0; p < mPeriodVec.size(); p++ )
+        {
+            const double omega = 2.0 * M_PI / mPeriodVec.at( p );
+            const double sd = maxDisplVec.at( d * mPeriodVec.size() + p );
+
+            spectrum.sdVec.at( p ) = sd;
+            spectrum.psvVec.at( p ) = omega * sd;
+            spectrum.psaVec.at( p ) = omega * omega * sd;
+        }
+
+        aSpectrumVec.push_back( spectrum );
+    }
+}
+
+
+//!************************************************************************
+//! Create logarithmically spaced periods
+//!
+//! @returns: the periods [s]
+//!************************************************************************
+std::vector<double> ResponseSpectrum::createLogPeriods
+    (
+    const double    aPeriodMin,     //!< shortest period [s]
+    const double    aPeriodMax,     //!< longest period [s]
+    const uint16_t  aCount          //!< number of periods
+    )
+{
+    std::vector<double> periodVec;
+
+    if( aPeriodMin > 0 && aPeriodMax > aPeriodMin && aCount > 1 )
+    {
+        const double ratio = std::pow( aPeriodMax / aPeriodMin, 1.0 / ( aCount - 1 ) );
+        double period = aPeriodMin;
+
+        for( uint16_t i = 0; i < aCount; i++ )
+        {
+            periodVec.push_back( period );
+            period *= ratio;
+        }
+    }
+
+    return periodVec;
+}
+
+
+//!************************************************************************
+//! Get the oscillator periods
+//!
+//! @returns: the periods [s]
+//!************************************************************************
+const std::vector<double>& ResponseSpectrum::getPeriods() const
+{
+    return mPeriodVec;
+}
+
+
+//!************************************************************************
+//! Integrate a group of oscillators over the whole record
+//!
+//! @returns: nothing
+//!************************************************************************
+void ResponseSpectrum::integrateGroup
+    (
+    const OscillatorGroup&  aGroup,         //!< oscillators
+    const double*           aAcceleration,  //!< ground acceleration [m/s2]
+    const size_t            aLength,        //!< number of samples
+    double*                 aMaxDisplVec    //!< maximum displacement for each (damping, period) pair
+    ) const
+{
+    // oscillators at rest before the first sample
+    double u[LANES] = {};
+    double v[LANES] = {};
+    double uMax[LANES] = {};
+
+    for( size_t k = 0; k + 1 < aLength; k++ )
+    {
+        const double ag0 = aAcceleration[k];
+        const double ag1 = aAcceleration[k + 1];
+
+        for( uint8_t l = 0; l < LANES; l++ )
+        {
+            const double uNew = aGroup.a11[l] * u[l] + aGroup.a12[l] * v[l] + aGroup.b11[l] * ag0 + aGroup.b12[l] * ag1;
+            const double vNew = aGroup.a21[l] * u[l] + aGroup.a22[l] * v[l] + aGroup.b21[l] * ag0 + aGroup.b22[l] * ag1;
+
+            u[l] = uNew;
+            v[l] = vNew;
+            uMax[l] = std::max( uMax[l], std::fabs( uNew ) );
+        }
+    }
+
+    for( uint8_t l = 0; l < aGroup.count; l++ )
+    {
+        aMaxDisplVec[aGroup.index[l]] = uMax[l];
+    }
+}
+
+
+//!************************************************************************
+//! Set the recursion coefficients of one oscillator, see [1]
+//!
+//! u'' + 2 * damping * omega * u' + omega^2 * u = -ag(t)
+//!
+//! @returns: nothing
+//!************************************************************************
+void ResponseSpectrum::setGroupLane
+    (
+    OscillatorGroup&        aGroup,         //!< oscillators
+    const uint8_t           aLane,          //!< lane in group
+    const double            aPeriod,        //!< period [s]
+    const double            aDamping,       //!< fraction of critical damping [-]
+    const double            aDt             //!< time step [s]
+    ) const
+{
+    const double w = 2.0 * M_PI / aPeriod;
+    const double z = aDamping;
+    const double sq = std::sqrt( 1.0 - z * z );
+    const double wd = w * sq;
+
+    const double e = std::exp( -z * w * aDt );
+    const double s = std::sin( wd * aDt );
+    const double c = std::cos( wd * aDt );
+
+    const double w2 = w * w;
+    const double w3 = w2 * w;
+
+    const double k1 = ( 2.0 * z * z - 1.0 ) / ( w2 * aDt );
+    const double k2 = 2.0 * z / ( w3 * aDt );
+
+    const double cs = c - z / sq * s;
+    const double ws = wd * s + z * w * c;
+
+    aGroup.a11[aLane] = e * ( z / sq * s + c );
+    aGroup.a12[aLane] = e * s / wd;
+    aGroup.a21[aLane] = -w / sq * e * s;
+    aGroup.a22[aLane] = e * cs;
+
+    aGroup.b11[aLane] = e * ( ( k1 + z / w ) * s / wd + ( k2 + 1.0 / w2 ) * c ) - k2;
+    aGroup.b12[aLane] = -e * ( k1 * s / wd + k2 * c ) - 1.0 / w2 + k2;
+    aGroup.b21[aLane] = e * ( ( k1 + z / w ) * cs - ( k2 + 1.0 / w2 ) * ws ) + 1.0 / ( w2 * aDt );
+    aGroup.b22[aLane] = -e * ( k1 * cs - k2 * ws ) - 1.0 / ( w2 * aDt );
+}
@@ -0,0 +1,148 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2025 Mihai Ursu                                                 //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+/*
+ResponseSpectrum.h
+This file contains the definitions for the elastic response spectrum.
+*/
+
+#ifndef ResponseSpectrum_h
+#define ResponseSpectrum_h
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+//************************************************************************
+// Class for computing elastic response spectra of accelerograms
+//************************************************************************
+class ResponseSpectrum
+{
+    //************************************************************************
+    // constants and types
+    //************************************************************************
+    public:
+        static constexpr double PERIOD_MIN_S = 0.02;        //!< shortest oscillator period [s]
+        static constexpr double PERIOD_MAX_S = 10;          //!< longest oscillator period [s]
+        static const uint16_t PERIODS_COUNT = 200;          //!< number of oscillator periods
+
+        static const std::vector<double> DAMPING_RATIOS;    //!< default fractions of critical damping
+
+        struct Spectrum
+        {
+            double                  damping;    //!< fraction of critical damping [-]
+            std::vector<double>     sdVec;      //!< relative displacement [m]
+            std::vector<double>     psvVec;     //!< pseudo-velocity [m/s]
+            std::vector<double>     psaVec;     //!< pseudo-acceleration [m/s2]
+
+            Spectrum()
+            {
+                damping = 0;
+            }
+        };
+
+    private:
+        static const uint8_t LANES = 8;                     //!< oscillators integrated together
+
+        // Nigam-Jennings recursion coefficients for a group of oscillators
+        struct OscillatorGroup
+        {
+            double a11[LANES];
+            double a12[LANES];
+            double a21[LANES];
+            double a22[LANES];
+            double b11[LANES];
+            double b12[LANES];
+            double b21[LANES];
+            double b22[LANES];
+
+            size_t index[LANES];    //!< index in the list of (damping, period) pairs
+            uint8_t count;          //!< number of used lanes
+
+            // unused lanes of the last group are integrated too, with zero
+            // coefficients, so that they stay at rest
+            OscillatorGroup()
+                : a11()
+                , a12()
+                , a21()
+                , a22()
+                , b11()
+                , b12()
+                , b21()
+                , b22()
+                , index()
+            {
+                count = 0;
+            }
+        };
+
+
+    //************************************************************************
+    // functions
+    //************************************************************************
+    public:
+        ResponseSpectrum
+            (
+            const std::vector<double>&  aPeriodVec,     //!< oscillator periods [s]
+            const std::vector<double>&  aDampingVec     //!< fractions of critical damping [-]
+            );
+
+        void compute
+            (
+            const std::vector<double>&  aAccelerationVec,   //!< ground acceleration [m/s2]
+            const double                aSamplingRate,      //!< sampling rate [SPS]
+            std::vector<Spectrum>&      aSpectrumVec        //!< one spectrum for each damping
+            ) const;
+
+        static std::vector<double> createLogPeriods
+            (
+            const double    aPeriodMin,     //!< shortest period [s]
+            const double    aPeriodMax,     //!< longest period [s]
+            const uint16_t  aCount          //!< number of periods
+            );
+
+        const std::vector<double>& getPeriods() const;
+
+    private:
+        void integrateGroup
+            (
+            const OscillatorGroup&  aGroup,         //!< oscillators
+            const double*           aAcceleration,  //!< ground acceleration [m/s2]
+            const size_t            aLength,        //!< number of samples
+            double*                 aMaxDisplVec    //!< maximum displacement for each (damping, period) pair
+            ) const;
+
+        void setGroupLane
+            (
+            OscillatorGroup&        aGroup,         //!< oscillators
+            const uint8_t           aLane,          //!< lane in group
+            const double            aPeriod,        //!< period [s]
+            const double            aDamping,       //!< fraction of critical damping [-]
+            const double            aDt             //!< time step [s]
+            ) const;
+
+
+    //************************************************************************
+    // variables
+    //************************************************************************
+    private:
+        std::vector<double>     mPeriodVec;         //!< oscillator periods [s]
+        std::vector<double>     mDampingVec;        //!< fractions of critical damping [-]
+};
+
+#endif // ResponseSpectrum_h
@@ -0,0 +1,921 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2025 Mihai Ursu                                                 //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+/*
+SignalFile.cpp
+This file contains the sources for reading and writing signal list files.
+*/
+
+#include "SignalFile.h"
+
+#include <QByteArray>
+#include <QFile>
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+
+static_assert( sizeof( double ) == 8, "binary signal files hold 8-byte doubles" );
+
+
+//************************************************************************
+// Parameters of each signal type, in the order written by the signal
+// strings of the main window
+//************************************************************************
+const SignalFile::Schema SignalFile::SCHEMA_TABLE[] =
+{
+    {
+        "Triangle", 6,
+        {
+            { "tPeriod",    FIELD_DOUBLE,   offsetof( SignalItem::SignalTriangle, tPeriod ) },
+            { "tRise",      FIELD_DOUBLE,   offsetof( SignalItem::SignalTriangle, tRise ) },
+            { "tFall",      FIELD_DOUBLE,   offsetof( SignalItem::SignalTriangle, tFall ) },
+            { "tDelay",     FIELD_DOUBLE,   offsetof( SignalItem::SignalTriangle, tDelay ) },
+            { "yMax",       FIELD_DOUBLE,   offsetof( SignalItem::SignalTriangle, yMax ) },
+            { "yMin",       FIELD_DOUBLE,   offsetof( SignalItem::SignalTriangle, yMin ) }
+        },
+        createItem<SignalItem::SignalTriangle>,
+        getItemData<SignalItem::SignalTriangle>
+    },
+    {
+        "Rectangle", 5,
+        {
+            { "tPeriod",    FIELD_DOUBLE,   offsetof( SignalItem::SignalRectangle, tPeriod ) },
+            { "fillFactor", FIELD_DOUBLE,   offsetof( SignalItem::SignalRectangle, fillFactor ) },
+            { "tDelay",     FIELD_DOUBLE,   offsetof( SignalItem::SignalRectangle, tDelay ) },
+            { "yMax",       FIELD_DOUBLE,   offsetof( SignalItem::SignalRectangle, yMax ) },
+            { "yMin",       FIELD_DOUBLE,   offsetof( SignalItem::SignalRectangle, yMin ) }
+        },
+        createItem<SignalItem::SignalRectangle>,
+        getItemData<SignalItem::SignalRectangle>
+    },
+    {
+        "Pulse", 7,
+        {
+            { "tPeriod",    FIELD_DOUBLE,   offsetof( SignalItem::SignalPulse, tPeriod ) },
+            { "tRise",      FIELD_DOUBLE,   offsetof( SignalItem::SignalPulse, tRise ) },
+            { "tWidth",     FIELD_DOUBLE,   offsetof( SignalItem::SignalPulse, tWidth ) },
+            { "tFall",      FIELD_DOUBLE,   offsetof( SignalItem::SignalPulse, tFall ) },
+            { "tDelay",     FIELD_DOUBLE,   offsetof( SignalItem::SignalPulse, tDelay ) },
+            { "yMax",       FIELD_DOUBLE,   offsetof( SignalItem::SignalPulse, yMax ) },
+            { "yMin",       FIELD_DOUBLE,   offsetof( SignalItem::SignalPulse, yMin ) }
+        },
+        createItem<SignalItem::SignalPulse>,
+        getItemData<SignalItem::SignalPulse>
+    },
+    {
+        "RiseFall", 7,
+        {
+            { "tDelay",     FIELD_DOUBLE,   offsetof( SignalItem::SignalRiseFall, tDelay ) },
+            { "tDelayRise", FIELD_DOUBLE,   offsetof( SignalItem::SignalRiseFall, tDelayRise ) },
+            { "tRampRise",  FIELD_DOUBLE,   offsetof( SignalItem::SignalRiseFall, tRampRise ) },
+            { "tDelayFall", FIELD_DOUBLE,   offsetof( SignalItem::SignalRiseFall, tDelayFall ) },
+            { "tRampFall",  FIELD_DOUBLE,   offsetof( SignalItem::SignalRiseFall, tRampFall ) },
+            { "yMax",       FIELD_DOUBLE,   offsetof( SignalItem::SignalRiseFall, yMax ) },
+            { "yMin",       FIELD_DOUBLE,   offsetof( SignalItem::SignalRiseFall, yMin ) }
+        },
+        createItem<SignalItem::SignalRiseFall>,
+        getItemData<SignalItem::SignalRiseFall>
+    },
+    {
+        "SinDamp", 6,
+        {
+            { "freqHz",     FIELD_DOUBLE,   offsetof( SignalItem::SignalSinDamp, freqHz ) },
+            { "phiRad",     FIELD_DOUBLE,   offsetof( SignalItem::SignalSinDamp, phiRad ) },
+            { "tDelay",     FIELD_DOUBLE,   offsetof( SignalItem::SignalSinDamp, tDelay ) },
+            { "amplit",     FIELD_DOUBLE,   offsetof( SignalItem::SignalSinDamp, amplit ) },
+            { "offset",     FIELD_DOUBLE,   offsetof( SignalItem::SignalSinDamp, offset ) },
+            { "damping",    FIELD_DOUBLE,   offsetof( SignalItem::SignalSinDamp, damping ) }
+        },
+        createItem<SignalItem::SignalSinDamp>,
+        getItemData<SignalItem::SignalSinDamp>
+    },
+    {
+        "SinRise", 7,
+        {
+            { "freqHz",     FIELD_DOUBLE,   offsetof( SignalItem::SignalSinRise, freqHz ) },
+            { "phiRad",     FIELD_DOUBLE,   offsetof( SignalItem::SignalSinRise, phiRad ) },
+            { "tEnd",       FIELD_DOUBLE,   offsetof( SignalItem::SignalSinRise, tEnd ) },
+            { "tDelay",     FIELD_DOUBLE,   offsetof( SignalItem::SignalSinRise, tDelay ) },
+            { "amplit",     FIELD_DOUBLE,   offsetof( SignalItem::SignalSinRise, amplit ) },
+            { "offset",     FIELD_DOUBLE,   offsetof( SignalItem::SignalSinRise, offset ) },
+            { "damping",    FIELD_DOUBLE,   offsetof( SignalItem::SignalSinRise, damping ) }
+        },
+        createItem<SignalItem::SignalSinRise>,
+        getItemData<SignalItem::SignalSinRise>
+    },
+    {
+        "WavSin", 6,
+        {
+            { "freqHz",     FIELD_DOUBLE,   offsetof( SignalItem::SignalWavSin, freqHz ) },
+            { "phiRad",     FIELD_DOUBLE,   offsetof( SignalItem::SignalWavSin, phiRad ) },
+            { "tDelay",     FIELD_DOUBLE,   offsetof( SignalItem::SignalWavSin, tDelay ) },
+            { "amplit",     FIELD_DOUBLE,   offsetof( SignalItem::SignalWavSin, amplit ) },
+            { "offset",     FIELD_DOUBLE,   offsetof( SignalItem::SignalWavSin, offset ) },
+            { "index",      FIELD_UINT8,    offsetof( SignalItem::SignalWavSin, index ) }
+        },
+        createItem<SignalItem::SignalWavSin>,
+        getItemData<SignalItem::SignalWavSin>
+    },
+    {
+        "AmSin", 7,
+        {
+            { "carrierFreqHz",      FIELD_DOUBLE,   offsetof( SignalItem::SignalAmSin, carrierFreqHz ) },
+            { "carrierAmplitude",   FIELD_DOUBLE,   offsetof( SignalItem::SignalAmSin, carrierAmplitude ) },
+            { "carrierOffset",      FIELD_DOUBLE,   offsetof( SignalItem::SignalAmSin, carrierOffset ) },
+            { "carrierTDelay",      FIELD_DOUBLE,   offsetof( SignalItem::SignalAmSin, carrierTDelay ) },
+            { "modulationFreqHz",   FIELD_DOUBLE,   offsetof( SignalItem::SignalAmSin, modulationFreqHz ) },
+            { "modulationPhiRad",   FIELD_DOUBLE,   offsetof( SignalItem::SignalAmSin, modulationPhiRad ) },
+            { "modulationIndex",    FIELD_DOUBLE,   offsetof( SignalItem::SignalAmSin, modulationIndex ) }
+        },
+        createItem<SignalItem::SignalAmSin>,
+        getItemData<SignalItem::SignalAmSin>
+    },
+    {
+        "SinDampSin", 6,
+        {
+            { "freqSinHz",  FIELD_DOUBLE,   offsetof( SignalItem::SignalSinDampSin, freqSinHz ) },
+            { "tPeriodEnv", FIELD_DOUBLE,   offsetof( SignalItem::SignalSinDampSin, tPeriodEnv ) },
+            { "tDelay",     FIELD_DOUBLE,   offsetof( SignalItem::SignalSinDampSin, tDelay ) },
+            { "amplit",     FIELD_DOUBLE,   offsetof( SignalItem::SignalSinDampSin, amplit ) },
+            { "offset",     FIELD_DOUBLE,   offsetof( SignalItem::SignalSinDampSin, offset ) },
+            { "dampingType", FIELD_INT8,    offsetof( SignalItem::SignalSinDampSin, dampingType ) }
+        },
+        createItem<SignalItem::SignalSinDampSin>,
+        getItemData<SignalItem::SignalSinDampSin>
+    },
+    {
+        "TrapDampSin", 9,
+        {
+            { "tPeriod",    FIELD_DOUBLE,   offsetof( SignalItem::SignalTrapDampSin, tPeriod ) },
+            { "tRise",      FIELD_DOUBLE,   offsetof( SignalItem::SignalTrapDampSin, tRise ) },
+            { "tWidth",     FIELD_DOUBLE,   offsetof( SignalItem::SignalTrapDampSin, tWidth ) },
+            { "tFall",      FIELD_DOUBLE,   offsetof( SignalItem::SignalTrapDampSin, tFall ) },
+            { "tDelay",     FIELD_DOUBLE,   offsetof( SignalItem::SignalTrapDampSin, tDelay ) },
+            { "tCross",     FIELD_DOUBLE,   offsetof( SignalItem::SignalTrapDampSin, tCross ) },
+            { "freqHz",     FIELD_DOUBLE,   offsetof( SignalItem::SignalTrapDampSin, freqHz ) },
+            { "amplit",     FIELD_DOUBLE,   offsetof( SignalItem::SignalTrapDampSin, amplit ) },
+            { "offset",     FIELD_DOUBLE,   offsetof( SignalItem::SignalTrapDampSin, offset ) }
+        },
+        createItem<SignalItem::SignalTrapDampSin>,
+        getItemData<SignalItem::SignalTrapDampSin>
+    },
+    {
+        "Noise", 5,
+        {
+            { "noiseType",  FIELD_NOISE_TYPE, offsetof( SignalItem::SignalNoise, noiseType ) },
+            { "gamma",      FIELD_DOUBLE,   offsetof( SignalItem::SignalNoise, gamma ) },
+            { "tDelay",     FIELD_DOUBLE,   offsetof( SignalItem::SignalNoise, tDelay ) },
+            { "amplit",     FIELD_DOUBLE,   offsetof( SignalItem::SignalNoise, amplit ) },
+            { "offset",     FIELD_DOUBLE,   offsetof( SignalItem::SignalNoise, offset ) }
+        },
+        createItem<SignalItem::SignalNoise>,
+        getItemData<SignalItem::SignalNoise>
+    }
+};
+
+
+//!************************************************************************
+//! Add an error at a position of a line
+//!
+//! @returns: nothing
+//!************************************************************************
+void SignalFile::addError
+    (
+    std::vector<Error>& aErrorVec,      //!< errors
+    const size_t        aLine,          //!< line number
+    const char*         aLineStart,     //!< start of the line
+    const char*         aPos,           //!< position of the error
+    const std::string&  aMessage        //!< what is wrong
+    )
+{
+    Error error;
+    error.line = aLine;
+    error.column = static_cast<size_t>( aPos - aLineStart ) + 1;
+    error.message = aMessage;
+
+    aErrorVec.push_back( error );
+}
+
+
+//!************************************************************************
+//! Compute the CRC-32 of data, as used by zip and PNG
+//! Eight bytes are processed at once with eight derived tables
+//! ("slicing-by-8"), reading them as little-endian words.
+//!
+//! @returns: the CRC-32
+//!************************************************************************
+uint32_t SignalFile::getCrc32
+    (
+    const char*         aData,          //!< data
+    const size_t        aLength         //!< data length
+    )
+{
+    typedef std::array<std::array<uint32_t, 256>, 8> CrcTables;
+
+    static const CrcTables CRC_TABLES = []()
+    {
+        CrcTables tables = {};
+
+        for( uint32_t i = 0; i < 256; i++ )
+        {
+            uint32_t crc = i;
+
+            for( int bit = 0; bit < 8; bit++ )
+            {
+                crc = ( crc & 1 ) ? ( 0xEDB88320 ^ ( crc >> 1 ) ) : ( crc >> 1 );
+            }
+
+            tables[0][i] = crc;
+        }
+
+        for( uint32_t i = 0; i < 256; i++ )
+        {
+            for( size_t k = 1; k < tables.size(); k++ )
+            {
+                tables[k][i] = ( tables[k - 1][i] >> 8 ) ^ tables[0][tables[k - 1][i] & 0xFF];
+            }
+        }
+
+        return tables;
+    }();
+
+    uint32_t crc = 0xFFFFFFFF;
+    size_t i = 0;
+
+    for( ; i + 8 <= aLength; i += 8 )
+    {
+        uint32_t low = 0;
+        uint32_t high = 0;
+        memcpy( &low, aData + i, sizeof( low ) );
+        memcpy( &high, aData + i + 4, sizeof( high ) );
+        low ^= crc;
+
+        crc = CRC_TABLES[7][low & 0xFF] ^ CRC_TABLES[6][( low >> 8 ) & 0xFF]
+            ^ CRC_TABLES[5][( low >> 16 ) & 0xFF] ^ CRC_TABLES[4][low >> 24]
+            ^ CRC_TABLES[3][high & 0xFF] ^ CRC_TABLES[2][( high >> 8 ) & 0xFF]
+            ^ CRC_TABLES[1][( high >> 16 ) & 0xFF] ^ CRC_TABLES[0][high >> 24];
+    }
+
+    for( ; i < aLength; i++ )
+    {
+        crc = CRC_TABLES[0][( crc ^ static_cast<uint8_t>( aData[i] ) ) & 0xFF] ^ ( crc >> 8 );
+    }
+
+    return crc ^ 0xFFFFFFFF;
+}
+
+
+//!************************************************************************
+//! Get the schema of a signal type
+//!
+//! @returns: the schema, or nullptr if the type has none
+//!************************************************************************
+const SignalFile::Schema* SignalFile::getSchema
+    (
+    const int           aType           //!< signal type
+    )
+{
+    const int SCHEMAS_COUNT = sizeof( SCHEMA_TABLE ) / sizeof( SCHEMA_TABLE[0] );
+    const int schemaIndex = aType - SignalItem::SIGNAL_TYPE_FIRST;
+
+    return ( schemaIndex >= 0 && schemaIndex < SCHEMAS_COUNT ) ? &SCHEMA_TABLE[schemaIndex] : nullptr;
+}
+
+
+//!************************************************************************
+//! Check if a value can be stored as a parameter of a kind
+//!
+//! @returns: true if the value fits
+//!************************************************************************
+bool SignalFile::isInRange
+    (
+    const FieldKind     aKind,          //!< how the value is stored
+    const double        aValue          //!< value
+    )
+{
+    bool inRange = true;
+
+    switch( aKind )
+    {
+        case FIELD_INT8:
+            inRange = ( aValue >= std::numeric_limits<int8_t>::min() && aValue <= std::numeric_limits<int8_t>::max() );
+            break;
+
+        case FIELD_UINT8:
+            inRange = ( aValue >= 0 && aValue <= std::numeric_limits<uint8_t>::max() );
+            break;
+
+        case FIELD_NOISE_TYPE:
+            inRange = ( aValue >= SignalItem::NOISE_TYPE_DEK && aValue <= SignalItem::NOISE_TYPE_NAG );
+            break;
+
+        case FIELD_CHANNEL:
+            inRange = ( aValue >= -1 && aValue <= std::numeric_limits<int8_t>::max() );
+            break;
+
+        case FIELD_DOUBLE:
+        default:
+            break;
+    }
+
+    return inRange && ( FIELD_DOUBLE == aKind || std::trunc( aValue ) == aValue );
+}
+
+
+//!************************************************************************
+//! Load the records of a binary signal list file
+//! The header is checked first: a file of another version or byte order,
+//! or whose records do not match their checksum, is not read at all.
+//! Records of an unknown type are reported and skipped.
+//!
+//! @returns: nothing
+//!************************************************************************
+void SignalFile::parseBinary
+    (
+    const char*         aData,          //!< file content
+    const size_t        aLength,        //!< file length
+    SignalList&         aSignalList,    //!< read items are appended
+    std::vector<Error>& aErrorVec       //!< records which could not be read
+    )
+{
+    BinaryHeader header;
+    std::string headerError;
+
+    if( aLength < sizeof( header ) )
+    {
+        headerError = "The binary file is too short.";
+    }
+    else
+    {
+        memcpy( &header, aData, sizeof( header ) );
+
+        if( 0 != memcmp( header.magic, BINARY_MAGIC, sizeof( BINARY_MAGIC ) ) )
+        {
+            headerError = "The file is not a binary signal list.";
+        }
+        else if( BYTE_ORDER_MARK != header.byteOrderMark )
+        {
+            headerError = "The binary file was saved with another byte order.";
+        }
+        else if( header.version < 1 || header.version > BINARY_VERSION )
+        {
+            headerError = "The binary file has the unsupported version " + std::to_string( header.version ) + ".";
+        }
+        else if( header.headerSize < sizeof( header ) || header.headerSize > aLength
+              || header.dataSize != aLength - header.headerSize )
+        {
+            headerError = "The binary file is truncated.";
+        }
+        else if( header.dataCrc != getCrc32( aData + header.headerSize, header.dataSize ) )
+        {
+            headerError = "The binary file is corrupted, its checksum does not match.";
+        }
+    }
+
+    if( headerError.size() )
+    {
+        Error error;
+        error.message = headerError;
+        aErrorVec.push_back( error );
+        return;
+    }
+
+    aSignalList.reserve( aSignalList.getSize() + header.itemsCount );
+
+    const char* pos = aData + header.headerSize;
+    const char* end = aData + aLength;
+    double valueArray[FIELDS_MAX] = {};
+
+    for( uint32_t i = 0; i < header.itemsCount; i++ )
+    {
+        BinaryRecord record;
+        std::string recordError;
+
+        if( end - pos < static_cast<ptrdiff_t>( sizeof( record ) ) )
+        {
+            recordError = "is truncated.";
+            pos = end;
+        }
+        else
+        {
+            memcpy( &record, pos, sizeof( record ) );
+            pos += sizeof( record );
+
+            const size_t valuesSize = record.fieldsCount * sizeof( double );
+            const Schema* schema = getSchema( record.type );
+
+            if( end - pos < static_cast<ptrdiff_t>( valuesSize ) )
+            {
+                recordError = "is truncated.";
+            }
+            else if( !schema )
+            {
+                recordError = "has an unknown signal type.";
+            }
+            else if( record.fieldsCount != schema->fieldsCount )
+            {
+                recordError = std::string( "does not have the parameters of " ) + schema->name + ".";
+            }
+            else if( header.version >= 2 && !isInRange( FIELD_CHANNEL, record.channel ) )
+            {
+                recordError = std::string( "has an out-of-range " ) + CHANNEL_NAME + ".";
+            }
+            else
+            {
+                memcpy( valueArray, pos, valuesSize );
+
+                for( uint8_t k = 0; recordError.empty() && k < schema->fieldsCount; k++ )
+                {
+                    if( !isInRange( schema->fieldArray[k].kind, valueArray[k] ) )
+                    {
+                        recordError = std::string( "has an out-of-range " ) + schema->fieldArray[k].name + ".";
+                    }
+                }
+
+                if( recordError.empty() )
+                {
+                    SignalItem item = schema->createItem( *schema, valueArray );
+                    item.setChannel( ( header.version >= 2 ) ? record.channel : -1 );
+                    aSignalList.append( std::move( item ) );
+                }
+            }
+
+            pos += std::min<size_t>( valuesSize, end - pos );
+        }
+
+        if( recordError.size() )
+        {
+            Error error;
+            error.message = "Record " + std::to_string( i + 1 ) + " " + recordError;
+            aErrorVec.push_back( error );
+
+            if( pos == end )
+            {
+                break;
+            }
+        }
+    }
+}
+
+
+//!************************************************************************
+//! Parse the text of a signal list file
+//! Each line is checked against the schema of its type and appended to
+//! the list, without copying or splitting it first. A parameter after
+//! those of the type is the output channel of the item. Blank lines are
+//! skipped; lines which are not valid are reported and skipped.
+//!
+//! @returns: nothing
+//!************************************************************************
+void SignalFile::parseText
+    (
+    const char*         aData,          //!< file content
+    const size_t        aLength,        //!< file length
+    SignalList&         aSignalList,    //!< read items are appended
+    std::vector<Error>& aErrorVec       //!< lines which could not be read
+    )
+{
+    const char* pos = aData;
+    const char* end = aData + aLength;
+
+    aSignalList.reserve( aSignalList.getSize() + std::count( pos, end, '\n' ) + 1 );
+
+    double valueArray[FIELDS_MAX] = {};
+    size_t lineNr = 0;
+
+    while( pos < end )
+    {
+        lineNr++;
+
+        const char* lineStart = pos;
+        const char* lineEnd = static_cast<const char*>( memchr( pos, '\n', end - pos ) );
+
+        if( lineEnd )
+        {
+            pos = lineEnd + 1;
+        }
+        else
+        {
+            lineEnd = end;
+            pos = end;
+        }
+
+        if( lineEnd > lineStart && '\r' == *( lineEnd - 1 ) )
+        {
+            lineEnd--;
+        }
+
+        const char* crt = skipBlanks( lineStart, lineEnd );
+
+        if( crt == lineEnd )
+        {
+            continue;
+        }
+
+        int typeValue = SignalItem::SIGNAL_TYPE_INVALID;
+        const std::from_chars_result typeResult = std::from_chars( crt, lineEnd, typeValue );
+        const Schema* schemaPtr = ( std::errc() == typeResult.ec ) ? getSchema( typeValue ) : nullptr;
+
+        if( !schemaPtr )
+        {
+            addError( aErrorVec, lineNr, lineStart, crt, "Unknown signal type." );
+            continue;
+        }
+
+        const Schema& schema = *schemaPtr;
+        bool lineOk = true;
+
+        crt = skipBlanks( typeResult.ptr, lineEnd );
+
+        for( uint8_t i = 0; lineOk && i < schema.fieldsCount; i++ )
+        {
+            const Field& field = schema.fieldArray[i];
+
+            if( crt == lineEnd )
+            {
+                addError( aErrorVec, lineNr, lineStart, crt, std::string( "Missing " ) + field.name + " of " + schema.name + "." );
+                lineOk = false;
+            }
+            else if( FIELD_DELIMITER != *crt )
+            {
+                addError( aErrorVec, lineNr, lineStart, crt, std::string( "Expected a comma before " ) + field.name + "." );
+                lineOk = false;
+            }
+            else
+            {
+                crt = skipBlanks( crt + 1, lineEnd );
+
+                bool inRange = true;
+                const char* valueEnd = parseValue( crt, lineEnd, field.kind, valueArray[i], inRange );
+
+                if( !valueEnd )
+                {
+                    addError( aErrorVec, lineNr, lineStart, crt, std::string( "Invalid " ) + field.name + " value." );
+                    lineOk = false;
+                }
+                else if( !inRange )
+                {
+                    addError( aErrorVec, lineNr, lineStart, crt, std::string( "Value of " ) + field.name + " is out of range." );
+                    lineOk = false;
+                }
+                else
+                {
+                    crt = skipBlanks( valueEnd, lineEnd );
+                }
+            }
+        }
+
+        double channel = -1;
+
+        if( lineOk && crt != lineEnd && FIELD_DELIMITER == *crt )
+        {
+            const char* channelPos = skipBlanks( crt + 1, lineEnd );
+            bool inRange = true;
+            const char* valueEnd = parseValue( channelPos, lineEnd, FIELD_CHANNEL, channel, inRange );
+
+            if( !valueEnd )
+            {
+                addError( aErrorVec, lineNr, lineStart, channelPos, std::string( "Invalid " ) + CHANNEL_NAME + " value." );
+                lineOk = false;
+            }
+            else if( !inRange )
+            {
+                addError( aErrorVec, lineNr, lineStart, channelPos, std::string( "Value of " ) + CHANNEL_NAME + " is out of range." );
+                lineOk = false;
+            }
+            else
+            {
+                crt = skipBlanks( valueEnd, lineEnd );
+            }
+        }
+
+        if( lineOk && crt != lineEnd )
+        {
+            addError( aErrorVec, lineNr, lineStart, crt, std::string( "Too many parameters for " ) + schema.name + "." );
+            lineOk = false;
+        }
+
+        if( lineOk )
+        {
+            SignalItem item = schema.createItem( schema, valueArray );
+            item.setChannel( static_cast<int8_t>( channel ) );
+            aSignalList.append( std::move( item ) );
+        }
+    }
+}
+
+
+//!************************************************************************
+//! Parse a parameter value
+//! A leading plus sign is accepted, as when the value was typed.
+//!
+//! @returns: the end of the value, or nullptr if there is no valid value
+//!************************************************************************
+const char* SignalFile::parseValue
+    (
+    const char*         aPos,           //!< start of the value
+    const char*         aEnd,           //!< end of the line
+    const FieldKind     aKind,          //!< how the value is stored
+    double&             aValue,         //!< parsed value
+    bool&               aInRange        //!< false if the value does not fit its kind
+    )
+{
+    if( aEnd - aPos > 1 && '+' == *aPos && '-' != *( aPos + 1 ) )
+    {
+        aPos++;
+    }
+
+    std::from_chars_result result;
+    aInRange = true;
+
+    if( FIELD_DOUBLE == aKind )
+    {
+        result = std::from_chars( aPos, aEnd, aValue );
+        aInRange = ( std::errc::result_out_of_range != result.ec );
+    }
+    else
+    {
+        long value = 0;
+        result = std::from_chars( aPos, aEnd, value );
+        aValue = static_cast<double>( value );
+        aInRange = ( std::errc::result_out_of_range != result.ec ) && isInRange( aKind, aValue );
+    }
+
+    return ( std::errc::invalid_argument == result.ec ) ? nullptr : result.ptr;
+}
+
+
+//!************************************************************************
+//! Get the parameter values of an item, as its schema stores them
+//!
+//! @returns: nothing
+//!************************************************************************
+void SignalFile::readFields
+    (
+    const Schema&       aSchema,        //!< schema of the type
+    const SignalItem&   aItem,          //!< item of the type
+    double*             aValues         //!< parameter values, in the file order
+    )
+{
+    const char* base = static_cast<const char*>( aSchema.getItemData( aItem ) );
+
+    for( uint8_t i = 0; i < aSchema.fieldsCount; i++ )
+    {
+        const Field& field = aSchema.fieldArray[i];
+        const char* src = base + field.offset;
+
+        switch( field.kind )
+        {
+            case FIELD_DOUBLE:
+                aValues[i] = *reinterpret_cast<const double*>( src );
+                break;
+
+            case FIELD_INT8:
+                aValues[i] = *reinterpret_cast<const int8_t*>( src );
+                break;
+
+            case FIELD_UINT8:
+                aValues[i] = *reinterpret_cast<const uint8_t*>( src );
+                break;
+
+            case FIELD_NOISE_TYPE:
+                aValues[i] = *reinterpret_cast<const SignalItem::NoiseType*>( src );
+                break;
+
+            default:
+                break;
+        }
+    }
+}
+
+
+//!************************************************************************
+//! Read a signal list file mapped in memory
+//! Binary files are recognized by their content, whatever their name.
+//!
+//! @returns: true if the file could be opened
+//!************************************************************************
+bool SignalFile::readFile
+    (
+    const std::string&  aFileName,      //!< file name
+    SignalList&         aSignalList,    //!< read items are appended
+    std::vector<Error>& aErrorVec       //!< lines which could not be read
+    )
+{
+    QFile file( QString::fromStdString( aFileName ) );
+    const bool fileOpened = file.open( QIODevice::ReadOnly );
+
+    if( fileOpened )
+    {
+        const qint64 fileSize = file.size();
+        uchar* mappedData = ( fileSize > 0 ) ? file.map( 0, fileSize ) : nullptr;
+        QByteArray fileContent;
+
+        const char* data = reinterpret_cast<const char*>( mappedData );
+
+        if( !mappedData )
+        {
+            // files which cannot be mapped are read instead
+            fileContent = file.readAll();
+            data = fileContent.constData();
+        }
+
+        const size_t length = mappedData ? static_cast<size_t>( fileSize ) : static_cast<size_t>( fileContent.size() );
+
+        if( length >= sizeof( BINARY_MAGIC ) && 0 == memcmp( data, BINARY_MAGIC, sizeof( BINARY_MAGIC ) ) )
+        {
+            parseBinary( data, length, aSignalList, aErrorVec );
+        }
+        else
+        {
+            parseText( data, length, aSignalList, aErrorVec );
+        }
+
+        if( mappedData )
+        {
+            file.unmap( mappedData );
+        }
+
+        file.close();
+    }
+
+    return fileOpened;
+}
+
+
+//!************************************************************************
+//! Skip spaces and tabs
+//!
+//! @returns: the first position which is not blank
+//!************************************************************************
+const char* SignalFile::skipBlanks
+    (
+    const char*         aPos,           //!< current position
+    const char*         aEnd            //!< end of the line
+    )
+{
+    while( aPos < aEnd && ( ' ' == *aPos || '\t' == *aPos ) )
+    {
+        aPos++;
+    }
+
+    return aPos;
+}
+
+
+//!************************************************************************
+//! Format the records of a binary signal list file
+//! Items without a schema, i.e. SMC traces, are not written.
+//!
+//! @returns: nothing
+//!************************************************************************
+void SignalFile::writeBinary
+    (
+    const SignalList&   aSignalList,    //!< written items
+    std::string&        aContent        //!< file content
+    )
+{
+    BinaryHeader header;
+    memset( &header, 0, sizeof( header ) );
+    memcpy( header.magic, BINARY_MAGIC, sizeof( BINARY_MAGIC ) );
+    header.version = BINARY_VERSION;
+    header.headerSize = sizeof( header );
+    header.byteOrderMark = BYTE_ORDER_MARK;
+
+    aContent.assign( sizeof( header ), 0 );
+    aContent.reserve( sizeof( header ) + aSignalList.getSize() * ( sizeof( BinaryRecord ) + FIELDS_MAX * sizeof( double ) ) );
+
+    double valueArray[FIELDS_MAX] = {};
+
+    for( size_t i = 0; i < aSignalList.getSize(); i++ )
+    {
+        const SignalItem& item = aSignalList.at( i );
+        const Schema* schema = getSchema( item.getType() );
+
+        if( schema )
+        {
+            BinaryRecord record;
+            memset( &record, 0, sizeof( record ) );
+            record.type = item.getType();
+            record.fieldsCount = schema->fieldsCount;
+            record.channel = item.getChannel();
+
+            readFields( *schema, item, valueArray );
+
+            aContent.append( reinterpret_cast<const char*>( &record ), sizeof( record ) );
+            aContent.append( reinterpret_cast<const char*>( valueArray ), schema->fieldsCount * sizeof( double ) );
+            header.itemsCount++;
+        }
+    }
+
+    header.dataSize = aContent.size() - sizeof( header );
+    header.dataCrc = getCrc32( aContent.data() + sizeof( header ), header.dataSize );
+
+    memcpy( &aContent[0], &header, sizeof( header ) );
+}
+
+
+//!************************************************************************
+//! Write a signal list file
+//!
+//! @returns: true if the file was written
+//!************************************************************************
+bool SignalFile::writeFile
+    (
+    const std::string&  aFileName,      //!< file name
+    const SignalList&   aSignalList,    //!< written items
+    const Format        aFormat         //!< file format
+    )
+{
+    std::string content;
+
+    if( FORMAT_BINARY == aFormat )
+    {
+        writeBinary( aSignalList, content );
+    }
+    else
+    {
+        writeText( aSignalList, content );
+    }
+
+    std::ofstream outputFile( aFileName, std::ios::binary );
+
+    if( outputFile.is_open() )
+    {
+        outputFile.write( content.data(), content.size() );
+        outputFile.close();
+    }
+
+    return !outputFile.fail();
+}
+
+
+//!************************************************************************
+//! Format the lines of a text signal list file
+//! Values are written with the shortest representation which reads back
+//! exactly, so that the text holds the same values as the binary format.
+//! Items without a schema, i.e. SMC traces, are not written.
+//!
+//! @returns: nothing
+//!************************************************************************
+void SignalFile::writeText
+    (
+    const SignalList&   aSignalList,    //!< written items
+    std::string&        aContent        //!< file content
+    )
+{
+    aContent.clear();
+
+    const size_t VALUE_LENGTH_MAX = 32;
+    char valueString[VALUE_LENGTH_MAX];
+    double valueArray[FIELDS_MAX] = {};
+
+    for( size_t i = 0; i < aSignalList.getSize(); i++ )
+    {
+        const SignalItem& item = aSignalList.at( i );
+        const Schema* schema = getSchema( item.getType() );
+
+        if( schema )
+        {
+            readFields( *schema, item, valueArray );
+
+            aContent += std::to_string( item.getType() );
+
+            for( uint8_t k = 0; k < schema->fieldsCount; k++ )
+            {
+                const std::to_chars_result result = std::to_chars( valueString, valueString + VALUE_LENGTH_MAX, valueArray[k] );
+
+                aContent += TEXT_DELIMITER;
+                aContent.append( valueString, result.ptr );
+            }
+
+            if( item.getChannel() >= 0 )
+            {
+                aContent += TEXT_DELIMITER;
+                aContent += std::to_string( item.getChannel() );
+            }
+
+            aContent += "\n";
+        }
+    }
+}
@@ -0,0 +1,297 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2025 Mihai Ursu                                                 //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+/*
+SignalFile.h
+This file contains the definitions for reading and writing signal list files.
+*/
+
+#ifndef SignalFile_h
+#define SignalFile_h
+
+#include "SignalItem.h"
+#include "SignalList.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+//************************************************************************
+// Class for reading and writing signal list files
+//
+// A text file holds one signal item per line, as its type followed by
+// its parameters, all separated by commas; an item routed to an output
+// channel has the channel as its last parameter. A binary file holds a
+// header followed by one fixed-size record per item, as its type, its
+// channel and the count of its parameters followed by their values as
+// doubles, so that it is loaded without parsing. Both hold the same
+// values: the text is written with the shortest representation which
+// reads back exactly.
+//
+// The parameters of each type are described by a schema table, so that
+// the same code reads and writes every type, straight from the file
+// mapped in memory into the signal list.
+//************************************************************************
+class SignalFile
+{
+    //************************************************************************
+    // constants and types
+    //************************************************************************
+    public:
+        typedef enum : uint8_t
+        {
+            FORMAT_TEXT,
+            FORMAT_BINARY
+        }Format;
+
+        // line which could not be read; line and column are 0 for binary
+        // files, whose messages name the record
+        struct Error
+        {
+            size_t      line;           //!< line number, from 1
+            size_t      column;         //!< column number, from 1
+            std::string message;        //!< what is wrong
+
+            Error()
+            {
+                line = 0;
+                column = 0;
+            }
+        };
+
+    private:
+        static const char FIELD_DELIMITER = ',';
+        static constexpr const char* TEXT_DELIMITER = ", ";     //!< parameter delimiter written
+        static constexpr const char* CHANNEL_NAME = "channel";  //!< name of the optional last parameter
+
+        static const uint8_t FIELDS_MAX = 9;        //!< most parameters of a type
+
+        static constexpr char BINARY_MAGIC[4] = { 'S', 'G', 'S', 'L' };    //!< start of binary files
+        static const uint16_t BINARY_VERSION = 2;                           //!< version of the binary files written, 2 added the channel
+        static const uint32_t BYTE_ORDER_MARK = 0x01020304;                 //!< as written by the machine which saved the file
+
+        // header of binary files
+        struct BinaryHeader
+        {
+            char        magic[4];       //!< BINARY_MAGIC
+            uint16_t    version;        //!< format version
+            uint16_t    headerSize;     //!< size of the header, the records follow it
+            uint32_t    byteOrderMark;  //!< BYTE_ORDER_MARK in the byte order of the values
+            uint32_t    itemsCount;     //!< number of records
+            uint64_t    dataSize;       //!< size of the records
+            uint32_t    dataCrc;        //!< CRC-32 of the records
+            uint32_t    reserved;       //!< 0
+        };
+
+        // start of a binary record, followed by the parameter values
+        struct BinaryRecord
+        {
+            uint8_t     type;           //!< signal type
+            uint8_t     fieldsCount;    //!< number of parameter values
+            int8_t      channel;        //!< output channel, -1 for all channels; 0 in version 1
+            uint8_t     reserved[5];    //!< 0
+        };
+
+        typedef enum : uint8_t
+        {
+            FIELD_DOUBLE,
+            FIELD_INT8,
+            FIELD_UINT8,
+            FIELD_NOISE_TYPE,
+            FIELD_CHANNEL
+        }FieldKind;
+
+        // parameter of a signal type
+        struct Field
+        {
+            const char* name;           //!< parameter name
+            FieldKind   kind;           //!< how the parameter is stored
+            size_t      offset;         //!< offset in the signal data
+        };
+
+        // parameters of a signal type, in the file order
+        struct Schema
+        {
+            const char* name;                           //!< signal type name
+            uint8_t     fieldsCount;                    //!< number of parameters
+            Field       fieldArray[FIELDS_MAX];         //!< parameters
+            SignalItem  ( *createItem )( const Schema&, const double* );   //!< item made of the parameter values
+            const void* ( *getItemData )( const SignalItem& );              //!< signal data of an item
+        };
+
+        static const Schema SCHEMA_TABLE[];         //!< schemas of the types, from SIGNAL_TYPE_FIRST
+
+
+    //************************************************************************
+    // functions
+    //************************************************************************
+    public:
+        static void parseBinary
+            (
+            const char*         aData,          //!< file content
+            const size_t        aLength,        //!< file length
+            SignalList&         aSignalList,    //!< read items are appended
+            std::vector<Error>& aErrorVec       //!< records which could not be read
+            );
+
+        static void parseText
+            (
+            const char*         aData,          //!< file content
+            const size_t        aLength,        //!< file length
+            SignalList&         aSignalList,    //!< read items are appended
+            std::vector<Error>& aErrorVec       //!< lines which could not be read
+            );
+
+        static bool readFile
+            (
+            const std::string&  aFileName,      //!< file name
+            SignalList&         aSignalList,    //!< read items are appended
+            std::vector<Error>& aErrorVec       //!< lines which could not be read
+            );
+
+        static bool writeFile
+            (
+            const std::string&  aFileName,      //!< file name
+            const SignalList&   aSignalList,    //!< written items
+            const Format        aFormat         //!< file format
+            );
+
+        static void writeBinary
+            (
+            const SignalList&   aSignalList,    //!< written items
+            std::string&        aContent        //!< file content
+            );
+
+        static void writeText
+            (
+            const SignalList&   aSignalList,    //!< written items
+            std::string&        aContent        //!< file content
+            );
+
+    private:
+        static void addError
+            (
+            std::vector<Error>& aErrorVec,      //!< errors
+            const size_t        aLine,          //!< line number
+            const char*         aLineStart,     //!< start of the line
+            const char*         aPos,           //!< position of the error
+            const std::string&  aMessage        //!< what is wrong
+            );
+
+        static uint32_t getCrc32
+            (
+            const char*         aData,          //!< data
+            const size_t        aLength         //!< data length
+            );
+
+        static const Schema* getSchema
+            (
+            const int           aType           //!< signal type
+            );
+
+        static bool isInRange
+            (
+            const FieldKind     aKind,          //!< how the value is stored
+            const double        aValue          //!< value
+            );
+
+        static const char* parseValue
+            (
+            const char*         aPos,           //!< start of the value
+            const char*         aEnd,           //!< end of the line
+            const FieldKind     aKind,          //!< how the value is stored
+            double&             aValue,         //!< parsed value
+            bool&               aInRange        //!< false if the value does not fit its kind
+            );
+
+        static void readFields
+            (
+            const Schema&       aSchema,        //!< schema of the type
+            const SignalItem&   aItem,          //!< item of the type
+            double*             aValues         //!< parameter values, in the file order
+            );
+
+        static const char* skipBlanks
+            (
+            const char*         aPos,           //!< current position
+            const char*         aEnd            //!< end of the line
+            );
+
+        //!************************************************************************
+        //! Make an item from the parameter values, stored as its schema says
+        //!
+        //! @returns: the item
+        //!************************************************************************
+        template<typename T>
+        static SignalItem createItem
+            (
+            const Schema&   aSchema,        //!< schema of the type
+            const double*   aValues         //!< parameter values, in the file order
+            )
+        {
+            T sig;
+            char* base = reinterpret_cast<char*>( &sig );
+
+            for( uint8_t i = 0; i < aSchema.fieldsCount; i++ )
+            {
+                const Field& field = aSchema.fieldArray[i];
+                char* dest = base + field.offset;
+
+                switch( field.kind )
+                {
+                    case FIELD_DOUBLE:
+                        *reinterpret_cast<double*>( dest ) = aValues[i];
+                        break;
+
+                    case FIELD_INT8:
+                        *reinterpret_cast<int8_t*>( dest ) = static_cast<int8_t>( aValues[i] );
+                        break;
+
+                    case FIELD_UINT8:
+                        *reinterpret_cast<uint8_t*>( dest ) = static_cast<uint8_t>( aValues[i] );
+                        break;
+
+                    case FIELD_NOISE_TYPE:
+                        *reinterpret_cast<SignalItem::NoiseType*>( dest ) = static_cast<SignalItem::NoiseType>( static_cast<int>( aValues[i] ) );
+                        break;
+
+                    default:
+                        break;
+                }
+            }
+
+            return SignalItem( sig );
+        }
+
+        //!************************************************************************
+        //! Get the signal data of an item of type T, as its schema addresses it
+        //!
+        //! @returns: the signal data
+        //!************************************************************************
+        template<typename T>
+        static const void* getItemData
+            (
+            const SignalItem&   aItem           //!< item
+            )
+        {
+            return &aItem.getSignalData<T>();
+        }
+};
+
+#endif // SignalFile_h
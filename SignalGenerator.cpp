@@ -24,16 +24,23 @@ This file contains the sources for the signal generator.
 #include "./ui_SignalGenerator.h"
 
 #include <QFileDialog>
+#include <QInputDialog>
 #include <QTabBar>
 
 #include <algorithm>
 #include <cctype>
 #include <cmath>
+#include <iomanip>
 #include <iostream>
+#include <iterator>
 #include <fstream>
 #include <stdexcept>
 
+#include "FourierSpectrum.h"
 #include "NoisePwrSpectrum.h"
+#include "ResponseSpectrum.h"
+#include "SmcIntegration.h"
+#include "StrongMotionReader.h"
 
 
 //!************************************************************************
@@ -51,13 +58,26 @@ SignalGenerator::SignalGenerator
     , mSignalStarted( false )
     , mSignalPaused( false )
     , mSignalIsSmc( false )
-    , mEditedSignal( nullptr )
+    , mSignalContinuous( false )
+    , mSignalBandLimited( false )
+    , mChannelArrayMode( CHANNEL_ARRAY_OFF )
+    , mChannelArrayValues( "0, 0" )
+    , mChannelArrayFreqHz( 1000 )
     , mIsSignalEdited( false )
     , mDevices( new QMediaDevices( this ) )
+    , mRequiredChannelCount( 0 )
+    , mOutputSampleRate( 0 )
+    , mOutputSampleFormat( QAudioFormat::Unknown )
     , mAudioBufferLength( 30 )
     , mAudioBufferProgress( 0 )
     , mAudioBufferTimer( new QTimer( this ) )
     , mAudioBufferCounter( 0 )
+    , mSmcPlayedDataGroup( new QActionGroup( this ) )
+    , mSmcPlayedDataType( Smc::DATA_TYPE_FILE_CORRECTED_ACCELEROGRAM )
+    , mSmcHighPassCornerHz( SmcIntegration::HIGH_PASS_CORNER_HZ_DEFAULT )
+    , mSmcSpeedUp( 1 )
+    , mSmcPlaylistGapSeconds( SmcPlaylist::GAP_SECONDS_DEFAULT )
+    , mSmcPlaylistLoop( false )
 {
     mMainUi->setupUi( this );
 
@@ -253,9 +273,30 @@ SignalGenerator::SignalGenerator
     //****************************************
     connect( mMainUi->actionNew, &QAction::triggered, this, &SignalGenerator::handleSignalNew );
     connect( mMainUi->actionOpen, &QAction::triggered, this, &SignalGenerator::handleSignalOpen );
+    connect( mMainUi->actionCue, &QAction::triggered, this, &SignalGenerator::handleSignalCue );
+    connect( mMainUi->actionContinuous, &QAction::toggled, this, &SignalGenerator::handleSignalContinuous );
+    connect( mMainUi->actionBandLimited, &QAction::toggled, this, &SignalGenerator::handleSignalBandLimited );
+    connect( mMainUi->actionOutputFormat, &QAction::triggered, this, &SignalGenerator::handleOutputFormat );
+    connect( mMainUi->actionSignalChannel, &QAction::triggered, this, &SignalGenerator::handleSignalChannel );
+    connect( mMainUi->actionChannelArray, &QAction::triggered, this, &SignalGenerator::handleSignalChannelArray );
     connect( mMainUi->actionExit, &QAction::triggered, this, &SignalGenerator::handleExit );
 
     connect( mMainUi->actionSmcOpen, &QAction::triggered, this, &SignalGenerator::handleSmcOpen );
+    connect( mMainUi->actionSmcOpenPlaylist, &QAction::triggered, this, &SignalGenerator::handleSmcOpenPlaylist );
+    connect( mMainUi->actionSmcPlaylistGap, &QAction::triggered, this, &SignalGenerator::handleSmcPlaylistGap );
+    connect( mMainUi->actionSmcPlaylistLoop, &QAction::toggled, this, &SignalGenerator::handleSmcPlaylistLoop );
+
+    mSmcPlayedDataGroup->addAction( mMainUi->actionSmcPlayAcceleration );
+    mSmcPlayedDataGroup->addAction( mMainUi->actionSmcPlayVelocity );
+    mSmcPlayedDataGroup->addAction( mMainUi->actionSmcPlayDisplacement );
+    mSmcPlayedDataGroup->setExclusive( true );
+    connect( mSmcPlayedDataGroup, &QActionGroup::triggered, this, &SignalGenerator::handleSmcPlayedDataChanged );
+
+    connect( mMainUi->actionSmcSpeedUp, &QAction::triggered, this, &SignalGenerator::handleSmcSpeedUp );
+    connect( mMainUi->actionSmcHighPass, &QAction::triggered, this, &SignalGenerator::handleSmcHighPass );
+    connect( mMainUi->actionSmcExport, &QAction::triggered, this, &SignalGenerator::handleSmcExport );
+    connect( mMainUi->actionSmcResponseSpectrum, &QAction::triggered, this, &SignalGenerator::handleSmcResponseSpectrum );
+    connect( mMainUi->actionSmcFourierSpectrum, &QAction::triggered, this, &SignalGenerator::handleSmcFourierSpectrum );
 
     connect( mMainUi->actionAbout, &QAction::triggered, this, &SignalGenerator::handleAbout );
 
@@ -280,30 +321,77 @@ SignalGenerator::~SignalGenerator()
 
 
 //!************************************************************************
-//! Check if an integer value is valid
+//! Format a string for a signal of any type
+//! The output channel of a signal routed to one channel follows its
+//! parameters, as in the signal files.
 //!
-//! @returns: true if valid
+//! @returns signal string with comma separated parameters, empty for SMC
 //!************************************************************************
-bool SignalGenerator::checkValidInteger
+QString SignalGenerator::createSignalString
     (
-    const int16_t aIntValue         //!< integer value
+    const SignalItem&   aSignal     //!< a signal
     ) const
 {
-    return ( aIntValue != mSmc.mNoValueInteger );
-}
+    QString lineString;
 
+    switch( aSignal.getType() )
+    {
+        case SignalItem::SIGNAL_TYPE_TRIANGLE:
+            lineString = createSignalStringTriangle( aSignal.getSignalDataTriangle() );
+            break;
 
-//!************************************************************************
-//! Check if a real value is valid
-//!
-//! @returns: true if valid
-//!************************************************************************
-bool SignalGenerator::checkValidReal
-    (
-    const double aRealValue         //!< real value
-    ) const
-{
-    return ( std::fabs( aRealValue - mSmc.mNoValueReal ) > 1.e-7 );
+        case SignalItem::SIGNAL_TYPE_RECTANGLE:
+            lineString = createSignalStringRectangle( aSignal.getSignalDataRectangle() );
+            break;
+
+        case SignalItem::SIGNAL_TYPE_PULSE:
+            lineString = createSignalStringPulse( aSignal.getSignalDataPulse() );
+            break;
+
+        case SignalItem::SIGNAL_TYPE_RISEFALL:
+            lineString = createSignalStringRiseFall( aSignal.getSignalDataRiseFall() );
+            break;
+
+        case SignalItem::SIGNAL_TYPE_SINDAMP:
+            lineString = createSignalStringSinDamp( aSignal.getSignalDataSinDamp() );
+            break;
+
+        case SignalItem::SIGNAL_TYPE_SINRISE:
+            lineString = createSignalStringSinRise( aSignal.getSignalDataSinRise() );
+            break;
+
+        case SignalItem::SIGNAL_TYPE_WAVSIN:
+            lineString = createSignalStringWavSin( aSignal.getSignalDataWavSin() );
+            break;
+
+        case SignalItem::SIGNAL_TYPE_AMSIN:
+            lineString = createSignalStringAmSin( aSignal.getSignalDataAmSin() );
+            break;
+
+        case SignalItem::SIGNAL_TYPE_SINDAMPSIN:
+            lineString = createSignalStringSinDampSin( aSignal.getSignalDataSinDampSin() );
+            break;
+
+        case SignalItem::SIGNAL_TYPE_TRAPDAMPSIN:
+            lineString = createSignalStringTrapDampSin( aSignal.getSignalDataTrapDampSin() );
+            break;
+
+        case SignalItem::SIGNAL_TYPE_NOISE:
+            lineString = createSignalStringNoise( aSignal.getSignalDataNoise() );
+            break;
+
+        case SignalItem::SIGNAL_TYPE_SMC:
+            // intentionally do nothing
+        default:
+            break;
+    }
+
+    if( lineString.size() && aSignal.getChannel() >= 0 )
+    {
+        lineString += SUBSTR_DELIMITER + QString::number( aSignal.getChannel() );
+    }
+
+    return lineString;
 }
 
 
@@ -314,7 +402,7 @@ bool SignalGenerator::checkValidReal
 //!************************************************************************
 QString SignalGenerator::createSignalStringTriangle
     (
-    const SignalItem::SignalTriangle    aSignal     //!< a Triangle signal
+    const SignalItem::SignalTriangle&   aSignal     //!< a Triangle signal
     ) const
 {
     QString lineString = QString::number( aSignal.type );
@@ -335,7 +423,7 @@ QString SignalGenerator::createSignalStringTriangle
 //!************************************************************************
 QString SignalGenerator::createSignalStringRectangle
     (
-    const SignalItem::SignalRectangle   aSignal     //!< a Rectangle signal
+    const SignalItem::SignalRectangle&  aSignal     //!< a Rectangle signal
     ) const
 {
     QString lineString = QString::number( aSignal.type );
@@ -355,7 +443,7 @@ QString SignalGenerator::createSignalStringRectangle
 //!************************************************************************
 QString SignalGenerator::createSignalStringPulse
     (
-    const SignalItem::SignalPulse       aSignal     //!< a Pulse signal
+    const SignalItem::SignalPulse&      aSignal     //!< a Pulse signal
     ) const
 {
     QString lineString = QString::number( aSignal.type );
@@ -377,7 +465,7 @@ QString SignalGenerator::createSignalStringPulse
 //!************************************************************************
 QString SignalGenerator::createSignalStringRiseFall
     (
-    const SignalItem::SignalRiseFall    aSignal     //!< a RiseFall signal
+    const SignalItem::SignalRiseFall&   aSignal     //!< a RiseFall signal
     ) const
 {
     QString lineString = QString::number( aSignal.type );
@@ -399,7 +487,7 @@ QString SignalGenerator::createSignalStringRiseFall
 //!************************************************************************
 QString SignalGenerator::createSignalStringSinDamp
     (
-    const SignalItem::SignalSinDamp     aSignal     //!< a SinDamp signal
+    const SignalItem::SignalSinDamp&    aSignal     //!< a SinDamp signal
     ) const
 {
     QString lineString = QString::number( aSignal.type );
@@ -420,7 +508,7 @@ QString SignalGenerator::createSignalStringSinDamp
 //!************************************************************************
 QString SignalGenerator::createSignalStringSinRise
     (
-    const SignalItem::SignalSinRise     aSignal     //!< a SinRise signal
+    const SignalItem::SignalSinRise&    aSignal     //!< a SinRise signal
     ) const
 {
     QString lineString = QString::number( aSignal.type );
@@ -442,7 +530,7 @@ QString SignalGenerator::createSignalStringSinRise
 //!************************************************************************
 QString SignalGenerator::createSignalStringWavSin
     (
-    const SignalItem::SignalWavSin      aSignal     //!< a WavSin signal
+    const SignalItem::SignalWavSin&     aSignal     //!< a WavSin signal
     ) const
 {
     QString lineString = QString::number( aSignal.type );
@@ -463,7 +551,7 @@ QString SignalGenerator::createSignalStringWavSin
 //!************************************************************************
 QString SignalGenerator::createSignalStringAmSin
     (
-    const SignalItem::SignalAmSin       aSignal     //!< a AmSin signal
+    const SignalItem::SignalAmSin&      aSignal     //!< a AmSin signal
     ) const
 {
     QString lineString = QString::number( aSignal.type );
@@ -485,7 +573,7 @@ QString SignalGenerator::createSignalStringAmSin
 //!************************************************************************
 QString SignalGenerator::createSignalStringSinDampSin
     (
-    const SignalItem::SignalSinDampSin  aSignal     //!< a SinDampSin signal
+    const SignalItem::SignalSinDampSin& aSignal     //!< a SinDampSin signal
     ) const
 {
     QString lineString = QString::number( aSignal.type );
@@ -506,7 +594,7 @@ QString SignalGenerator::createSignalStringSinDampSin
 //!************************************************************************
 QString SignalGenerator::createSignalStringTrapDampSin
     (
-    const SignalItem::SignalTrapDampSin aSignal     //!< a TrapDampSin signal
+    const SignalItem::SignalTrapDampSin& aSignal    //!< a TrapDampSin signal
     ) const
 {
     QString lineString = QString::number( aSignal.type );
@@ -530,7 +618,7 @@ QString SignalGenerator::createSignalStringTrapDampSin
 //!************************************************************************
 QString SignalGenerator::createSignalStringNoise
     (
-    const SignalItem::SignalNoise       aSignal     //!< a Noise signal
+    const SignalItem::SignalNoise&      aSignal     //!< a Noise signal
     ) const
 {
     QString lineString = QString::number( aSignal.type );
@@ -551,28 +639,90 @@ QString SignalGenerator::createSignalStringNoise
 //!************************************************************************
 void SignalGenerator::createSmcSignal()
 {
-    mAudioBufferLength = mSmc.mDataLengthSeconds;
+    // time-align the components only if all of them have a known start time
+    bool alignComponents = true;
+    double earliestStart = 0;
+
+    for( size_t i = 0; i < mSmcVector.size(); i++ )
+    {
+        alignComponents = alignComponents && mSmcVector.at( i ).hasRecordStartTime();
+        double crtStart = mSmcVector.at( i ).getRecordStartSeconds();
+
+        if( 0 == i || crtStart < earliestStart )
+        {
+            earliestStart = crtStart;
+        }
+    }
+
+    // acceleration keeps a fixed full scale, velocity, displacement
+    // and raw counts are scaled to the largest peak of all components
+    double fullScale = SignalItem::SignalSmc::MAX_SCALE_ACCEL_MS2;
+    bool dataCalibrated = true;
+
+    for( const Smc& crtSmc : mSmcVector )
+    {
+        dataCalibrated = dataCalibrated && crtSmc.mDataCalibrated;
+    }
+
+    if( Smc::DATA_TYPE_FILE_CORRECTED_ACCELEROGRAM != mSmcPlayedDataType || !dataCalibrated )
+    {
+        fullScale = 0;
+
+        for( const Smc& crtSmc : mSmcVector )
+        {
+            for( const double value : getSmcPlayedData( crtSmc ) )
+            {
+                fullScale = std::max( fullScale, std::fabs( value ) );
+            }
+        }
+    }
+
+    mAudioBufferLength = 0;
+
+    for( size_t i = 0; i < mSmcVector.size(); i++ )
+    {
+        const Smc& crtSmc = mSmcVector.at( i );
+
+        SignalItem::SignalSmc sig;
+        sig.nrPoints = crtSmc.mDataValuesRecordedCount;
+        sig.sps = crtSmc.mSamplingRate;
+
+        if( crtSmc.isValidReal( crtSmc.mMaximumFromRecord.accelerationMs2 )
+         && crtSmc.isValidReal( crtSmc.mMinimumFromRecord.accelerationMs2 ) )
+        {
+            sig.maxAccelMs2 = std::max( std::fabs( crtSmc.mMaximumFromRecord.accelerationMs2 ),
+                                        std::fabs( crtSmc.mMinimumFromRecord.accelerationMs2 ) );
+        }
+
+        sig.dataVec = getSmcPlayedData( crtSmc );
+        sig.fullScale = fullScale;
+
+        sig.speedUp = mSmcSpeedUp;
+
+        if( mSmcVector.size() > 1 )
+        {
+            sig.channel = static_cast<int8_t>( i );
+            sig.tStart = alignComponents ? crtSmc.getRecordStartSeconds() - earliestStart : 0;
+        }
+
+        mAudioBufferLength = std::max( mAudioBufferLength, ( sig.tStart + crtSmc.mDataLengthSeconds ) / sig.speedUp );
+
+        mSignalList.append( SignalItem( std::move( sig ) ) );
+    }
+
+    // whole seconds within the range of the buffer length box, which shows it
+    mAudioBufferLength = std::clamp( std::ceil( mAudioBufferLength ), mMainUi->BufferLengthSpin->minimum(), mMainUi->BufferLengthSpin->maximum() );
+    mMainUi->BufferLengthSpin->setValue( mAudioBufferLength );
 
     if( mAudioSrc )
     {
         mAudioSrc->setBufferLength( mAudioBufferLength );
     }
 
-    SignalItem::SignalSmc sig;
-    sig.nrPoints = mSmc.mDataValuesRecordedCount;
-    sig.sps = mSmc.mSamplingRate;
-    sig.maxAccelMs2 = std::max( std::fabs( mSmc.mMaximumFromRecord.accelerationMs2 ),
-                                std::fabs( mSmc.mMinimumFromRecord.accelerationMs2 ) );
-    sig.accelDataVec.resize( sig.nrPoints );
-    sig.accelDataVec = mSmc.mDataVector;
-
     mCurrentSignalType = SignalItem::SIGNAL_TYPE_SMC;
     int crtTab = mCurrentSignalType - SignalItem::SIGNAL_TYPE_FIRST;
     mMainUi->SignalTypesTab->setCurrentIndex( crtTab );
     handleSignalTypeChanged();
-
-    SignalItem* smcSignal = new SignalItem( sig );
-    mSignalsVector.push_back( smcSignal );
 }
 
 
@@ -600,6 +750,26 @@ void SignalGenerator::createTabSignalsMap()
 }
 
 
+//!************************************************************************
+//! Derive velocity and displacement for all SMC components
+//!
+//! @returns nothing
+//!************************************************************************
+void SignalGenerator::deriveSmcVelocityDisplacement()
+{
+    for( Smc& crtSmc : mSmcVector )
+    {
+        SmcIntegration integration( crtSmc.mSamplingRate, mSmcHighPassCornerHz );
+        integration.process( crtSmc.mDataVector, crtSmc.mVelocityVector, crtSmc.mDisplacementVector );
+    }
+
+    if( mSmcVector.size() )
+    {
+        mSmc = mSmcVector.front();
+    }
+}
+
+
 //!************************************************************************
 //! Update the field values of Triangle signal tab
 //!
@@ -798,7 +968,19 @@ void SignalGenerator::fillValuesSmc()
     // station
     mMainUi->SmcStationNameValue->setText( QString::fromStdString( mSmc.mTextStationName ) );
     mMainUi->SmcStationCodeValue->setText( QString::fromStdString( mSmc.mTextStationCodeStr ) );
-    mMainUi->SmcStationComponentValue->setText( QString::fromStdString( mSmc.mTextComponentOrientation ) );
+    std::string componentsStr;
+
+    for( size_t i = 0; i < mSmcVector.size(); i++ )
+    {
+        if( i > 0 )
+        {
+            componentsStr += " / ";
+        }
+
+        componentsStr += mSmcVector.at( i ).mTextComponentOrientation;
+    }
+
+    mMainUi->SmcStationComponentValue->setText( QString::fromStdString( componentsStr ) );
     mMainUi->SmcStationEpicentralDistValue->setText( QString::fromStdString( mSmc.mTextEpicentralDistanceKm ) );
 
     const double MS2_TO_G = 9.80665;
@@ -820,19 +1002,19 @@ void SignalGenerator::fillValuesSmc()
     // instrument
     mMainUi->SmcInstTypeValue->setText( QString::fromStdString( mSmc.mSensorTypeStr ) );
     mMainUi->SmcInstDataSourceValue->setText( QString::fromStdString( mSmc.mTextDataSourceStr ) );
-    mMainUi->SmcInstCutoffValue->setText( checkValidReal( mSmc.mSensorCutoffFrequency ) ? QString::number( mSmc.mSensorCutoffFrequency ) : NA_STR );
-    mMainUi->SmcInstDampingCoeffValue->setText( checkValidReal( mSmc.mSensorDampingCoefficient ) ? QString::number( mSmc.mSensorDampingCoefficient ) : NA_STR );
-    mMainUi->SmcInstVOrientationValue->setText( checkValidInteger( mSmc.mVerticalOrientation ) ? QString::number( mSmc.mVerticalOrientation ) : NA_STR );
-    mMainUi->SmcInstHOrientationValue->setText( checkValidInteger( mSmc.mHorizontalOrientation ) ? QString::number( mSmc.mHorizontalOrientation ) : NA_STR );
+    mMainUi->SmcInstCutoffValue->setText( mSmc.isValidReal( mSmc.mSensorCutoffFrequency ) ? QString::number( mSmc.mSensorCutoffFrequency ) : NA_STR );
+    mMainUi->SmcInstDampingCoeffValue->setText( mSmc.isValidReal( mSmc.mSensorDampingCoefficient ) ? QString::number( mSmc.mSensorDampingCoefficient ) : NA_STR );
+    mMainUi->SmcInstVOrientationValue->setText( mSmc.isValidInteger( mSmc.mVerticalOrientation ) ? QString::number( mSmc.mVerticalOrientation ) : NA_STR );
+    mMainUi->SmcInstHOrientationValue->setText( mSmc.isValidInteger( mSmc.mHorizontalOrientation ) ? QString::number( mSmc.mHorizontalOrientation ) : NA_STR );
 
     // time series
-    mMainUi->SmcTimeUsablePointsValue->setText( checkValidInteger( mSmc.mDataValuesRecordedCount ) ? QString::number( mSmc.mDataValuesRecordedCount ) : NA_STR );
+    mMainUi->SmcTimeUsablePointsValue->setText( mSmc.mDataVector.size() ? QString::number( mSmc.mDataValuesRecordedCount ) : NA_STR );
 
     mMainUi->SmcTimeSpsValue->setText( QString::number( mSmc.mSamplingRate ) );
     mMainUi->SmcTimeDurationValue->setText( QString::number( mSmc.mDataLengthSeconds ) );
     mMainUi->BufferLengthSpin->setValue( mAudioBufferLength );
 
-    if( checkValidReal( mSmc.mMaximumFromRecord.accelerationMs2 ) )
+    if( mSmc.isValidReal( mSmc.mMaximumFromRecord.accelerationMs2 ) )
     {
         mMainUi->SmcTimeAccelMaxGValue->setText( QString::number( mSmc.mMaximumFromRecord.accelerationMs2 / MS2_TO_G ) );
     }
@@ -841,7 +1023,7 @@ void SignalGenerator::fillValuesSmc()
         mMainUi->SmcTimeAccelMaxGValue->setText( NA_STR );
     }
 
-    if( checkValidReal( mSmc.mMinimumFromRecord.accelerationMs2 ) )
+    if( mSmc.isValidReal( mSmc.mMinimumFromRecord.accelerationMs2 ) )
     {
         mMainUi->SmcTimeAccelMinGValue->setText( QString::number( mSmc.mMinimumFromRecord.accelerationMs2 / MS2_TO_G ) );
     }
@@ -852,6 +1034,68 @@ void SignalGenerator::fillValuesSmc()
 }
 
 
+//!************************************************************************
+//! Get the name of a sample format
+//!
+//! @returns: the name
+//!************************************************************************
+QString SignalGenerator::getSampleFormatName
+    (
+    const QAudioFormat::SampleFormat    aSampleFormat   //!< sample format
+    )
+{
+    QString name = "unknown";
+
+    switch( aSampleFormat )
+    {
+        case QAudioFormat::UInt8:
+            name = "8-bit unsigned";
+            break;
+
+        case QAudioFormat::Int16:
+            name = "16-bit";
+            break;
+
+        case QAudioFormat::Int32:
+            name = "32-bit";
+            break;
+
+        case QAudioFormat::Float:
+            name = "32-bit float";
+            break;
+
+        default:
+            break;
+    }
+
+    return name;
+}
+
+
+//!************************************************************************
+//! Get the SMC data selected for playing
+//!
+//! @returns: acceleration, velocity or displacement of the component
+//!************************************************************************
+const std::vector<double>& SignalGenerator::getSmcPlayedData
+    (
+    const Smc&  aSmc                //!< SMC component
+    ) const
+{
+    switch( mSmcPlayedDataType )
+    {
+        case Smc::DATA_TYPE_FILE_VELOCITY:
+            return aSmc.mVelocityVector;
+
+        case Smc::DATA_TYPE_FILE_DISPLACEMENT:
+            return aSmc.mDisplacementVector;
+
+        default:
+            return aSmc.mDataVector;
+    }
+}
+
+
 //!************************************************************************
 //! Handle for changing the audio buffer length (seconds)
 //!
@@ -928,52 +1172,52 @@ void SignalGenerator::handleDeviceChanged
         mMainUi->ActiveSignalList->setCurrentIndex( index );
 
         SignalItem::SignalType sigType = static_cast<SignalItem::SignalType>( mCurrentSignalType );
-        SignalItem* crtSignal = nullptr;
+        std::optional<SignalItem> crtSignal;
 
         switch( sigType )
         {
             case SignalItem::SIGNAL_TYPE_TRIANGLE:
-                crtSignal = new SignalItem( mSignalTriangle );
+                crtSignal.emplace( mSignalTriangle );
                 break;
 
             case SignalItem::SIGNAL_TYPE_RECTANGLE:
-                crtSignal = new SignalItem( mSignalRectangle );
+                crtSignal.emplace( mSignalRectangle );
                 break;
 
             case SignalItem::SIGNAL_TYPE_PULSE:
-                crtSignal = new SignalItem( mSignalPulse );
+                crtSignal.emplace( mSignalPulse );
                 break;
 
             case SignalItem::SIGNAL_TYPE_RISEFALL:
-                crtSignal = new SignalItem( mSignalRiseFall );
+                crtSignal.emplace( mSignalRiseFall );
                 break;
 
             case SignalItem::SIGNAL_TYPE_SINDAMP:
-                crtSignal = new SignalItem( mSignalSinDamp );
+                crtSignal.emplace( mSignalSinDamp );
                 break;
 
             case SignalItem::SIGNAL_TYPE_SINRISE:
-                crtSignal = new SignalItem( mSignalSinRise );
+                crtSignal.emplace( mSignalSinRise );
                 break;
 
             case SignalItem::SIGNAL_TYPE_WAVSIN:
-                crtSignal = new SignalItem( mSignalWavSin );
+                crtSignal.emplace( mSignalWavSin );
                 break;
 
             case SignalItem::SIGNAL_TYPE_AMSIN:
-                crtSignal = new SignalItem( mSignalAmSin );
+                crtSignal.emplace( mSignalAmSin );
                 break;
 
             case SignalItem::SIGNAL_TYPE_SINDAMPSIN:
-                crtSignal = new SignalItem( mSignalSinDampSin );
+                crtSignal.emplace( mSignalSinDampSin );
                 break;
 
             case SignalItem::SIGNAL_TYPE_TRAPDAMPSIN:
-                crtSignal = new SignalItem( mSignalTrapDampSin );
+                crtSignal.emplace( mSignalTrapDampSin );
                 break;
 
             case SignalItem::SIGNAL_TYPE_NOISE:
-                crtSignal = new SignalItem( mSignalNoise );
+                crtSignal.emplace( mSignalNoise );
                 break;
 
             case SignalItem::SIGNAL_TYPE_SMC:
@@ -984,83 +1228,81 @@ void SignalGenerator::handleDeviceChanged
 
         if( crtSignal )
         {
-            mSignalsVector.push_back( crtSignal );
-
             switch( sigType )
             {
                 case SignalItem::SIGNAL_TYPE_TRIANGLE:
                     {
-                        SignalItem::SignalTriangle sigTriangle = crtSignal->getSignalDataTriangle();
+                        const SignalItem::SignalTriangle& sigTriangle = crtSignal->getSignalDataTriangle();
                         mSignalsListModel.setData( index, createSignalStringTriangle( sigTriangle ) );
                     }
                     break;
 
                 case SignalItem::SIGNAL_TYPE_RECTANGLE:
                     {
-                        SignalItem::SignalRectangle sigRectangle = crtSignal->getSignalDataRectangle();
+                        const SignalItem::SignalRectangle& sigRectangle = crtSignal->getSignalDataRectangle();
                         mSignalsListModel.setData( index, createSignalStringRectangle( sigRectangle ) );
                     }
                     break;
 
                 case SignalItem::SIGNAL_TYPE_PULSE:
                     {
-                        SignalItem::SignalPulse sigPulse = crtSignal->getSignalDataPulse();
+                        const SignalItem::SignalPulse& sigPulse = crtSignal->getSignalDataPulse();
                         mSignalsListModel.setData( index, createSignalStringPulse( sigPulse ) );
                     }
                     break;
 
                 case SignalItem::SIGNAL_TYPE_RISEFALL:
                     {
-                        SignalItem::SignalRiseFall sigRiseFall = crtSignal->getSignalDataRiseFall();
+                        const SignalItem::SignalRiseFall& sigRiseFall = crtSignal->getSignalDataRiseFall();
                         mSignalsListModel.setData( index, createSignalStringRiseFall( sigRiseFall ) );
                     }
                     break;
 
                 case SignalItem::SIGNAL_TYPE_SINDAMP:
                     {
-                        SignalItem::SignalSinDamp sigSinDamp = crtSignal->getSignalDataSinDamp();
+                        const SignalItem::SignalSinDamp& sigSinDamp = crtSignal->getSignalDataSinDamp();
                         mSignalsListModel.setData( index, createSignalStringSinDamp( sigSinDamp ) );
                     }
                     break;
 
                 case SignalItem::SIGNAL_TYPE_SINRISE:
                     {
-                        SignalItem::SignalSinRise sigSinRise = crtSignal->getSignalDataSinRise();
+                        const SignalItem::SignalSinRise& sigSinRise = crtSignal->getSignalDataSinRise();
                         mSignalsListModel.setData( index, createSignalStringSinRise( sigSinRise ) );
                     }
                     break;
 
                 case SignalItem::SIGNAL_TYPE_WAVSIN:
                     {
-                        SignalItem::SignalWavSin sigWavSin = crtSignal->getSignalDataWavSin();
+                        const SignalItem::SignalWavSin& sigWavSin = crtSignal->getSignalDataWavSin();
                         mSignalsListModel.setData( index, createSignalStringWavSin( sigWavSin ) );
                     }
                     break;
 
                 case SignalItem::SIGNAL_TYPE_AMSIN:
                     {
-                        SignalItem::SignalAmSin sigAmSin = crtSignal->getSignalDataAmSin();
+                        const SignalItem::SignalAmSin& sigAmSin = crtSignal->getSignalDataAmSin();
                         mSignalsListModel.setData( index, createSignalStringAmSin( sigAmSin ) );
                     }
                     break;
 
                 case SignalItem::SIGNAL_TYPE_SINDAMPSIN:
                     {
-                        SignalItem::SignalSinDampSin sigSinDampSin = crtSignal->getSignalDataSinDampSin();
+                        const SignalItem::SignalSinDampSin& sigSinDampSin = crtSignal->getSignalDataSinDampSin();
                         mSignalsListModel.setData( index, createSignalStringSinDampSin( sigSinDampSin ) );
                     }
                     break;
 
                 case SignalItem::SIGNAL_TYPE_TRAPDAMPSIN:
                     {
-                        SignalItem::SignalTrapDampSin sigTrapDampSin = crtSignal->getSignalDataTrapDampSin();
+                        const SignalItem::SignalTrapDampSin& sigTrapDampSin = crtSignal->getSignalDataTrapDampSin();
                         mSignalsListModel.setData( index, createSignalStringTrapDampSin( sigTrapDampSin ) );
                     }
                     break;
 
                 case SignalItem::SIGNAL_TYPE_NOISE:
                     {
-                        SignalItem::SignalNoise sigNoise = crtSignal->getSignalDataNoise();
+                        const SignalItem::SignalNoise& sigNoise = crtSignal->getSignalDataNoise();
                         mSignalsListModel.setData( index, createSignalStringNoise( sigNoise ) );
                     }
                     break;
@@ -1071,6 +1313,8 @@ void SignalGenerator::handleDeviceChanged
                     break;
             }
 
+            mSignalList.append( std::move( *crtSignal ) );
+
             if( mSignalUndefined )
             {
                 mSignalUndefined = false;
@@ -1078,7 +1322,12 @@ void SignalGenerator::handleDeviceChanged
 
             mSignalReady = false;
 
-            if( mAudioSrc )
+            if( mSignalStarted )
+            {
+                // the change is heard at once, the output does not stop
+                setAudioData();
+            }
+            else if( mAudioSrc )
             {
                 if( mAudioSrc->isOpen() )
                 {
@@ -1089,67 +1338,68 @@ void SignalGenerator::handleDeviceChanged
     }
     else // replace the edited signal
     {
-        if( mEditedSignal )
+        if( mSignalList.isValid( mEditedSignal ) )
         {
             int crtRow = mMainUi->ActiveSignalList->currentIndex().row();
             QModelIndex index = mSignalsListModel.index( crtRow );
 
-            SignalItem::SignalType sigType = mEditedSignal->getType();            
+            SignalItem::SignalType sigType = mSignalList.get( mEditedSignal )->getType();
+            const int8_t channel = mSignalList.get( mEditedSignal )->getChannel();
 
             switch( sigType )
             {
                 case SignalItem::SIGNAL_TYPE_TRIANGLE:
-                    *mEditedSignal = SignalItem( mSignalTriangle );
+                    mSignalList.replace( mEditedSignal, SignalItem( mSignalTriangle ) );
                     mSignalsListModel.setData( index, createSignalStringTriangle( mSignalTriangle ) );
                     break;
 
                 case SignalItem::SIGNAL_TYPE_RECTANGLE:
-                    *mEditedSignal = SignalItem( mSignalRectangle );
+                    mSignalList.replace( mEditedSignal, SignalItem( mSignalRectangle ) );
                     mSignalsListModel.setData( index, createSignalStringRectangle( mSignalRectangle ) );
                     break;
 
                 case SignalItem::SIGNAL_TYPE_PULSE:
-                    *mEditedSignal = SignalItem( mSignalPulse );
+                    mSignalList.replace( mEditedSignal, SignalItem( mSignalPulse ) );
                     mSignalsListModel.setData( index, createSignalStringPulse( mSignalPulse ) );
                     break;
 
                 case SignalItem::SIGNAL_TYPE_RISEFALL:
-                    *mEditedSignal = SignalItem( mSignalRiseFall );
+                    mSignalList.replace( mEditedSignal, SignalItem( mSignalRiseFall ) );
                     mSignalsListModel.setData( index, createSignalStringRiseFall( mSignalRiseFall ) );
                     break;
 
                 case SignalItem::SIGNAL_TYPE_SINDAMP:
-                    *mEditedSignal = SignalItem( mSignalSinDamp );
+                    mSignalList.replace( mEditedSignal, SignalItem( mSignalSinDamp ) );
                     mSignalsListModel.setData( index, createSignalStringSinDamp( mSignalSinDamp ) );
                     break;
 
                 case SignalItem::SIGNAL_TYPE_SINRISE:
-                    *mEditedSignal = SignalItem( mSignalSinRise );
+                    mSignalList.replace( mEditedSignal, SignalItem( mSignalSinRise ) );
                     mSignalsListModel.setData( index, createSignalStringSinRise( mSignalSinRise ) );
                     break;
 
                 case SignalItem::SIGNAL_TYPE_WAVSIN:
-                    *mEditedSignal = SignalItem( mSignalWavSin );
+                    mSignalList.replace( mEditedSignal, SignalItem( mSignalWavSin ) );
                     mSignalsListModel.setData( index, createSignalStringWavSin( mSignalWavSin ) );
                     break;
 
                 case SignalItem::SIGNAL_TYPE_AMSIN:
-                    *mEditedSignal = SignalItem( mSignalAmSin );
+                    mSignalList.replace( mEditedSignal, SignalItem( mSignalAmSin ) );
                     mSignalsListModel.setData( index, createSignalStringAmSin( mSignalAmSin ) );
                     break;
 
                 case SignalItem::SIGNAL_TYPE_SINDAMPSIN:
-                    *mEditedSignal = SignalItem( mSignalSinDampSin );
+                    mSignalList.replace( mEditedSignal, SignalItem( mSignalSinDampSin ) );
                     mSignalsListModel.setData( index, createSignalStringSinDampSin( mSignalSinDampSin ) );
                     break;
 
                 case SignalItem::SIGNAL_TYPE_TRAPDAMPSIN:
-                    *mEditedSignal = SignalItem( mSignalTrapDampSin );
+                    mSignalList.replace( mEditedSignal, SignalItem( mSignalTrapDampSin ) );
                     mSignalsListModel.setData( index, createSignalStringTrapDampSin( mSignalTrapDampSin ) );
                     break;
 
                 case SignalItem::SIGNAL_TYPE_NOISE:
-                    *mEditedSignal = SignalItem( mSignalNoise );
+                    mSignalList.replace( mEditedSignal, SignalItem( mSignalNoise ) );
                     mSignalsListModel.setData( index, createSignalStringNoise( mSignalNoise ) );
                     break;
 
@@ -1159,15 +1409,26 @@ void SignalGenerator::handleDeviceChanged
                     break;
             }
 
-            // replace vector item
-            mSignalsVector.at( crtRow ) = mEditedSignal;
+            // the edited signal stays on its output channel
+            if( channel >= 0 && SignalItem::SIGNAL_TYPE_SMC != sigType )
+            {
+                SignalItem routedSignal = *mSignalList.get( mEditedSignal );
+                routedSignal.setChannel( channel );
+                mSignalsListModel.setData( index, createSignalString( routedSignal ) );
+                mSignalList.replace( mEditedSignal, std::move( routedSignal ) );
+            }
 
-            mEditedSignal = nullptr;
+            mEditedSignal = SignalList::Handle();
             mIsSignalEdited = false;
 
             mSignalReady = false;
 
-            if( mAudioSrc )
+            if( mSignalStarted )
+            {
+                // the change is heard at once, the output does not stop
+                setAudioData();
+            }
+            else if( mAudioSrc )
             {
                 if( mAudioSrc->isOpen() )
                 {
@@ -1189,11 +1450,12 @@ void SignalGenerator::handleDeviceChanged
 /* slot */ void SignalGenerator::handleEditSignal()
 {
     int crtRow = mMainUi->ActiveSignalList->currentIndex().row();
-    mEditedSignal = mSignalsVector.at( crtRow );
+    mEditedSignal = mSignalList.getHandle( crtRow );
+    const SignalItem* editedSignal = mSignalList.get( mEditedSignal );
 
-    if( mEditedSignal )
+    if( editedSignal )
     {
-        SignalItem::SignalType sigType = mEditedSignal->getType();
+        SignalItem::SignalType sigType = editedSignal->getType();
         int crtTab = sigType - SignalItem::SIGNAL_TYPE_FIRST;
         mMainUi->SignalTypesTab->setCurrentIndex( crtTab );
 
@@ -1201,7 +1463,7 @@ void SignalGenerator::handleDeviceChanged
         {
             case SignalItem::SIGNAL_TYPE_TRIANGLE:
                 {
-                    SignalItem::SignalTriangle sig = mEditedSignal->getSignalDataTriangle();
+                    const SignalItem::SignalTriangle& sig = editedSignal->getSignalDataTriangle();
                     memcpy( &mSignalTriangle, &sig, sizeof( mSignalTriangle ) );
                     fillValuesTriangle();
                 }
@@ -1209,7 +1471,7 @@ void SignalGenerator::handleDeviceChanged
 
             case SignalItem::SIGNAL_TYPE_RECTANGLE:
                 {
-                    SignalItem::SignalRectangle sig = mEditedSignal->getSignalDataRectangle();
+                    const SignalItem::SignalRectangle& sig = editedSignal->getSignalDataRectangle();
                     memcpy( &mSignalRectangle, &sig, sizeof( mSignalRectangle ) );
                     fillValuesRectangle();
                 }
@@ -1217,7 +1479,7 @@ void SignalGenerator::handleDeviceChanged
 
             case SignalItem::SIGNAL_TYPE_PULSE:
                 {
-                    SignalItem::SignalPulse sig = mEditedSignal->getSignalDataPulse();
+                    const SignalItem::SignalPulse& sig = editedSignal->getSignalDataPulse();
                     memcpy( &mSignalPulse, &sig, sizeof( mSignalPulse ) );
                     fillValuesPulse();
                 }
@@ -1225,7 +1487,7 @@ void SignalGenerator::handleDeviceChanged
 
             case SignalItem::SIGNAL_TYPE_RISEFALL:
                 {
-                    SignalItem::SignalRiseFall sig = mEditedSignal->getSignalDataRiseFall();
+                    const SignalItem::SignalRiseFall& sig = editedSignal->getSignalDataRiseFall();
                     memcpy( &mSignalRiseFall, &sig, sizeof( mSignalRiseFall ) );
                     fillValuesRiseFall();
                 }
@@ -1233,7 +1495,7 @@ void SignalGenerator::handleDeviceChanged
 
             case SignalItem::SIGNAL_TYPE_SINDAMP:
                 {
-                    SignalItem::SignalSinDamp sig = mEditedSignal->getSignalDataSinDamp();
+                    const SignalItem::SignalSinDamp& sig = editedSignal->getSignalDataSinDamp();
                     memcpy( &mSignalSinDamp, &sig, sizeof( mSignalSinDamp ) );
                     fillValuesSinDamp();
                 }
@@ -1241,7 +1503,7 @@ void SignalGenerator::handleDeviceChanged
 
             case SignalItem::SIGNAL_TYPE_SINRISE:
                 {
-                    SignalItem::SignalSinRise sig = mEditedSignal->getSignalDataSinRise();
+                    const SignalItem::SignalSinRise& sig = editedSignal->getSignalDataSinRise();
                     memcpy( &mSignalSinRise, &sig, sizeof( mSignalSinRise ) );
                     fillValuesSinRise();
                 }
@@ -1249,7 +1511,7 @@ void SignalGenerator::handleDeviceChanged
 
             case SignalItem::SIGNAL_TYPE_WAVSIN:
                 {
-                    SignalItem::SignalWavSin sig = mEditedSignal->getSignalDataWavSin();
+                    const SignalItem::SignalWavSin& sig = editedSignal->getSignalDataWavSin();
                     memcpy( &mSignalWavSin, &sig, sizeof( mSignalWavSin ) );
                     fillValuesWavSin();
                 }
@@ -1257,7 +1519,7 @@ void SignalGenerator::handleDeviceChanged
 
             case SignalItem::SIGNAL_TYPE_AMSIN:
                 {
-                    SignalItem::SignalAmSin sig = mEditedSignal->getSignalDataAmSin();
+                    const SignalItem::SignalAmSin& sig = editedSignal->getSignalDataAmSin();
                     memcpy( &mSignalAmSin, &sig, sizeof( mSignalAmSin ) );
                     fillValuesAmSin();
                 }
@@ -1265,7 +1527,7 @@ void SignalGenerator::handleDeviceChanged
 
             case SignalItem::SIGNAL_TYPE_SINDAMPSIN:
                 {
-                    SignalItem::SignalSinDampSin sig = mEditedSignal->getSignalDataSinDampSin();
+                    const SignalItem::SignalSinDampSin& sig = editedSignal->getSignalDataSinDampSin();
                     memcpy( &mSignalSinDampSin, &sig, sizeof( mSignalSinDampSin ) );
                     fillValuesSinDampSin();
                 }
@@ -1273,7 +1535,7 @@ void SignalGenerator::handleDeviceChanged
 
             case SignalItem::SIGNAL_TYPE_TRAPDAMPSIN:
                 {
-                    SignalItem::SignalTrapDampSin sig = mEditedSignal->getSignalDataTrapDampSin();
+                    const SignalItem::SignalTrapDampSin& sig = editedSignal->getSignalDataTrapDampSin();
                     memcpy( &mSignalTrapDampSin, &sig, sizeof( mSignalTrapDampSin ) );
                     fillValuesTrapDampSin();
                 }
@@ -1281,7 +1543,7 @@ void SignalGenerator::handleDeviceChanged
 
             case SignalItem::SIGNAL_TYPE_NOISE:
                 {
-                    SignalItem::SignalNoise sig = mEditedSignal->getSignalDataNoise();
+                    const SignalItem::SignalNoise& sig = editedSignal->getSignalDataNoise();
                     memcpy( &mSignalNoise, &sig, sizeof( mSignalNoise ) );
                     fillValuesNoise();
                 }
@@ -1310,89 +1572,15 @@ void SignalGenerator::handleDeviceChanged
     QString fileName = QFileDialog::getSaveFileName( this,
                                                      "Save active signal",
                                                      "",
-                                                     "Text files (*.txt);;All files (*)",
+                                                     "Text files (*.txt);;Binary signal files (*.sgl);;All files (*)",
                                                      &selectedFilter,
                                                      QFileDialog::DontUseNativeDialog
                                                     );
 
-    std::string outputFilename = fileName.toStdString();
-    std::ofstream outputFile;
-    outputFile.open( outputFilename );
+    const SignalFile::Format format = fileName.endsWith( ".sgl", Qt::CaseInsensitive ) ? SignalFile::FORMAT_BINARY : SignalFile::FORMAT_TEXT;
 
-    if( outputFile.is_open() )
+    if( fileName.size() && SignalFile::writeFile( fileName.toStdString(), mSignalList, format ) )
     {
-        for( size_t i = 0; i < mSignalsVector.size(); i++ )
-        {
-            SignalItem::SignalType sigType = mSignalsVector.at( i )->getType();
-            QString lineString;
-
-            switch( sigType )
-            {
-                case SignalItem::SIGNAL_TYPE_TRIANGLE:
-                    lineString = createSignalStringTriangle( mSignalsVector.at( i )->getSignalDataTriangle() );
-                    lineString += "\n";
-                    break;
-
-                case SignalItem::SIGNAL_TYPE_RECTANGLE:
-                    lineString = createSignalStringRectangle( mSignalsVector.at( i )->getSignalDataRectangle() );
-                    lineString += "\n";
-                    break;
-
-                case SignalItem::SIGNAL_TYPE_PULSE:
-                    lineString = createSignalStringPulse( mSignalsVector.at( i )->getSignalDataPulse() );
-                    lineString += "\n";
-                    break;
-
-                case SignalItem::SIGNAL_TYPE_RISEFALL:
-                    lineString = createSignalStringRiseFall( mSignalsVector.at( i )->getSignalDataRiseFall() );
-                    lineString += "\n";
-                    break;
-
-                case SignalItem::SIGNAL_TYPE_SINDAMP:
-                    lineString = createSignalStringSinDamp( mSignalsVector.at( i )->getSignalDataSinDamp() );
-                    lineString += "\n";
-                    break;
-
-                case SignalItem::SIGNAL_TYPE_SINRISE:
-                    lineString = createSignalStringSinRise( mSignalsVector.at( i )->getSignalDataSinRise() );
-                    lineString += "\n";
-                    break;
-
-                case SignalItem::SIGNAL_TYPE_WAVSIN:
-                    lineString = createSignalStringWavSin( mSignalsVector.at( i )->getSignalDataWavSin() );
-                    lineString += "\n";
-                    break;
-
-                case SignalItem::SIGNAL_TYPE_AMSIN:
-                    lineString = createSignalStringAmSin( mSignalsVector.at( i )->getSignalDataAmSin() );
-                    lineString += "\n";
-                    break;
-
-                case SignalItem::SIGNAL_TYPE_SINDAMPSIN:
-                    lineString = createSignalStringSinDampSin( mSignalsVector.at( i )->getSignalDataSinDampSin() );
-                    lineString += "\n";
-                    break;
-
-                case SignalItem::SIGNAL_TYPE_TRAPDAMPSIN:
-                    lineString = createSignalStringTrapDampSin( mSignalsVector.at( i )->getSignalDataTrapDampSin() );
-                    lineString += "\n";
-                    break;
-
-                case SignalItem::SIGNAL_TYPE_NOISE:
-                    lineString = createSignalStringNoise( mSignalsVector.at( i )->getSignalDataNoise() );
-                    lineString += "\n";
-                    break;
-
-                case SignalItem::SIGNAL_TYPE_SMC:
-                    // intentionally do nothing
-                default:
-                    break;
-            }
-
-            outputFile << lineString.toStdString();
-        }
-
-        outputFile.close();
         mSignalReady = true;
 
         setAudioData();
@@ -1419,9 +1607,14 @@ void SignalGenerator::handleDeviceChanged
     int crtRow = mMainUi->ActiveSignalList->currentIndex().row();
     mSignalsListModel.removeRow( crtRow );
 
-    mSignalsVector.erase( mSignalsVector.begin() + crtRow );
+    mSignalList.remove( mSignalList.getHandle( crtRow ) );
+
+    mSignalUndefined = mSignalList.isEmpty();
 
-    mSignalUndefined = mSignalsVector.empty();
+    if( mSignalStarted )
+    {
+        setAudioData();
+    }
 
     if( mSignalUndefined )
     {
@@ -1547,6 +1740,12 @@ void SignalGenerator::handleGenerateStop()
     mSignalStarted = false;
     mSignalPaused = false;
 
+    // a playlist starts again from its first entry
+    if( mSmcPlaylistEntries.size() )
+    {
+        setAudioData();
+    }
+
     mAudioBufferCounter = 0;
     updateAudioBufferTimer();
     mAudioBufferTimer->stop();
@@ -1556,65 +1755,512 @@ void SignalGenerator::handleGenerateStop()
 
 
 //!************************************************************************
-//! Create a new signal
+//! Select the sampling rate and sample format of the output
+//! The device rate and format are used by default, so that neither Qt nor
+//! the system converts or resamples the generated audio.
 //!
 //! @returns nothing
 //!************************************************************************
-/* slot */ void SignalGenerator::handleSignalNew()
+/* slot */ void SignalGenerator::handleOutputFormat()
 {
-    if( !mSignalUndefined && mSignalStarted )
+    const QAudioDevice device = mMainUi->GenerateDeviceComboBox->currentData().value<QAudioDevice>();
+    const QAudioFormat preferredFormat = device.preferredFormat();
+
+    QStringList rateNames;
+    std::vector<int> sampleRates;
+    rateNames << "Device rate (" + QString::number( preferredFormat.sampleRate() ) + " SPS)";
+    sampleRates.push_back( 0 );
+
+    for( int sampleRate : OUTPUT_SAMPLE_RATES )
     {
-        QString msg = "Please stop generating the current signal first.";
-        QMessageBox msgBox;
-        msgBox.setText( msg );
-        msgBox.exec();
+        if( sampleRate >= device.minimumSampleRate() && sampleRate <= device.maximumSampleRate() )
+        {
+            rateNames << QString::number( sampleRate ) + " SPS";
+            sampleRates.push_back( sampleRate );
+        }
     }
-    else
-    {
-        mSignalUndefined = false;
-        mSignalReady = false;
-        mSignalStarted = false;
-        mSignalPaused = false;
-        mSignalIsSmc = false;
-        mIsSignalEdited = false;
 
-        mCurrentSignalType = SignalItem::SIGNAL_TYPE_TRIANGLE;
-        int crtTab = mCurrentSignalType - SignalItem::SIGNAL_TYPE_FIRST;
-        mMainUi->SignalTypesTab->setCurrentIndex( crtTab );
-        handleSignalTypeChanged();
+    const int rateIndex = std::find( sampleRates.begin(), sampleRates.end(), mOutputSampleRate ) - sampleRates.begin();
 
-        mSignalsListModel.removeRows( 0, mSignalsVector.size() );
-        mSignalsVector.clear();
+    bool ok = false;
+    const QString rateName = QInputDialog::getItem( this,
+                                                    "Output format",
+                                                    "Sampling rate:",
+                                                    rateNames,
+                                                    ( rateIndex < rateNames.count() ) ? rateIndex : 0,
+                                                    false,
+                                                    &ok
+                                                   );
+
+    if( ok )
+    {
+        QStringList formatNames;
+        std::vector<QAudioFormat::SampleFormat> sampleFormats;
+        formatNames << "Device format (" + getSampleFormatName( preferredFormat.sampleFormat() ) + ")";
+        sampleFormats.push_back( QAudioFormat::Unknown );
+
+        for( QAudioFormat::SampleFormat sampleFormat : device.supportedSampleFormats() )
+        {
+            formatNames << getSampleFormatName( sampleFormat );
+            sampleFormats.push_back( sampleFormat );
+        }
 
-        mAudioOutput->stop();
+        const int formatIndex = std::find( sampleFormats.begin(), sampleFormats.end(), mOutputSampleFormat ) - sampleFormats.begin();
 
-        if( mAudioSrc )
+        const QString formatName = QInputDialog::getItem( this,
+                                                          "Output format",
+                                                          "Sample format:",
+                                                          formatNames,
+                                                          ( formatIndex < formatNames.count() ) ? formatIndex : 0,
+                                                          false,
+                                                          &ok
+                                                         );
+
+        if( ok )
         {
-            mAudioSrc->stop();
-        }
+            const int sampleRate = sampleRates.at( std::max<int>( rateNames.indexOf( rateName ), 0 ) );
+            const QAudioFormat::SampleFormat sampleFormat = sampleFormats.at( std::max<int>( formatNames.indexOf( formatName ), 0 ) );
 
-        updateControls();
+            if( sampleRate != mOutputSampleRate || sampleFormat != mOutputSampleFormat )
+            {
+                mOutputSampleRate = sampleRate;
+                mOutputSampleFormat = sampleFormat;
+                handleDeviceChanged( mMainUi->GenerateDeviceComboBox->currentIndex() );
+            }
+        }
     }
 }
 
 
 //!************************************************************************
-//! Open a file with a signal definition
+//! Select band-limited waveforms
+//! Triangle, Rectangle and Pulse signals are played from wavetables
+//! without the harmonics above the Nyquist frequency, so that they do not
+//! alias at high frequencies. A change is applied to the signal being
+//! generated.
 //!
 //! @returns nothing
 //!************************************************************************
-/* slot */ void SignalGenerator::handleSignalOpen()
+/* slot */ void SignalGenerator::handleSignalBandLimited
+    (
+    bool    aChecked    //!< true to play band-limited waveforms
+    )
 {
-    if( !mSignalUndefined && !mSignalReady )
+    mSignalBandLimited = aChecked;
+
+    if( mAudioSrc )
     {
-        QString msg = "Please save the current signal first.";
-        QMessageBox msgBox;
-        msgBox.setText( msg );
-        msgBox.exec();
+        mAudioSrc->setBandLimited( mSignalBandLimited );
+
+        if( mSignalReady && !mSignalIsSmc )
+        {
+            setAudioData();
+        }
     }
-    else if( !mSignalUndefined && mSignalStarted )
+}
+
+
+//!************************************************************************
+//! Select the output channel of the current signal item
+//! An item routed to one channel is only heard on that channel; the items
+//! of all channels are mixed into each of them. A change is applied to
+//! the signal being generated.
+//!
+//! @returns nothing
+//!************************************************************************
+/* slot */ void SignalGenerator::handleSignalChannel()
+{
+    const int crtRow = mMainUi->ActiveSignalList->currentIndex().row();
+    const SignalList::Handle handle = mSignalList.getHandle( std::max( crtRow, 0 ) );
+    const SignalItem* crtSignal = mSignalList.get( handle );
+
+    if( crtSignal && SignalItem::SIGNAL_TYPE_SMC != crtSignal->getType() )
     {
-        QString msg = "Please stop generating the current signal first.";
+        const int channelsCount = std::max( mAudioFormat.channelCount(), crtSignal->getChannel() + 1 );
+
+        QStringList channelNames;
+        channelNames << "All channels";
+
+        for( int channel = 0; channel < channelsCount; channel++ )
+        {
+            channelNames << "Channel " + QString::number( channel + 1 );
+        }
+
+        bool ok = false;
+        const QString channelName = QInputDialog::getItem( this,
+                                                           "Output channel",
+                                                           "Output channel of the signal item:",
+                                                           channelNames,
+                                                           crtSignal->getChannel() + 1,
+                                                           false,
+                                                           &ok
+                                                          );
+
+        const int8_t channel = static_cast<int8_t>( channelNames.indexOf( channelName ) - 1 );
+
+        if( ok && channel != crtSignal->getChannel() )
+        {
+            SignalItem routedSignal = *crtSignal;
+            routedSignal.setChannel( channel );
+            mSignalsListModel.setData( mSignalsListModel.index( std::max( crtRow, 0 ) ), createSignalString( routedSignal ) );
+            mSignalList.replace( handle, std::move( routedSignal ) );
+
+            mSignalReady = false;
+
+            if( mSignalStarted )
+            {
+                // the change is heard at once, the output does not stop
+                setAudioData();
+            }
+            else if( mAudioSrc )
+            {
+                if( mAudioSrc->isOpen() )
+                {
+                    mAudioSrc->stop();
+                }
+            }
+
+            updateControls();
+        }
+    }
+}
+
+
+//!************************************************************************
+//! Select a channel array, for array and beamforming tests
+//! Each channel plays the signal items of all channels with its own delay,
+//! or with its own phase at a given frequency; the items are evaluated
+//! once for all the channels. A change is applied to the signal being
+//! generated.
+//!
+//! @returns nothing
+//!************************************************************************
+/* slot */ void SignalGenerator::handleSignalChannelArray()
+{
+    QStringList modeNames;
+    modeNames << "Off" << "Delay of each channel" << "Phase of each channel";
+
+    bool ok = false;
+    const QString modeName = QInputDialog::getItem( this,
+                                                    "Channel array",
+                                                    "Channels offset by:",
+                                                    modeNames,
+                                                    mChannelArrayMode,
+                                                    false,
+                                                    &ok
+                                                   );
+
+    const ChannelArrayMode mode = static_cast<ChannelArrayMode>( std::max<int>( modeNames.indexOf( modeName ), 0 ) );
+    QString values = mChannelArrayValues;
+    double freqHz = mChannelArrayFreqHz;
+
+    if( ok && CHANNEL_ARRAY_OFF != mode )
+    {
+        values = QInputDialog::getText( this,
+                                        "Channel array",
+                                        ( CHANNEL_ARRAY_DELAYS == mode ) ? "Delay of each channel [ms], comma separated:"
+                                                                         : "Phase of each channel [deg], comma separated:",
+                                        QLineEdit::Normal,
+                                        mChannelArrayValues,
+                                        &ok
+                                       );
+    }
+
+    if( ok && CHANNEL_ARRAY_PHASES == mode )
+    {
+        freqHz = QInputDialog::getDouble( this,
+                                          "Channel array",
+                                          "Frequency of the phases [Hz]:",
+                                          mChannelArrayFreqHz,
+                                          ARRAY_FREQ_MIN_HZ,
+                                          FREQ_MAX_HZ,
+                                          3,
+                                          &ok
+                                         );
+    }
+
+    if( ok )
+    {
+        std::vector<double> delayVec;
+
+        if( CHANNEL_ARRAY_OFF != mode )
+        {
+            const QStringList valueStrings = values.split( ',' );
+
+            for( const QString& valueString : valueStrings )
+            {
+                bool valueOk = false;
+                const double value = valueString.trimmed().toDouble( &valueOk );
+
+                if( !valueOk || ( CHANNEL_ARRAY_DELAYS == mode && value < 0 ) )
+                {
+                    QMessageBox::warning( this,
+                                          "Channel array",
+                                          "Invalid value \"" + valueString.trimmed() + "\"."
+                                          "\nThe delays are 0 or more milliseconds, the phases any number of degrees."
+                                         );
+                    return;
+                }
+
+                if( CHANNEL_ARRAY_DELAYS == mode )
+                {
+                    delayVec.push_back( value / 1000 );
+                }
+                else
+                {
+                    // a phase lead is the delay which completes its period
+                    const double cycles = -value / 360;
+                    delayVec.push_back( ( cycles - std::floor( cycles ) ) / freqHz );
+                }
+            }
+
+            mChannelArrayValues = values;
+            mChannelArrayFreqHz = freqHz;
+        }
+
+        mChannelArrayMode = mode;
+        mChannelArrayDelayVec = delayVec;
+
+        if( mAudioSrc )
+        {
+            mAudioSrc->setChannelArray( mChannelArrayDelayVec );
+
+            if( !mSignalUndefined && !mSignalIsSmc )
+            {
+                setAudioData();
+            }
+        }
+    }
+}
+
+
+//!************************************************************************
+//! Select continuous generation
+//! The signals are evaluated forward in time while playing, so that
+//! non-periodic signals play once and noise never repeats, instead of
+//! looping a buffer of the selected length.
+//!
+//! @returns nothing
+//!************************************************************************
+/* slot */ void SignalGenerator::handleSignalContinuous
+    (
+    bool    aChecked    //!< true to generate continuously
+    )
+{
+    mSignalContinuous = aChecked;
+
+    if( mAudioSrc )
+    {
+        mAudioSrc->setContinuous( mSignalContinuous );
+
+        if( mSignalReady )
+        {
+            setAudioData();
+        }
+    }
+
+    updateControls();
+}
+
+
+//!************************************************************************
+//! Cue a signal file to replace the signal being generated
+//! The new list is rendered while the current one keeps playing, and the
+//! output switches to it exactly at the selected boundary.
+//!
+//! @returns nothing
+//!************************************************************************
+/* slot */ void SignalGenerator::handleSignalCue()
+{
+    QString selectedFilter;
+    QString fileName = QFileDialog::getOpenFileName( this,
+                                                     "Cue signal file",
+                                                     "",
+                                                     "Signal files (*.txt *.sgl);;All files (*)",
+                                                     &selectedFilter,
+                                                     QFileDialog::DontUseNativeDialog
+                                                    );
+
+    SignalList readSignals;
+    QStringList lineStrings;
+    QString fileErrors;
+
+    if( fileName.isEmpty() )
+    {
+        return;
+    }
+
+    if( !readSignalFile( fileName.toStdString(), readSignals, lineStrings, fileErrors ) || readSignals.isEmpty() )
+    {
+        QString msg = "The selected file does not contain any valid signal.";
+
+        if( fileErrors.size() )
+        {
+            msg += "\n\n" + fileErrors;
+        }
+
+        QMessageBox msgBox;
+        msgBox.setText( msg );
+        msgBox.exec();
+        return;
+    }
+
+    if( fileErrors.size() )
+    {
+        QString msg = "Some lines of the selected file were skipped.\n\n" + fileErrors;
+        QMessageBox msgBox;
+        msgBox.setText( msg );
+        msgBox.exec();
+    }
+
+    const QStringList BOUNDARY_NAMES = { "Next block", "Next period", "Next zero crossing", "Output sample index" };
+    bool ok = false;
+    QString boundaryName = QInputDialog::getItem( this,
+                                                  "Cue signal file",
+                                                  "Switch at:",
+                                                  BOUNDARY_NAMES,
+                                                  mCueSettings.boundary,
+                                                  false,
+                                                  &ok
+                                                 );
+
+    if( ok )
+    {
+        mCueSettings.boundary = static_cast<AudioSource::SwitchBoundary>( BOUNDARY_NAMES.indexOf( boundaryName ) );
+
+        switch( mCueSettings.boundary )
+        {
+            case AudioSource::SWITCH_AT_PERIOD:
+                mCueSettings.periodSeconds = QInputDialog::getDouble( this,
+                                                                      "Cue signal file",
+                                                                      "Period [s]:",
+                                                                      ( mCueSettings.periodSeconds > 0 ) ? mCueSettings.periodSeconds : mAudioBufferLength,
+                                                                      T_MIN_S,
+                                                                      mAudioBufferLength,
+                                                                      6,
+                                                                      &ok
+                                                                     );
+                break;
+
+            case AudioSource::SWITCH_AT_FRAME:
+                {
+                    // one second ahead of what was rendered so far, by default
+                    const uint64_t defaultFrame = ( mAudioSrc ? mAudioSrc->getFramesRendered() : 0 ) + mAudioFormat.sampleRate();
+                    QString frameText = QInputDialog::getText( this,
+                                                               "Cue signal file",
+                                                               "Output sample index:",
+                                                               QLineEdit::Normal,
+                                                               QString::number( defaultFrame ),
+                                                               &ok
+                                                              );
+
+                    if( ok )
+                    {
+                        mCueSettings.frame = frameText.toULongLong( &ok );
+                    }
+                }
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    if( ok )
+    {
+        mCueSettings.crossfadeSeconds = QInputDialog::getDouble( this,
+                                                                 "Cue signal file",
+                                                                 "Crossfade [ms], 0 for none:",
+                                                                 mCueSettings.crossfadeSeconds * 1000,
+                                                                 0,
+                                                                 CUE_CROSSFADE_MS_MAX,
+                                                                 1,
+                                                                 &ok
+                                                                ) / 1000;
+    }
+
+    if( ok )
+    {
+        mSignalList = std::move( readSignals );
+        mSignalsListModel.setStringList( lineStrings );
+
+        mSignalUndefined = false;
+        mSignalReady = true;
+        mIsSignalEdited = false;
+        mEditedSignal = SignalList::Handle();
+
+        if( mAudioSrc )
+        {
+            mAudioSrc->cueData( mSignalList.getSnapshot(), mCueSettings );
+        }
+
+        updateControls();
+    }
+}
+
+
+//!************************************************************************
+//! Create a new signal
+//!
+//! @returns nothing
+//!************************************************************************
+/* slot */ void SignalGenerator::handleSignalNew()
+{
+    if( !mSignalUndefined && mSignalStarted )
+    {
+        QString msg = "Please stop generating the current signal first.";
+        QMessageBox msgBox;
+        msgBox.setText( msg );
+        msgBox.exec();
+    }
+    else
+    {
+        mSignalUndefined = false;
+        mSignalReady = false;
+        mSignalStarted = false;
+        mSignalPaused = false;
+        mSignalIsSmc = false;
+        mSmcPlaylistEntries.clear();
+        mSmcPlaylist.reset();
+        mIsSignalEdited = false;
+
+        mCurrentSignalType = SignalItem::SIGNAL_TYPE_TRIANGLE;
+        int crtTab = mCurrentSignalType - SignalItem::SIGNAL_TYPE_FIRST;
+        mMainUi->SignalTypesTab->setCurrentIndex( crtTab );
+        handleSignalTypeChanged();
+
+        mSignalsListModel.removeRows( 0, mSignalList.getSize() );
+        mSignalList.clear();
+
+        mAudioOutput->stop();
+
+        if( mAudioSrc )
+        {
+            mAudioSrc->stop();
+        }
+
+        updateControls();
+    }
+}
+
+
+//!************************************************************************
+//! Open a file with a signal definition
+//!
+//! @returns nothing
+//!************************************************************************
+/* slot */ void SignalGenerator::handleSignalOpen()
+{
+    if( !mSignalUndefined && !mSignalReady )
+    {
+        QString msg = "Please save the current signal first.";
+        QMessageBox msgBox;
+        msgBox.setText( msg );
+        msgBox.exec();
+    }
+    else if( !mSignalUndefined && mSignalStarted )
+    {
+        QString msg = "Please stop generating the current signal first.";
         QMessageBox msgBox;
         msgBox.setText( msg );
         msgBox.exec();
@@ -1626,10 +2272,12 @@ void SignalGenerator::handleGenerateStop()
         mSignalStarted = false;
         mSignalPaused = false;
         mSignalIsSmc = false;
+        mSmcPlaylistEntries.clear();
+        mSmcPlaylist.reset();
         mIsSignalEdited = false;
 
-        mSignalsListModel.removeRows( 0, mSignalsVector.size() );
-        mSignalsVector.clear();
+        mSignalsListModel.removeRows( 0, mSignalList.getSize() );
+        mSignalList.clear();
 
         mAudioOutput->stop();
 
@@ -1642,947 +2290,45 @@ void SignalGenerator::handleGenerateStop()
         QString fileName = QFileDialog::getOpenFileName( this,
                                                          "Open signal file",
                                                          "",
-                                                         "Text files (*.txt);;All files (*)",
+                                                         "Signal files (*.txt *.sgl);;All files (*)",
                                                          &selectedFilter,
                                                          QFileDialog::DontUseNativeDialog
                                                         );
 
-        std::string inputFilename = fileName.toStdString();
-        std::ifstream inputFile( inputFilename );
+        QStringList lineStrings;
+        QString fileErrors;
 
-        if( inputFile.is_open() )
+        if( readSignalFile( fileName.toStdString(), mSignalList, lineStrings, fileErrors ) )
         {
-            const std::string DELIM = ", ";
-            std::string currentLine;
-
-            while( getline( inputFile, currentLine ) )
-            {
-                std::vector<QString> substringsVec;
-                size_t pos = 0;
-
-                while( ( pos = currentLine.find( DELIM ) ) != std::string::npos )
-                {
-                    substringsVec.push_back( QString::fromStdString( currentLine.substr( 0, pos ) ) );
-                    currentLine.erase( 0, pos + DELIM.length() );
-                }
-
-                if( currentLine.size() )
-                {
-                    substringsVec.push_back( QString::fromStdString( currentLine ) );
-                }
-
-                size_t ssCount = substringsVec.size();
+            mSignalsListModel.setStringList( lineStrings );
 
-                if( ssCount >=2 )
-                {
-                    bool currentSignalOk = true;
-                    size_t expectedParams = 0;
-
-                    QString lineString;
-
-                    double crtDbl = 0;
-                    int crtInt = 0;
-
-                    SignalItem::SignalType sigType = static_cast<SignalItem::SignalType>( substringsVec[0].toInt() );
-                    SignalItem* crtSignal = nullptr;
-
-                    switch( sigType )
-                    {
-                        case SignalItem::SIGNAL_TYPE_TRIANGLE:
-                            {
-                                expectedParams = 6;
-                                currentSignalOk = ( expectedParams == ( ssCount - 1 ) );
-                                SignalItem::SignalTriangle sig;
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[1].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.tPeriod = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[2].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.tRise = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[3].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.tFall = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[4].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.tDelay = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[5].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.yMax = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[6].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.yMin = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtSignal = new SignalItem( sig );
-                                    lineString = createSignalStringTriangle( sig );
-                                }
-                            }
-                            break;
-
-                        case SignalItem::SIGNAL_TYPE_RECTANGLE:
-                            {
-                                expectedParams = 5;
-                                currentSignalOk = ( expectedParams == ( ssCount - 1 ) );
-                                SignalItem::SignalRectangle sig;
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[1].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.tPeriod = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[2].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.fillFactor = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[3].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.tDelay = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[4].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.yMax = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[5].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.yMin = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtSignal = new SignalItem( sig );
-                                    lineString = createSignalStringRectangle( sig );
-                                }
-                            }
-                            break;
-
-                        case SignalItem::SIGNAL_TYPE_PULSE:
-                            {
-                                expectedParams = 7;
-                                currentSignalOk = ( expectedParams == ( ssCount - 1 ) );
-                                SignalItem::SignalPulse sig;
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[1].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.tPeriod = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[2].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.tRise = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[3].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.tWidth = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[4].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.tFall = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[5].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.tDelay = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[6].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.yMax = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[7].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.yMin = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtSignal = new SignalItem( sig );
-                                    lineString = createSignalStringPulse( sig );
-                                }
-                            }
-                            break;
-
-                        case SignalItem::SIGNAL_TYPE_RISEFALL:
-                            {
-                                expectedParams = 7;
-                                currentSignalOk = ( expectedParams == ( ssCount - 1 ) );
-                                SignalItem::SignalRiseFall sig;
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[1].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.tDelay = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[2].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.tDelayRise = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[3].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.tRampRise = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[4].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.tDelayFall = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[5].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.tRampFall = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[6].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.yMax = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[7].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.yMin = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtSignal = new SignalItem( sig );
-                                    lineString = createSignalStringRiseFall( sig );
-                                }
-                            }
-                            break;
-
-                        case SignalItem::SIGNAL_TYPE_SINDAMP:
-                            {
-                                expectedParams = 6;
-                                currentSignalOk = ( expectedParams == ( ssCount - 1 ) );
-                                SignalItem::SignalSinDamp sig;
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[1].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.freqHz = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[2].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.phiRad = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[3].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.tDelay = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[4].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.amplit = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[5].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.offset = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[6].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.damping = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtSignal = new SignalItem( sig );
-                                    lineString = createSignalStringSinDamp( sig );
-                                }
-                            }
-                            break;
-
-                        case SignalItem::SIGNAL_TYPE_SINRISE:
-                            {
-                                expectedParams = 7;
-                                currentSignalOk = ( expectedParams == ( ssCount - 1 ) );
-                                SignalItem::SignalSinRise sig;
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[1].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.freqHz = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[2].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.phiRad = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[3].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.tEnd = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[4].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.tDelay = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[5].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.amplit = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[6].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.offset = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[7].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.damping = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtSignal = new SignalItem( sig );
-                                    lineString = createSignalStringSinRise( sig );
-                                }
-                            }
-                            break;
-
-                        case SignalItem::SIGNAL_TYPE_WAVSIN:
-                            {
-                                expectedParams = 6;
-                                currentSignalOk = ( expectedParams == ( ssCount - 1 ) );
-                                SignalItem::SignalWavSin sig;
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[1].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.freqHz = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[2].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.phiRad = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[3].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.tDelay = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[4].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.amplit = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[5].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.offset = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtInt = substringsVec[6].toInt( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.index = crtInt;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtSignal = new SignalItem( sig );
-                                    lineString = createSignalStringWavSin( sig );
-                                }
-                            }
-                            break;
-
-                        case SignalItem::SIGNAL_TYPE_AMSIN:
-                            {
-                                expectedParams = 7;
-                                currentSignalOk = ( expectedParams == ( ssCount - 1 ) );
-                                SignalItem::SignalAmSin sig;
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[1].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.carrierFreqHz = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[2].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.carrierAmplitude = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[3].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.carrierOffset = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[4].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.carrierTDelay = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[5].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.modulationFreqHz = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[6].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.modulationPhiRad = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[7].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.modulationIndex = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtSignal = new SignalItem( sig );
-                                    lineString = createSignalStringAmSin( sig );
-                                }
-                            }
-                            break;
-
-                        case SignalItem::SIGNAL_TYPE_SINDAMPSIN:
-                            {
-                                expectedParams = 6;
-                                currentSignalOk = ( expectedParams == ( ssCount - 1 ) );
-                                SignalItem::SignalSinDampSin sig;
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[1].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.freqSinHz = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[2].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.tPeriodEnv = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[3].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.tDelay = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[4].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.amplit = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[5].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.offset = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtInt = substringsVec[6].toInt( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.dampingType = crtInt;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtSignal = new SignalItem( sig );
-                                    lineString = createSignalStringSinDampSin( sig );
-                                }
-                            }
-                            break;
-
-                        case SignalItem::SIGNAL_TYPE_TRAPDAMPSIN:
-                            {
-                                expectedParams = 9;
-                                currentSignalOk = ( expectedParams == ( ssCount - 1 ) );
-                                SignalItem::SignalTrapDampSin sig;
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[1].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.tPeriod = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[2].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.tRise = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[3].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.tWidth = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[4].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.tFall = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[5].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.tDelay = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[6].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.tCross = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[7].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.freqHz = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[8].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.amplit = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[9].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.offset = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtSignal = new SignalItem( sig );
-                                    lineString = createSignalStringTrapDampSin( sig );
-                                }
-                            }
-                            break;
-
-                        case SignalItem::SIGNAL_TYPE_NOISE:
-                            {
-                                expectedParams = 5;
-                                currentSignalOk = ( expectedParams == ( ssCount - 1 ) );
-                                SignalItem::SignalNoise sig;
-
-                                if( currentSignalOk )
-                                {
-                                    crtInt = substringsVec[1].toInt( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.noiseType = static_cast<SignalItem::NoiseType>( crtInt );
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[2].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.gamma = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[3].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.tDelay = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[4].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.amplit = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtDbl = substringsVec[5].toDouble( &currentSignalOk );
-
-                                    if( currentSignalOk )
-                                    {
-                                        sig.offset = crtDbl;
-                                    }
-                                }
-
-                                if( currentSignalOk )
-                                {
-                                    crtSignal = new SignalItem( sig );
-                                    lineString = createSignalStringNoise( sig );
-                                }
-                            }
-                            break;
-
-                        case SignalItem::SIGNAL_TYPE_SMC:
-                            // intentionally do nothing
-                        default:
-                            break;
-                    }
-
-                    if( crtSignal && currentSignalOk )
-                    {
-                        mSignalsVector.push_back( crtSignal );
-
-                        int row = mSignalsListModel.rowCount();
-                        mSignalsListModel.insertRow( row );
-                        QModelIndex index = mSignalsListModel.index( row );
-                        mSignalsListModel.setData( index, lineString );
-                    }
-                }
-            }
-
-            inputFile.close();
-
-            if( mSignalsVector.size() )
+            if( !mSignalList.isEmpty() )
             {
                 mSignalUndefined = false;
                 mSignalReady = true;
                 mSignalIsSmc = false;
+                mSmcPlaylistEntries.clear();
+                mSmcPlaylist.reset();
 
                 setAudioData();
+
+                if( fileErrors.size() )
+                {
+                    QString msg = "Some lines of the selected file were skipped.\n\n" + fileErrors;
+                    QMessageBox msgBox;
+                    msgBox.setText( msg );
+                    msgBox.exec();
+                }
             }
             else
             {
                 QString msg = "The selected file does not contain any valid signal.";
+
+                if( fileErrors.size() )
+                {
+                    msg += "\n\n" + fileErrors;
+                }
+
                 QMessageBox msgBox;
                 msgBox.setText( msg );
                 msgBox.exec();
@@ -4737,7 +4483,7 @@ void SignalGenerator::handleSignalChangedNoiseGamma
 
     if( mIsSignalEdited )
     {
-        mEditedSignal = nullptr;
+        mEditedSignal = SignalList::Handle();
         mIsSignalEdited = false;
         updateControls();
     }
@@ -4745,20 +4491,190 @@ void SignalGenerator::handleSignalChangedNoiseGamma
 
 
 //!************************************************************************
-//! Open an accelerogram from a SMC (Strong Motion CD) data file
+//! Export the SMC time series: acceleration, velocity and displacement
+//! Components are written as blocks separated by two blank lines.
 //!
 //! @returns nothing
 //!************************************************************************
-/* slot */ void SignalGenerator::handleSmcOpen()
+/* slot */ void SignalGenerator::handleSmcExport()
 {
-    if( !mSignalUndefined && !mSignalReady )
-    {
-        QString msg = "Please save the current signal first.";
-        QMessageBox msgBox;
-        msgBox.setText( msg );
-        msgBox.exec();
-    }
-    else if( !mSignalUndefined && mSignalStarted )
+    QString selectedFilter;
+    QString fileName = QFileDialog::getSaveFileName( this,
+                                                     "Export SMC time series",
+                                                     "",
+                                                     "Text files (*.txt);;All files (*)",
+                                                     &selectedFilter,
+                                                     QFileDialog::DontUseNativeDialog
+                                                    );
+
+    std::ofstream outputFile;
+    outputFile.open( fileName.toStdString() );
+
+    if( outputFile.is_open() )
+    {
+        outputFile << std::scientific << std::setprecision( 7 );
+
+        for( size_t i = 0; i < mSmcVector.size(); i++ )
+        {
+            const Smc& crtSmc = mSmcVector.at( i );
+            const double dt = ( crtSmc.mSamplingRate > 0 ) ? 1.0 / crtSmc.mSamplingRate : 0;
+
+            if( i > 0 )
+            {
+                outputFile << "\n\n";
+            }
+
+            outputFile << "# " << crtSmc.mTextStationCodeStr << " " << crtSmc.mTextComponentOrientation << "\n";
+            outputFile << "# high-pass corner " << mSmcHighPassCornerHz << " Hz\n";
+            outputFile << "# time [s]\tacceleration [m/s2]\tvelocity [m/s]\tdisplacement [m]\n";
+
+            for( size_t k = 0; k < crtSmc.mDataVector.size()
+                            && k < crtSmc.mVelocityVector.size()
+                            && k < crtSmc.mDisplacementVector.size(); k++ )
+            {
+                outputFile << k * dt << "\t"
+                           << crtSmc.mDataVector[k] << "\t"
+                           << crtSmc.mVelocityVector[k] << "\t"
+                           << crtSmc.mDisplacementVector[k] << "\n";
+            }
+        }
+
+        outputFile.close();
+    }
+    else if( fileName.size() )
+    {
+        QString msg = "Could not open file \"" + fileName +"\".";
+        QMessageBox msgBox;
+        msgBox.setText( msg );
+        msgBox.exec();
+    }
+}
+
+
+//!************************************************************************
+//! Compute and export the Fourier amplitude spectra of the SMC components
+//! Components are written as blocks separated by two blank lines.
+//!
+//! @returns nothing
+//!************************************************************************
+/* slot */ void SignalGenerator::handleSmcFourierSpectrum()
+{
+    bool ok = false;
+    double bandwidth = QInputDialog::getDouble( this,
+                                                "SMC Fourier spectra",
+                                                "Konno-Ohmachi bandwidth (0 = no smoothing):",
+                                                FourierSpectrum::KONNO_OHMACHI_BANDWIDTH,
+                                                0,
+                                                FourierSpectrum::KONNO_OHMACHI_BANDWIDTH_MAX,
+                                                1,
+                                                &ok
+                                               );
+
+    if( !ok )
+    {
+        return;
+    }
+
+    QString selectedFilter;
+    QString fileName = QFileDialog::getSaveFileName( this,
+                                                     "Export SMC Fourier spectra",
+                                                     "",
+                                                     "Text files (*.txt);;All files (*)",
+                                                     &selectedFilter,
+                                                     QFileDialog::DontUseNativeDialog
+                                                    );
+
+    std::ofstream outputFile;
+    outputFile.open( fileName.toStdString() );
+
+    if( outputFile.is_open() )
+    {
+        FourierSpectrum fourierSpectrum( FourierSpectrum::WINDOW_TUKEY, bandwidth );
+
+        outputFile << std::scientific << std::setprecision( 7 );
+
+        for( size_t i = 0; i < mSmcVector.size(); i++ )
+        {
+            const Smc& crtSmc = mSmcVector.at( i );
+
+            std::vector<double> frequencyVec;
+            std::vector<double> amplitudeVec;
+            fourierSpectrum.compute( crtSmc.mDataVector, crtSmc.mSamplingRate, frequencyVec, amplitudeVec );
+
+            if( i > 0 )
+            {
+                outputFile << "\n\n";
+            }
+
+            outputFile << "# " << Smc::DATA_TYPE_FILE_STRINGS.at( Smc::DATA_TYPE_FILE_FOURIER_AMPLITUDE_SPECTRA ) << "\n";
+            outputFile << "# " << crtSmc.mTextStationCodeStr << " " << crtSmc.mTextComponentOrientation << "\n";
+            outputFile << "# Konno-Ohmachi bandwidth " << std::defaultfloat << bandwidth << std::scientific << "\n";
+            outputFile << "# frequency [Hz]\tamplitude [m/s]\n";
+
+            for( size_t k = 0; k < frequencyVec.size(); k++ )
+            {
+                outputFile << frequencyVec.at( k ) << "\t" << amplitudeVec.at( k ) << "\n";
+            }
+        }
+
+        outputFile.close();
+    }
+    else if( fileName.size() )
+    {
+        QString msg = "Could not open file \"" + fileName +"\".";
+        QMessageBox msgBox;
+        msgBox.setText( msg );
+        msgBox.exec();
+    }
+}
+
+
+//!************************************************************************
+//! Set the high-pass corner used for deriving velocity and displacement
+//!
+//! @returns nothing
+//!************************************************************************
+/* slot */ void SignalGenerator::handleSmcHighPass()
+{
+    bool ok = false;
+    double cornerHz = QInputDialog::getDouble( this,
+                                               "SMC high-pass filter",
+                                               "Corner frequency [Hz]:",
+                                               mSmcHighPassCornerHz,
+                                               SmcIntegration::HIGH_PASS_CORNER_HZ_MIN,
+                                               SmcIntegration::HIGH_PASS_CORNER_HZ_MAX,
+                                               3,
+                                               &ok
+                                              );
+
+    if( ok && cornerHz != mSmcHighPassCornerHz )
+    {
+        mSmcHighPassCornerHz = cornerHz;
+        deriveSmcVelocityDisplacement();
+
+        if( Smc::DATA_TYPE_FILE_CORRECTED_ACCELEROGRAM != mSmcPlayedDataType )
+        {
+            recreateSmcSignal();
+        }
+    }
+}
+
+
+//!************************************************************************
+//! Open an accelerogram from a SMC (Strong Motion CD) data file
+//!
+//! @returns nothing
+//!************************************************************************
+/* slot */ void SignalGenerator::handleSmcOpen()
+{
+    if( !mSignalUndefined && !mSignalReady )
+    {
+        QString msg = "Please save the current signal first.";
+        QMessageBox msgBox;
+        msgBox.setText( msg );
+        msgBox.exec();
+    }
+    else if( !mSignalUndefined && mSignalStarted )
     {
         QString msg = "Please stop generating the current signal first.";
         QMessageBox msgBox;
@@ -4772,9 +4688,11 @@ void SignalGenerator::handleSignalChangedNoiseGamma
         mSignalStarted = false;
         mSignalPaused = false;
         mSignalIsSmc = false;
+        mSmcPlaylistEntries.clear();
+        mSmcPlaylist.reset();
         mIsSignalEdited = false;
 
-        mSignalsVector.clear();
+        mSignalList.clear();
 
         mAudioOutput->stop();
 
@@ -4784,604 +4702,413 @@ void SignalGenerator::handleSignalChangedNoiseGamma
         }
 
         QString selectedFilter;
-        QString fileName = QFileDialog::getOpenFileName( this,
-                                                         "Open SMC file",
-                                                         "",
-                                                         "SMC files (*.smc);;All files (*)",
-                                                         &selectedFilter,
-                                                         QFileDialog::DontUseNativeDialog
-                                                        );
+        QStringList fileNames = QFileDialog::getOpenFileNames( this,
+                                                               "Open strong-motion file(s)",
+                                                               "",
+                                                               "Strong-motion files (*.smc *.v1 *.V1 *.v2 *.V2 *.at2 *.AT2 *.mseed *.miniseed)"
+                                                               ";;SMC files (*.smc);;COSMOS files (*.v1 *.V1 *.v2 *.V2)"
+                                                               ";;PEER NGA files (*.at2 *.AT2);;miniSEED files (*.mseed *.miniseed)"
+                                                               ";;All files (*)",
+                                                               &selectedFilter,
+                                                               QFileDialog::DontUseNativeDialog
+                                                              );
+
+        mSmcVector.clear();
+        mSmcInputFilename.clear();
+
+        std::vector<std::string> fileNameVec;
+
+        for( const QString& fileName : fileNames )
+        {
+            fileNameVec.push_back( fileName.toStdString() );
+        }
 
-        mSmcInputFilename = fileName.toStdString();
-        std::ifstream inputFile( mSmcInputFilename );
+        std::vector<StrongMotionReader::FileResult> resultVec = StrongMotionReader::readFiles( fileNameVec );
 
-        if( inputFile.is_open() )
+        bool componentsOk = !resultVec.empty();
+
+        for( StrongMotionReader::FileResult& result : resultVec )
         {
-            mSmc = Smc();
+            if( result.error.size() )
+            {
+                componentsOk = false;
 
-            std::vector<int16_t> intHeaderVec;
-            intHeaderVec.resize( Smc::HEADER_INT_LINES_COUNT * Smc::HEADER_INT_VALUES_PER_LINE );
+                QString msg = "Could not read file \"" + QString::fromStdString( result.fileName ) + "\"";
 
-            std::vector<double> realHeaderVec;
-            realHeaderVec.resize( Smc::HEADER_REAL_LINES_COUNT * Smc::HEADER_REAL_VALUES_PER_LINE );
+                if( result.formatName.size() )
+                {
+                    msg += " as " + QString::fromStdString( result.formatName );
+                }
 
-            std::vector<std::string> substringsVec;
+                msg += ".\n" + QString::fromStdString( result.error );
+                QMessageBox msgBox;
+                msgBox.setText( msg );
+                msgBox.exec();
 
-            const std::string STAR = "*";
+                break;
+            }
 
-            std::string currentLine;
-            int crtLineNr = 0;
+            std::move( result.recordVec.begin(), result.recordVec.end(), std::back_inserter( mSmcVector ) );
 
-            while( getline( inputFile, currentLine ) && mSmc.mSmcFormatOk )
+            if( mSmcInputFilename.size() )
             {
-                crtLineNr++;
+                mSmcInputFilename += "; ";
+            }
 
-                if( crtLineNr <= Smc::LAST_TEXT_LINE_NR )
-                {
-                    ///////////////////////
-                    // text header
-                    ///////////////////////
+            mSmcInputFilename += result.fileName;
+        }
 
-                    switch( crtLineNr )
-                    {
-                        case 1:
-                            {
-                                bool typefound = false;
-                                size_t i = 0;
-                                trim( currentLine );
-
-                                for( i = 0; i < Smc::DATA_TYPE_FILE_STRINGS.size(); i++ )
-                                {
-                                    if( Smc::DATA_TYPE_FILE_STRINGS.at( static_cast<Smc::DataTypeFile>( i ) ) == currentLine )
-                                    {
-                                        typefound = true;
-                                        break;
-                                    }
-                                }
-
-                                if( !typefound )
-                                {
-                                    mSmc.mSmcFormatOk = false;
-                                    mSmc.mSmcTypeAccelerogram = false;
-
-                                    QString msg = "Current file has no SMC header.";
-                                    QMessageBox msgBox;
-                                    msgBox.setText( msg );
-                                    msgBox.exec();
-
-                                    break;
-                                }
-                                else
-                                {
-                                    mSmc.mTextDataTypeFile = static_cast<Smc::DataTypeFile>( i );
-
-                                    if( Smc::DATA_TYPE_FILE_UNCORRECTED_ACCELEROGRAM != mSmc.mTextDataTypeFile
-                                     && Smc::DATA_TYPE_FILE_CORRECTED_ACCELEROGRAM != mSmc.mTextDataTypeFile )
-                                    {
-                                        mSmc.mSmcTypeAccelerogram = false;
-                                    }
-
-                                    if( !mSmc.mSmcTypeAccelerogram )
-                                    {
-                                        QString msg = "Current file is not an accelerogram in SMC format.";
-                                        QMessageBox msgBox;
-                                        msgBox.setText( msg );
-                                        msgBox.exec();
-
-                                        break;
-                                    }
-                                }
-                            }
-                            break;
-
-                        case 3:
-                            trim( currentLine );
-
-                            if( STAR != currentLine )
-                            {
-                                mSmc.mTextStationCodeStr = currentLine;
-                            }
-                            break;
-
-                        case 4:
-                            {
-                                std::string tmpStr = currentLine.substr( 0, 3 );
-
-                                for( char c : tmpStr )
-                                {
-                                    if( ' ' != c )
-                                    {
-                                        mSmc.mTextTimeZone = tmpStr;
-                                        break;
-                                    }
-                                }
-
-                                mSmc.mTextEarthquakeYear = currentLine.substr( 5, 4 );
-                                mSmc.mTextEarthquakeMonth = currentLine.substr( 11, 2 );
-                                mSmc.mTextEarthquakeDay = currentLine.substr( 15, 2 );
-                                mSmc.mTextEarthquakeHour = currentLine.substr( 21, 2 );
-                                mSmc.mTextEarthquakeMinute = currentLine.substr( 23, 2 );
-
-                                mSmc.mEarthquakeTimeStamp = mSmc.mTextEarthquakeYear + "." + mSmc.mTextEarthquakeMonth + "." + mSmc.mTextEarthquakeDay;
-                                mSmc.mEarthquakeTimeStamp += " " + mSmc.mTextEarthquakeHour + ":" + mSmc.mTextEarthquakeMinute;
-
-                                tmpStr = currentLine.substr( 26, 53 );
-                                trim( tmpStr );
-                                mSmc.mTextEarthquakeName = tmpStr;
-                            }
-                            break;
-
-                        case 5:
-                            mSmc.mSmcFormatOk = ( "Moment Mag=" == currentLine.substr( 0, 11 )
-                                               && "Ms=" == currentLine.substr( 21, 3 )
-                                               && "Ml=" == currentLine.substr( 34, 3 ) );
-
-                            if( mSmc.mSmcFormatOk )
-                            {
-                                std::string tmpStr = currentLine.substr( 11, 9 );
-                                trim( tmpStr );
-                                mSmc.mTextMomentMagnitude = tmpStr;
-
-                                tmpStr = currentLine.substr( 24, 9 );
-                                trim( tmpStr );
-                                mSmc.mTextSurfaceWaveMagnitude = tmpStr;
-
-                                tmpStr = currentLine.substr( 37, 9 );
-                                trim( tmpStr );
-                                mSmc.mTextLocalMagnitude = tmpStr;
-                            }
-                            break;
-
-                        case 6:
-                            mSmc.mSmcFormatOk = ( ( "station = " == currentLine.substr( 0, 10 ) || "Station = " == currentLine.substr( 0, 10 ) )
-                                               && "component=" == currentLine.substr( 41, 10 ) );
-
-                            if( mSmc.mSmcFormatOk )
-                            {
-                                std::string tmpStr = currentLine.substr( 10, 30 );
-                                trim( tmpStr );
-                                mSmc.mTextStationName = tmpStr;
-
-                                tmpStr = currentLine.substr( 52, 6 );
-                                trim( tmpStr );
-                                mSmc.mTextComponentOrientation = tmpStr;
-                            }
-                            else
-                            {
-                                mSmc.mSmcFormatOk = ( ( "station = " == currentLine.substr( 0, 10 ) || "Station = " == currentLine.substr( 0, 10 ) )
-                                                   && "component=" == currentLine.substr( 36, 10 ) );
-
-                                if( mSmc.mSmcFormatOk )
-                                {
-                                    std::string tmpStr = currentLine.substr( 10, 25 );
-                                    trim( tmpStr );
-                                    mSmc.mTextStationName = tmpStr;
-
-                                    tmpStr = currentLine.substr( 47, 6 );
-                                    trim( tmpStr );
-                                    mSmc.mTextComponentOrientation = tmpStr;
-                                }
-                            }
-                            break;
-
-                        case 7:
-                            mSmc.mSmcFormatOk = ( "epicentral dist =" == currentLine.substr( 0, 17 )
-                                             && ( "pk acc =" == currentLine.substr( 33, 8 )
-                                               || "pk     =" == currentLine.substr( 33, 8 ) )
-                                                );
+        if( componentsOk )
+        {
+            deriveSmcVelocityDisplacement();
 
-                            if( mSmc.mSmcFormatOk )
-                            {
-                                std::string tmpStr = currentLine.substr( 17, 9 );
-                                trim( tmpStr );
-                                mSmc.mTextEpicentralDistanceKm = tmpStr;
-
-                                tmpStr = currentLine.substr( 41, 10 );
-                                trim( tmpStr );
-
-                                try
-                                {
-                                    // if a value is provided, convert cm/s2 -> m/s2
-                                    double pkAccel = std::stod( tmpStr );
-                                    pkAccel *= 1.e-2;
-                                    mSmc.mTextPeakAcceleration = std::to_string( pkAccel );
-                                }
-                                catch( const std::invalid_argument& )
-                                {
-                                    mSmc.mTextPeakAcceleration = tmpStr;
-                                }
-                            }
-                            break;
-
-                        case 8:
-                            mSmc.mSmcFormatOk = ( "inst type=" == currentLine.substr( 0, 10 )
-                                               && "data source =" == currentLine.substr( 21, 13 ) );
-
-                            if( mSmc.mSmcFormatOk )
-                            {
-                                std::string tmpStr = currentLine.substr( 10, 5 );
-                                trim( tmpStr );
-                                mSmc.mTextSensorTypeStr = tmpStr;
-
-                                tmpStr = currentLine.substr( 35, 45 );
-                                trim( tmpStr );
-                                mSmc.mTextDataSourceStr = tmpStr;
-                            }
-                            break;
-
-                        case 2:
-                        case 9:
-                        case 10:
-                        case 11:
-                            trim( currentLine );
-
-                            if( mSmc.mSmcFormatOk )
-                            {
-                                mSmc.mSmcFormatOk = ( STAR == currentLine );
-                            }
-                            break;
-
-                        default:
-                            mSmc.mSmcFormatOk = false;
-                            break;
-                    }
-                }
-                else if( crtLineNr <= Smc::LAST_INT_LINE_NR )
-                {
-                    ///////////////////////
-                    // integer header
-                    ///////////////////////
+            mSignalUndefined = false;
+            mSignalReady = true;
+            mSignalIsSmc = true;
 
-                    if( Smc::LAST_TEXT_LINE_NR + 1 == crtLineNr )
-                    {
-                        substringsVec.clear();
-                    }
+            mRequiredChannelCount = ( mSmcVector.size() > 1 ) ? static_cast<int>( mSmcVector.size() ) : 0;
 
-                    for( size_t i = 0; i < currentLine.size(); i += Smc::HEADER_INT_VALUE_LENGTH )
-                    {
-                        substringsVec.push_back( currentLine.substr( i, Smc::HEADER_INT_VALUE_LENGTH ) );
-                    }
+            if( mRequiredChannelCount > mAudioFormat.channelCount() )
+            {
+                mAudioOutput->disconnect( this );
 
-                    if( Smc::LAST_INT_LINE_NR == crtLineNr )
-                    {
-                        std::vector<int16_t> tmpIntVec( substringsVec.size() );
-
-                        for( size_t i = 0; i < tmpIntVec.size(); i++ )
-                        {
-                            tmpIntVec.at( i ) = std::stoi( substringsVec.at( i ) );
-                        }
-
-                        mSmc.mNoValueInteger = tmpIntVec.at( Smc::INT_FIELD_UNDEFINED_VALUE );
-
-                        mSmc.mVerticalOrientation = tmpIntVec.at( Smc::INT_FIELD_VERTICAL_ORIENTATION_FROM_UP );
-                        mSmc.mHorizontalOrientation = tmpIntVec.at( Smc::INT_FIELD_HORIZONTAL_ORIENTATION_FROM_NORTH_TO_EAST );
-
-                        mSmc.mSensorTypeCode = tmpIntVec.at( Smc::INT_FIELD_SENSOR_TYPE_CODE );
-
-                        if( checkValidInteger( mSmc.mSensorTypeCode ) )
-                        {
-                            mSmc.mSensorTypeStr = Smc::SENSOR_TYPE_NAMES.at( mSmc.mSensorTypeCode );
-                        }
-                        else
-                        {
-                            mSmc.mSensorTypeStr = "undefined";
-                        }
-
-                        mSmc.mHeaderCommentLinesCount = tmpIntVec.at( Smc::INT_FIELD_NR_OF_COMMENT_LINES );
-
-                        mSmc.mDataValuesCount = tmpIntVec.at( Smc::INT_FIELD_NR_OF_VALUES );
-
-                        if( checkValidInteger( mSmc.mDataValuesCount ) )
-                        {
-                            mSmc.mDataValuesRecordedCount = mSmc.mDataValuesCount;
-                        }
-                        else
-                        {
-                            mSmc.mSmcFormatOk = false;
-
-                            QString msg = "No valid data length found in SMC file.";
-                            QMessageBox msgBox;
-                            msgBox.setText( msg );
-                            msgBox.exec();
-
-                            break;
-                        }
-
-                        mSmc.mDataLinesCount = static_cast<uint16_t>( std::ceil( static_cast<double>( mSmc.mDataValuesCount ) / Smc::DATA_VALUES_PER_LINE ) );
-
-                        if( 0 == mSmc.mDataLinesCount )
-                        {
-                            mSmc.mSmcFormatOk = false;
-
-                            QString msg = "No data values specified in SMC file.";
-                            QMessageBox msgBox;
-                            msgBox.setText( msg );
-                            msgBox.exec();
-
-                            break;
-                        }
-
-                        mSmc.mStructureType = static_cast<Smc::StructureType>( tmpIntVec.at( Smc::INT_FIELD_STRUCTURE_TYPE ) );
-
-                        mSmc.mStructureTypeName = "unknown";
-
-                        if( mSmc.mStructureType <= Smc::STRUCTURE_TYPE_MAX_KNOWN )
-                        {
-                            mSmc.mStructureTypeName = Smc::STRUCTURE_TYPE_NAMES.at( mSmc.mStructureType );
-                        }
-
-                        switch( mSmc.mStructureType )
-                        {
-                            case Smc::STRUCTURE_TYPE_BUILDING:
-                                mSmc.mStructureBuilding.nrFloorsAboveGrade = tmpIntVec.at( Smc::INT_FIELD_TOTAL_NR_OF_FLOORS_ABOVE_GRADE );
-                                mSmc.mStructureBuilding.nrStoriesBelowGrade = tmpIntVec.at( Smc::INT_FIELD_TOTAL_NR_OF_STORIES_BELOW_GRADE );
-                                mSmc.mStructureBuilding.floorNrWhereLocated = tmpIntVec.at( Smc::INT_FIELD_FLOOR_NR );
-                                break;
-
-                            case Smc::STRUCTURE_TYPE_BRIDGE:
-                                mSmc.mStructureBridge.nrSpans = tmpIntVec.at( Smc::INT_FIELD_NR_OF_SPANS );
-                                mSmc.mStructureBridge.whereLocated =
-                                        static_cast<Smc::BridgeLocation>( tmpIntVec.at( static_cast<size_t>( Smc::INT_FIELD_TRANSDUCER_LOCATION_BRIDGES ) ) );
-                                break;
-
-                            case Smc::STRUCTURE_TYPE_DAM:
-                                mSmc.mStructureDam.location =
-                                    static_cast<Smc::DamLocation>( tmpIntVec.at( static_cast<size_t>( Smc::INT_FIELD_TRANSDUCER_LOCATION_DAMS ) ) );
-                                mSmc.mStructureDam.constructionType =
-                                    static_cast<Smc::DamConstructionType>( tmpIntVec.at( static_cast<size_t>( Smc::INT_FIELD_CONSTRUCTION_TYPE ) ) );
-                                break;
-
-                            default:
-                                break;
-                        }
-
-                        mSmc.mStationNr = tmpIntVec.at( Smc::INT_FIELD_STATION_NR );
-
-                        mSmc.mFirstRecordedSampleIndex = tmpIntVec.at( Smc::INT_FIELD_FIRST_RECORDED_SAMPLE );
-                        mSmc.mLastRecordedSampleIndex = tmpIntVec.at( Smc::INT_FIELD_LAST_RECORDED_SAMPLE );
-
-                        if( checkValidInteger( mSmc.mFirstRecordedSampleIndex ) )
-                        {
-                            if( mSmc.mFirstRecordedSampleIndex >= 1
-                             && mSmc.mFirstRecordedSampleIndex <= mSmc.mDataValuesCount )
-                            {
-                                mSmc.mDataValuesRecordedCount -= ( mSmc.mFirstRecordedSampleIndex - 1 );
-                            }
-                            else
-                            {
-                                mSmc.mFirstRecordedSampleIndex = 1;
-                            }
-                        }
-                        else
-                        {
-                            mSmc.mFirstRecordedSampleIndex = 1;
-                        }
-
-                        if( checkValidInteger( mSmc.mLastRecordedSampleIndex ) )
-                        {
-                            if( mSmc.mLastRecordedSampleIndex <= mSmc.mDataValuesCount
-                             && mSmc.mLastRecordedSampleIndex >= 1 )
-                            {
-                                mSmc.mDataValuesRecordedCount -= ( mSmc.mDataValuesCount - mSmc.mLastRecordedSampleIndex );
-                            }
-                            else
-                            {
-                                mSmc.mLastRecordedSampleIndex = mSmc.mDataValuesCount;
-                            }
-                        }
-                        else
-                        {
-                            mSmc.mLastRecordedSampleIndex = mSmc.mDataValuesCount;
-                        }
-
-                        mSmc.mDataVector.resize( mSmc.mDataValuesRecordedCount );
-                    }
-                }
-                else if( crtLineNr <= Smc::LAST_REAL_LINE_NR )
+                if( !initializeAudio( mMainUi->GenerateDeviceComboBox->currentData().value<QAudioDevice>() ) )
                 {
-                    ///////////////////////
-                    // real header
-                    ///////////////////////
+                    QMessageBox::warning( this,
+                                          "SignalGenerator",
+                                          "The audio device does not support " + QString::number( mRequiredChannelCount ) + " output channels."
+                                          "\nSome SMC components may not be generated.",
+                                          QMessageBox::Ok
+                                         );
+                }
+            }
 
-                    if( Smc::LAST_INT_LINE_NR + 1 == crtLineNr )
-                    {
-                        substringsVec.clear();
-                    }
+            createSmcSignal();
 
-                    for( size_t i = 0; i < currentLine.size(); i += Smc::HEADER_REAL_VALUE_LENGTH )
-                    {
-                        substringsVec.push_back( currentLine.substr( i, Smc::HEADER_REAL_VALUE_LENGTH ) );
-                    }
+            setAudioData();
+        }
+        else
+        {
+            mSmcVector.clear();
+            mSmcInputFilename.clear();
+        }
 
-                    if( Smc::LAST_REAL_LINE_NR == crtLineNr )
-                    {
-                        std::vector<double> tmpRealVec( substringsVec.size() );
-
-                        for( size_t i = 0; i < tmpRealVec.size(); i++ )
-                        {
-                            tmpRealVec.at( i ) = std::stod( substringsVec.at( i ) );
-                        }
-
-                        mSmc.mNoValueReal = tmpRealVec.at( Smc::REAL_FIELD_UNDEFINED_VALUE );
-
-                        mSmc.mSamplingRate = tmpRealVec.at( Smc::REAL_FIELD_SAMPLING_RATE );
-
-                        if( checkValidReal( mSmc.mSamplingRate ) )
-                        {
-                            if( mSmc.mSamplingRate > 0 )
-                            {
-                                mSmc.mDataLengthSeconds = mSmc.mDataValuesRecordedCount / mSmc.mSamplingRate;
-                            }
-                            else
-                            {
-                                mSmc.mSmcFormatOk = false;
-
-                                QString msg = "Invalid sampling rate value found in SMC file.";
-                                QMessageBox msgBox;
-                                msgBox.setText( msg );
-                                msgBox.exec();
-
-                                break;
-                            }
-                        }
-                        else
-                        {
-                            mSmc.mSmcFormatOk = false;
-
-                            QString msg = "No data sampling rate found in SMC file.";
-                            QMessageBox msgBox;
-                            msgBox.setText( msg );
-                            msgBox.exec();
-
-                            break;
-                        }
-
-                        mSmc.mEpicenter.latitude = tmpRealVec.at( Smc::REAL_FIELD_EARTHQUAKE_LATITUDE );
-                        mSmc.mEpicenter.longitude = tmpRealVec.at( Smc::REAL_FIELD_EARTHQUAKE_LONGITUDE );
-                        mSmc.mEpicenter.depthKm = tmpRealVec.at( Smc::REAL_FIELD_EARTHQUAKE_DEPTH_KM );
-
-                        mSmc.mEarthquakeMagnitude.momentMagnitude = tmpRealVec.at( Smc::REAL_FIELD_SOURCE_MOMENT_MAGNITUDE );
-                        mSmc.mEarthquakeMagnitude.surfaceWaveMagnitude = tmpRealVec.at( Smc::REAL_FIELD_SOURCE_SURFACE_WAVE_MAGNITUDE );
-                        mSmc.mEarthquakeMagnitude.localMagnitude = tmpRealVec.at( Smc::REAL_FIELD_SOURCE_LOCAL_MAGNITUDE );
-                        mSmc.mEarthquakeMagnitude.other = tmpRealVec.at( Smc::REAL_FIELD_SOURCE_OTHER );
-
-                        mSmc.mSeismicMomentNm = tmpRealVec.at( Smc::REAL_FIELD_SEISMIC_MOMENT_DYNE_CM );
-
-                        if( checkValidReal( mSmc.mSeismicMomentNm ) )
-                        {
-                            mSmc.mSeismicMomentNm *= 1.e-7; // dyn-cm to Nm
-                        }
-
-                        mSmc.mStation.latitude = tmpRealVec.at( Smc::REAL_FIELD_STATION_LATITUDE );
-                        mSmc.mStation.longitude = tmpRealVec.at( Smc::REAL_FIELD_STATION_LONGITUDE );
-                        mSmc.mStation.elevationMeters = tmpRealVec.at( Smc::REAL_FIELD_STATION_ELEVATION_M );
-                        mSmc.mStation.offsetNorthMeters = tmpRealVec.at( Smc::REAL_FIELD_STATION_OFFSET_N_M );
-                        mSmc.mStation.offsetEastMeters = tmpRealVec.at( Smc::REAL_FIELD_STATION_OFFSET_E_M );
-                        mSmc.mStation.offsetUpMeters = tmpRealVec.at( Smc::REAL_FIELD_STATION_OFFSET_UP_M );
-
-                        mSmc.mEpicentralDistanceKm = tmpRealVec.at( Smc::REAL_FIELD_EPICENTRAL_DISTANCE_KM );
-                        mSmc.mEpicenterToStationAzimuth = tmpRealVec.at( Smc::REAL_FIELD_EPICENTER_TO_STATION_AZIMUTH );
-
-                        mSmc.mDigitizationUnitsPerCm = tmpRealVec.at( Smc::REAL_FIELD_DIGITIZATION_UNITS_1_CM );
-
-                        mSmc.mSensorCutoffFrequency = tmpRealVec.at( Smc::REAL_FIELD_SENSOR_CUTOFF_FREQUENCY_HZ );
-                        mSmc.mSensorDampingCoefficient = tmpRealVec.at( Smc::REAL_FIELD_SENSOR_DAMPING_COEFFICIENT );
-
-                        mSmc.mRecorderSensitivityCmG = tmpRealVec.at( Smc::REAL_FIELD_RECORDER_SENSITIVITY_CM_G );
-
-                        mSmc.mMaximumFromRecord.time = tmpRealVec.at( Smc::REAL_FIELD_TIME_OF_MAXIMUM_S );
-                        mSmc.mMaximumFromRecord.accelerationMs2 = tmpRealVec.at( Smc::REAL_FIELD_VALUE_OF_MAXIMUM_CM_S2 );
-
-                        if( checkValidReal( mSmc.mMaximumFromRecord.accelerationMs2 ) )
-                        {
-                            mSmc.mMaximumFromRecord.accelerationMs2 *= 1.e-2; // m/s2
-                        }
-
-                        mSmc.mMinimumFromRecord.time = tmpRealVec.at( Smc::REAL_FIELD_TIME_OF_MINIMUM_S );
-                        mSmc.mMinimumFromRecord.accelerationMs2 = tmpRealVec.at( Smc::REAL_FIELD_VALUE_OF_MINIMUM_CM_S2 );
-
-                        if( checkValidReal( mSmc.mMinimumFromRecord.accelerationMs2 ) )
-                        {
-                            mSmc.mMinimumFromRecord.accelerationMs2 *= 1.e-2; // m/s2
-                        }
-                    }
-                }
-                else if( crtLineNr <= Smc::LAST_REAL_LINE_NR + mSmc.mHeaderCommentLinesCount )
-                {
-                    ///////////////////////
-                    // comments header
-                    ///////////////////////
+        updateControls();
+    }
+}
 
-                    if( Smc::LAST_INT_LINE_NR + 1 == crtLineNr )
-                    {
-                        substringsVec.clear();
-                    }
 
-                    substringsVec.push_back( currentLine );
+//!************************************************************************
+//! Open a playlist of strong-motion records, played back to back
+//! Either a playlist file, or data files which become one entry each.
+//!
+//! @returns nothing
+//!************************************************************************
+/* slot */ void SignalGenerator::handleSmcOpenPlaylist()
+{
+    if( !mSignalUndefined && !mSignalReady )
+    {
+        QString msg = "Please save the current signal first.";
+        QMessageBox msgBox;
+        msgBox.setText( msg );
+        msgBox.exec();
+    }
+    else if( !mSignalUndefined && mSignalStarted )
+    {
+        QString msg = "Please stop generating the current signal first.";
+        QMessageBox msgBox;
+        msgBox.setText( msg );
+        msgBox.exec();
+    }
+    else
+    {
+        mSignalUndefined = true;
+        mSignalReady = false;
+        mSignalStarted = false;
+        mSignalPaused = false;
+        mSignalIsSmc = false;
+        mSmcPlaylistEntries.clear();
+        mSmcPlaylist.reset();
+        mSmcPlaylistLastError.clear();
+        mIsSignalEdited = false;
 
-                    if( Smc::LAST_REAL_LINE_NR + mSmc.mHeaderCommentLinesCount == crtLineNr )
-                    {
-                        // intentionally do nothing
-                    }
-                }
-                else if( crtLineNr <= Smc::LAST_REAL_LINE_NR + mSmc.mHeaderCommentLinesCount + mSmc.mDataLinesCount )
-                {
-                    ///////////////////////
-                    // data
-                    ///////////////////////
+        mSignalList.clear();
 
-                    if( Smc::LAST_REAL_LINE_NR + mSmc.mHeaderCommentLinesCount + 1 == crtLineNr )
-                    {
-                        substringsVec.clear();
-                    }
+        mAudioOutput->stop();
 
-                    for( size_t i = 0; i < currentLine.size(); i += Smc::DATA_VALUE_LENGTH )
-                    {
-                        substringsVec.push_back( currentLine.substr( i, Smc::DATA_VALUE_LENGTH ) );
-                    }
+        if( mAudioSrc )
+        {
+            mAudioSrc->stop();
+        }
 
-                    if( Smc::LAST_REAL_LINE_NR + mSmc.mHeaderCommentLinesCount + mSmc.mDataLinesCount == crtLineNr )
-                    {
-                        std::vector<double> dataVec( substringsVec.size() );
+        QString selectedFilter;
+        QStringList fileNames = QFileDialog::getOpenFileNames( this,
+                                                               "Open strong-motion playlist",
+                                                               "",
+                                                               "Playlists (*.m3u *.txt)"
+                                                               ";;Strong-motion files (*.smc *.v1 *.V1 *.v2 *.V2 *.at2 *.AT2 *.mseed *.miniseed)"
+                                                               ";;All files (*)",
+                                                               &selectedFilter,
+                                                               QFileDialog::DontUseNativeDialog
+                                                              );
+
+        mSmcVector.clear();
+        mSmcInputFilename.clear();
+
+        std::vector<SmcPlaylist::Entry> entryVec;
+
+        if( 1 == fileNames.size()
+         && ( fileNames.front().endsWith( ".m3u", Qt::CaseInsensitive ) || fileNames.front().endsWith( ".txt", Qt::CaseInsensitive ) ) )
+        {
+            std::string error;
 
-                        for( size_t i = 0; i < dataVec.size(); i++ )
-                        {
-                            dataVec.at( i ) = std::stod( substringsVec.at( i ) );
-                        }
+            if( !SmcPlaylist::readPlaylistFile( fileNames.front().toStdString(), entryVec, error ) )
+            {
+                QString msg = "Could not read playlist \"" + fileNames.front() + "\".\n" + QString::fromStdString( error );
+                QMessageBox msgBox;
+                msgBox.setText( msg );
+                msgBox.exec();
+            }
+        }
+        else
+        {
+            for( const QString& fileName : fileNames )
+            {
+                entryVec.push_back( SmcPlaylist::Entry( 1, fileName.toStdString() ) );
+            }
+        }
 
-                        if( dataVec.size() != mSmc.mDataValuesCount )
-                        {
-                            mSmc.mSmcFormatOk = false;
+        if( entryVec.size() )
+        {
+            mSmcPlaylistEntries = entryVec;
 
-                            QString msg = "Expected data length was " + QString::number( mSmc.mDataValuesCount )
-                                    + " , it is " + QString::number( dataVec.size() ) + ".";
-                            QMessageBox msgBox;
-                            msgBox.setText( msg );
-                            msgBox.exec();
+            mSignalUndefined = false;
+            mSignalReady = true;
+            mSignalIsSmc = true;
 
-                            break;
-                        }
+            size_t componentsCount = 0;
 
-                        size_t firstRecordedIndex = mSmc.mFirstRecordedSampleIndex - 1;
-                        size_t lastRecordedIndex = dataVec.size() - 1 - ( mSmc.mDataValuesCount - mSmc.mLastRecordedSampleIndex );
+            for( const SmcPlaylist::Entry& entry : mSmcPlaylistEntries )
+            {
+                componentsCount = std::max( componentsCount, entry.size() );
+            }
 
-                        for( size_t i = firstRecordedIndex, j = 0; i <= lastRecordedIndex; i++, j++ )
-                        {
-                            mSmc.mDataVector.at( j ) = 0.1 * dataVec.at( i ); // m/s2
-                        }
-                    }
+            mRequiredChannelCount = ( componentsCount > 1 ) ? static_cast<int>( componentsCount ) : 0;
+
+            if( mRequiredChannelCount > mAudioFormat.channelCount() )
+            {
+                mAudioOutput->disconnect( this );
+
+                if( !initializeAudio( mMainUi->GenerateDeviceComboBox->currentData().value<QAudioDevice>() ) )
+                {
+                    QMessageBox::warning( this,
+                                          "SignalGenerator",
+                                          "The audio device does not support " + QString::number( mRequiredChannelCount ) + " output channels."
+                                          "\nSome SMC components may not be generated.",
+                                          QMessageBox::Ok
+                                         );
                 }
             }
 
-            inputFile.close();
+            // the playlist is rendered while playing, the buffer only drives the progress bar
+            mAudioBufferLength = 1;
 
-            if( mSmc.mSmcFormatOk )
-            {
-                mSignalUndefined = false;
-                mSignalReady = true;
-                mSignalIsSmc = true;
+            mCurrentSignalType = SignalItem::SIGNAL_TYPE_SMC;
+            int crtTab = mCurrentSignalType - SignalItem::SIGNAL_TYPE_FIRST;
+            mMainUi->SignalTypesTab->setCurrentIndex( crtTab );
+            handleSignalTypeChanged();
 
-                createSmcSignal();
+            setAudioData();
+            updateAudioBufferTimer();
+        }
 
-                setAudioData();
+        updateControls();
+    }
+}
+
+
+//!************************************************************************
+//! Select the SMC data to be played
+//!
+//! @returns nothing
+//!************************************************************************
+/* slot */ void SignalGenerator::handleSmcPlayedDataChanged
+    (
+    QAction*    aAction     //!< selected action
+    )
+{
+    if( mMainUi->actionSmcPlayVelocity == aAction )
+    {
+        mSmcPlayedDataType = Smc::DATA_TYPE_FILE_VELOCITY;
+    }
+    else if( mMainUi->actionSmcPlayDisplacement == aAction )
+    {
+        mSmcPlayedDataType = Smc::DATA_TYPE_FILE_DISPLACEMENT;
+    }
+    else
+    {
+        mSmcPlayedDataType = Smc::DATA_TYPE_FILE_CORRECTED_ACCELEROGRAM;
+    }
+
+    recreateSmcSignal();
+}
+
+
+//!************************************************************************
+//! Set the silence between playlist entries
+//!
+//! @returns nothing
+//!************************************************************************
+/* slot */ void SignalGenerator::handleSmcPlaylistGap()
+{
+    bool ok = false;
+    double gapSeconds = QInputDialog::getDouble( this,
+                                                 "SMC playlist",
+                                                 "Gap between entries [s]:",
+                                                 mSmcPlaylistGapSeconds,
+                                                 0,
+                                                 SmcPlaylist::GAP_SECONDS_MAX,
+                                                 2,
+                                                 &ok
+                                                );
+
+    if( ok && gapSeconds != mSmcPlaylistGapSeconds )
+    {
+        mSmcPlaylistGapSeconds = gapSeconds;
+
+        if( mSmcPlaylistEntries.size() )
+        {
+            recreateSmcSignal();
+        }
+    }
+}
+
+
+//!************************************************************************
+//! Select if the playlist restarts after its last entry
+//!
+//! @returns nothing
+//!************************************************************************
+/* slot */ void SignalGenerator::handleSmcPlaylistLoop
+    (
+    bool    aChecked    //!< true to loop
+    )
+{
+    mSmcPlaylistLoop = aChecked;
+
+    if( mSmcPlaylistEntries.size() )
+    {
+        recreateSmcSignal();
+    }
+}
+
+
+//!************************************************************************
+//! Compute and export the elastic response spectra of the SMC components
+//! Components are written as blocks separated by two blank lines.
+//!
+//! @returns nothing
+//!************************************************************************
+/* slot */ void SignalGenerator::handleSmcResponseSpectrum()
+{
+    QString selectedFilter;
+    QString fileName = QFileDialog::getSaveFileName( this,
+                                                     "Export SMC response spectra",
+                                                     "",
+                                                     "Text files (*.txt);;All files (*)",
+                                                     &selectedFilter,
+                                                     QFileDialog::DontUseNativeDialog
+                                                    );
+
+    std::ofstream outputFile;
+    outputFile.open( fileName.toStdString() );
+
+    if( outputFile.is_open() )
+    {
+        ResponseSpectrum responseSpectrum( ResponseSpectrum::createLogPeriods( ResponseSpectrum::PERIOD_MIN_S,
+                                                                               ResponseSpectrum::PERIOD_MAX_S,
+                                                                               ResponseSpectrum::PERIODS_COUNT ),
+                                           ResponseSpectrum::DAMPING_RATIOS );
+
+        const std::vector<double>& periodVec = responseSpectrum.getPeriods();
+
+        outputFile << std::scientific << std::setprecision( 7 );
+
+        for( size_t i = 0; i < mSmcVector.size(); i++ )
+        {
+            const Smc& crtSmc = mSmcVector.at( i );
+
+            std::vector<ResponseSpectrum::Spectrum> spectrumVec;
+            responseSpectrum.compute( crtSmc.mDataVector, crtSmc.mSamplingRate, spectrumVec );
+
+            if( i > 0 )
+            {
+                outputFile << "\n\n";
             }
-            else
+
+            outputFile << "# " << Smc::DATA_TYPE_FILE_STRINGS.at( Smc::DATA_TYPE_FILE_RESPONSE_SPECTRA ) << "\n";
+            outputFile << "# " << crtSmc.mTextStationCodeStr << " " << crtSmc.mTextComponentOrientation << "\n";
+            outputFile << "# period [s]";
+
+            for( const ResponseSpectrum::Spectrum& spectrum : spectrumVec )
             {
-                QString msg = "SMC file format is wrong at line " + QString::number( crtLineNr ) + ".";
-                QMessageBox msgBox;
-                msgBox.setText( msg );
-                msgBox.exec();
+                outputFile << std::defaultfloat
+                           << "\tSD [m] " << spectrum.damping
+                           << "\tPSV [m/s] " << spectrum.damping
+                           << "\tPSA [m/s2] " << spectrum.damping;
             }
 
-            updateControls();
-        }
-        else if( fileName.size() )
-        {
-            QString msg = "Could not open file \"" + fileName +"\".";
-            QMessageBox msgBox;
-            msgBox.setText( msg );
-            msgBox.exec();
+            outputFile << std::scientific << "\n";
+
+            for( size_t p = 0; p < periodVec.size(); p++ )
+            {
+                outputFile << periodVec.at( p );
+
+                for( const ResponseSpectrum::Spectrum& spectrum : spectrumVec )
+                {
+                    outputFile << "\t" << spectrum.sdVec.at( p )
+                               << "\t" << spectrum.psvVec.at( p )
+                               << "\t" << spectrum.psaVec.at( p );
+                }
+
+                outputFile << "\n";
+            }
         }
+
+        outputFile.close();
+    }
+    else if( fileName.size() )
+    {
+        QString msg = "Could not open file \"" + fileName +"\".";
+        QMessageBox msgBox;
+        msgBox.setText( msg );
+        msgBox.exec();
+    }
+}
+
+
+//!************************************************************************
+//! Set the audification factor of the SMC signal
+//!
+//! @returns nothing
+//!************************************************************************
+/* slot */ void SignalGenerator::handleSmcSpeedUp()
+{
+    bool ok = false;
+    double speedUp = QInputDialog::getDouble( this,
+                                              "SMC audification",
+                                              "Speed-up factor (1 = real time):",
+                                              mSmcSpeedUp,
+                                              1,
+                                              SignalItem::SignalSmc::SPEED_UP_MAX,
+                                              1,
+                                              &ok
+                                             );
+
+    if( ok && speedUp != mSmcSpeedUp )
+    {
+        mSmcSpeedUp = speedUp;
+        recreateSmcSignal();
     }
 }
 
@@ -5415,16 +5142,20 @@ bool SignalGenerator::initializeAudio
     const QAudioDevice&     aDeviceInfo     //!< audio device
     )
 {
-    bool status = false;
-    QAudioFormat format = aDeviceInfo.preferredFormat();
-    format.setSampleRate( 44100 );
-    format.setSampleFormat( QAudioFormat::Int16 );
-
-    status = aDeviceInfo.isFormatSupported( format );
+    const QAudioFormat format = negotiateAudioFormat( aDeviceInfo );
+    const bool status = aDeviceInfo.isFormatSupported( format ) && format.channelCount() >= mRequiredChannelCount;
+    mAudioFormat = format;
 
     mAudioSrc.reset( new AudioSource( format, mAudioBufferLength ) );
+    mAudioSrc->setContinuous( mSignalContinuous );
+    mAudioSrc->setBandLimited( mSignalBandLimited );
+    mAudioSrc->setChannelArray( mChannelArrayDelayVec );
     mAudioOutput.reset( new QAudioSink( aDeviceInfo, format ) );
 
+    mMainUi->GenerateDeviceComboBox->setToolTip( QString::number( format.sampleRate() ) + " SPS, "
+                                                 + getSampleFormatName( format.sampleFormat() ) + ", "
+                                                 + QString::number( format.channelCount() ) + " channels" );
+
     qreal initialVolume = QAudio::convertVolume( mAudioOutput->volume(),
                                                  QAudio::LinearVolumeScale,
                                                  QAudio::LogarithmicVolumeScale );
@@ -5438,38 +5169,163 @@ bool SignalGenerator::initializeAudio
 
 
 //!************************************************************************
-//! Set the audio data
+//! Choose the output format among the ones supported by a device
+//! The device's own rate and sample format are kept unless another one is
+//! selected and supported; otherwise the most precise supported format is
+//! taken, float first. The channel count is raised to the required one
+//! within the device limits.
 //!
-//! @returns: nothing
+//! @returns: the output format
 //!************************************************************************
-void SignalGenerator::setAudioData()
+QAudioFormat SignalGenerator::negotiateAudioFormat
+    (
+    const QAudioDevice&     aDeviceInfo     //!< audio device
+    ) const
 {
-    if( mAudioSrc )
+    const QList<QAudioFormat::SampleFormat> supportedFormats = aDeviceInfo.supportedSampleFormats();
+    const QAudioFormat::SampleFormat PRECISION_ORDER[] = { QAudioFormat::Float, QAudioFormat::Int32, QAudioFormat::Int16, QAudioFormat::UInt8 };
+    QAudioFormat format = aDeviceInfo.preferredFormat();
+
+    if( mOutputSampleRate >= aDeviceInfo.minimumSampleRate() && mOutputSampleRate <= aDeviceInfo.maximumSampleRate() )
+    {
+        format.setSampleRate( mOutputSampleRate );
+    }
+
+    if( supportedFormats.contains( mOutputSampleFormat ) )
+    {
+        format.setSampleFormat( mOutputSampleFormat );
+    }
+    else if( !supportedFormats.contains( format.sampleFormat() ) )
     {
-        mAudioSrc->setData( mSignalsVector );
+        for( QAudioFormat::SampleFormat sampleFormat : PRECISION_ORDER )
+        {
+            if( supportedFormats.contains( sampleFormat ) )
+            {
+                format.setSampleFormat( sampleFormat );
+                break;
+            }
+        }
+    }
+
+    if( mRequiredChannelCount > format.channelCount() )
+    {
+        format.setChannelCount( std::min( mRequiredChannelCount, aDeviceInfo.maximumChannelCount() ) );
+    }
+
+    if( !aDeviceInfo.isFormatSupported( format ) )
+    {
+        // fall back to what the device asks for, with as many channels as possible
+        const int channelCount = format.channelCount();
+        format = aDeviceInfo.preferredFormat();
+        format.setChannelCount( channelCount );
+
+        if( !aDeviceInfo.isFormatSupported( format ) )
+        {
+            format = aDeviceInfo.preferredFormat();
+        }
     }
+
+    return format;
 }
 
 
 //!************************************************************************
-//! Trim a string at both ends
+//! Read the signal items from a signal file
+//! Lines which are not valid signal definitions are skipped and reported.
 //!
-//! @returns nothing
+//! @returns: true if the file could be opened
 //!************************************************************************
-void SignalGenerator::trim
+bool SignalGenerator::readSignalFile
     (
-    std::string&    aString         //!< string to trim
+    const std::string&          aFileName,          //!< signal file name
+    SignalList&                 aSignalList,        //!< read signal items
+    QStringList&                aLineStrings,       //!< list strings of the read items
+    QString&                    aErrors             //!< lines which were skipped, with their errors
     )
 {
-    aString.erase( aString.begin(), std::find_if( aString.begin(), aString.end(), []( unsigned char ch )
+    std::vector<SignalFile::Error> errorVec;
+    const size_t firstItem = aSignalList.getSize();
+    const bool fileOpened = SignalFile::readFile( aFileName, aSignalList, errorVec );
+
+    for( size_t i = firstItem; i < aSignalList.getSize(); i++ )
     {
-        return !std::isspace( ch );
-    }));
+        aLineStrings.append( createSignalString( aSignalList.at( i ) ) );
+    }
 
-    aString.erase( std::find_if( aString.rbegin(), aString.rend(), []( unsigned char ch )
+    aErrors.clear();
+
+    for( size_t i = 0; i < errorVec.size() && i < FILE_ERRORS_SHOWN_MAX; i++ )
     {
-        return !std::isspace( ch );
-    } ).base(), aString.end());
+        const SignalFile::Error& error = errorVec.at( i );
+
+        if( error.line )
+        {
+            aErrors += "Line " + QString::number( error.line ) + ", column " + QString::number( error.column ) + ": ";
+        }
+
+        aErrors += QString::fromStdString( error.message ) + "\n";
+    }
+
+    if( errorVec.size() > FILE_ERRORS_SHOWN_MAX )
+    {
+        aErrors += QString::number( errorVec.size() - FILE_ERRORS_SHOWN_MAX ) + " more errors.\n";
+    }
+
+    return fileOpened;
+}
+
+
+//!************************************************************************
+//! Recreate the SMC signal after its settings were changed
+//! The signal is not changed while it is generated.
+//!
+//! @returns: nothing
+//!************************************************************************
+void SignalGenerator::recreateSmcSignal()
+{
+    if( mSignalIsSmc && !mSignalStarted )
+    {
+        if( mSmcPlaylistEntries.empty() )
+        {
+            mSignalList.clear();
+            createSmcSignal();
+        }
+
+        setAudioData();
+        updateControls();
+    }
+}
+
+
+//!************************************************************************
+//! Set the audio data
+//!
+//! @returns: nothing
+//!************************************************************************
+void SignalGenerator::setAudioData()
+{
+    if( mAudioSrc )
+    {
+        if( mSmcPlaylistEntries.size() )
+        {
+            SmcPlaylist::Settings settings;
+            settings.playedDataType = mSmcPlayedDataType;
+            settings.highPassCornerHz = mSmcHighPassCornerHz;
+            settings.speedUp = mSmcSpeedUp;
+            settings.gapSeconds = mSmcPlaylistGapSeconds;
+            settings.loop = mSmcPlaylistLoop;
+
+            mSmcPlaylist = std::make_shared<SmcPlaylist>( mSmcPlaylistEntries,
+                                                          settings,
+                                                          mAudioFormat.sampleRate(),
+                                                          static_cast<uint8_t>( mAudioFormat.channelCount() ) );
+            mAudioSrc->setSmcPlaylist( mSmcPlaylist );
+        }
+        else
+        {
+            mAudioSrc->setData( mSignalList.getSnapshot() );
+        }
+    }
 }
 
 
@@ -5485,14 +5341,75 @@ void SignalGenerator::updateAudioBufferTimer()
         mAudioBufferCounter++;
     }
 
-    int fill = 100 * ( mAudioBufferCounter % static_cast<int>( mAudioBufferLength ) );
+    const int bufferSeconds = std::max( static_cast<int>( mAudioBufferLength ), 1 );
+    int fill = 100 * ( mAudioBufferCounter % bufferSeconds );
 
-    if( 1 != mAudioBufferLength )
+    if( bufferSeconds > 1 )
     {
-        fill /= ( mAudioBufferLength - 1 );
+        fill /= ( bufferSeconds - 1 );
+    }
+
+    // there is no loop to show in continuous mode
+    if( mSignalContinuous )
+    {
+        fill = 0;
     }
 
     mMainUi->BufferProgressBar->setValue( fill );
+
+    QString status;
+
+    if( mSmcPlaylist )
+    {
+        for( const std::string& error : mSmcPlaylist->takeErrors() )
+        {
+            mSmcPlaylistLastError = "skipped: " + QString::fromStdString( error );
+        }
+
+        status = mSmcPlaylist->isFinished() ? "Playlist finished"
+                                            : "Playlist entry " + QString::number( mSmcPlaylist->getCurrentEntry() + 1 )
+                                              + "/" + QString::number( mSmcPlaylist->getEntriesCount() );
+
+        if( mSmcPlaylist->getUnderrunsCount() )
+        {
+            status += ", late entries: " + QString::number( mSmcPlaylist->getUnderrunsCount() );
+        }
+
+        if( mSmcPlaylistLastError.size() )
+        {
+            status += ", " + mSmcPlaylistLastError;
+        }
+    }
+
+    // the render thread did not keep up with the audio device
+    if( mAudioSrc && mAudioSrc->getUnderrunsCount() )
+    {
+        if( status.size() )
+        {
+            status += ", ";
+        }
+
+        status += "audio underruns: " + QString::number( mAudioSrc->getUnderrunsCount() );
+    }
+
+    if( mAudioSrc && mAudioSrc->isSwitchPending() )
+    {
+        if( status.size() )
+        {
+            status += ", ";
+        }
+
+        status += "cued signal waiting for its switch";
+    }
+
+    if( status.size() )
+    {
+        mMainUi->statusbar->showMessage( status );
+    }
+    else
+    {
+        mMainUi->statusbar->clearMessage();
+    }
 }
 
 
@@ -5549,6 +5466,8 @@ void SignalGenerator::updateControls()
         }
 
         mMainUi->BufferLengthSpin->setEnabled( false );
+        mMainUi->actionSignalChannel->setEnabled( false );
+        mMainUi->actionChannelArray->setEnabled( false );
 
         fillValuesSmc();
     }
@@ -5574,9 +5493,10 @@ void SignalGenerator::updateControls()
             mMainUi->SignalItemActionButton->show();
         }
 
-        mMainUi->SignalTypesTab->setEnabled( !mSignalUndefined && !mSignalStarted );
+        // signal items can be changed while generating, the output follows live
+        mMainUi->SignalTypesTab->setEnabled( !mSignalUndefined );
 
-        mMainUi->SignalItemActionButton->setEnabled( !mSignalUndefined && !mSignalStarted );
+        mMainUi->SignalItemActionButton->setEnabled( !mSignalUndefined );
         mMainUi->SignalItemActionButton->setText( mIsSignalEdited ? "Replace current signal item" : "Add to active signal" );
 
         /////////////////////////////
@@ -5587,14 +5507,16 @@ void SignalGenerator::updateControls()
             mMainUi->ActiveSignalGroupBox->show();
         }
 
-        mMainUi->ActiveSignalGroupBox->setEnabled( !mSignalUndefined && !mSignalStarted );
+        mMainUi->ActiveSignalGroupBox->setEnabled( !mSignalUndefined );
 
-        mMainUi->BufferLengthSpin->setEnabled( !mSignalStarted && !mSignalPaused );
+        mMainUi->BufferLengthSpin->setEnabled( !mSignalStarted && !mSignalPaused && !mSignalContinuous );
 
-        bool activeSignalBtnCondition = !mSignalUndefined && mSignalsVector.size() && !mIsSignalEdited;
+        bool activeSignalBtnCondition = !mSignalUndefined && !mSignalList.isEmpty() && !mIsSignalEdited;
         mMainUi->ActiveSignalEditButton->setEnabled( activeSignalBtnCondition );
         mMainUi->ActiveSignalSaveButton->setEnabled( activeSignalBtnCondition );
         mMainUi->ActiveSignalRemoveButton->setEnabled( activeSignalBtnCondition );
+        mMainUi->actionSignalChannel->setEnabled( activeSignalBtnCondition );
+        mMainUi->actionChannelArray->setEnabled( true );
 
         mMainUi->ActiveSignalList->setEnabled( !mIsSignalEdited );
     }
@@ -5602,13 +5524,32 @@ void SignalGenerator::updateControls()
     /////////////////////////////
     // GenerateGroupBox
     /////////////////////////////
-    mMainUi->GenerateGroupBox->setEnabled( mSignalReady && !mIsSignalEdited );
+    mMainUi->GenerateGroupBox->setEnabled( ( mSignalReady && !mIsSignalEdited ) || mSignalStarted );
 
     mMainUi->GeneratePauseButton->setText( mSignalPaused ? "Continue" : "Pause" );
 
     mMainUi->GenerateDeviceComboBox->setEnabled( !mSignalStarted && !mSignalPaused );
 
     mMainUi->GenerateStartButton->setEnabled( mSignalReady && !mSignalStarted && !mSignalPaused );
-    mMainUi->GeneratePauseButton->setEnabled( mSignalReady && mSignalStarted );
-    mMainUi->GenerateStopButton->setEnabled( mSignalReady && mSignalStarted );
+    mMainUi->GeneratePauseButton->setEnabled( mSignalStarted );
+    mMainUi->GenerateStopButton->setEnabled( mSignalStarted );
+
+    /////////////////////////////
+    // File menu
+    /////////////////////////////
+    mMainUi->actionCue->setEnabled( mSignalStarted && !mSignalIsSmc && !mIsSignalEdited );
+    mMainUi->actionContinuous->setEnabled( !mSignalStarted && !mSignalPaused );
+    mMainUi->actionOutputFormat->setEnabled( !mSignalStarted );
+
+    /////////////////////////////
+    // SMC menu
+    /////////////////////////////
+    mSmcPlayedDataGroup->setEnabled( !mSignalStarted );
+    mMainUi->actionSmcSpeedUp->setEnabled( !mSignalStarted );
+    mMainUi->actionSmcHighPass->setEnabled( !mSignalStarted );
+    mMainUi->actionSmcPlaylistGap->setEnabled( !mSignalStarted );
+    mMainUi->actionSmcPlaylistLoop->setEnabled( !mSignalStarted );
+    mMainUi->actionSmcExport->setEnabled( mSignalIsSmc && mSmcVector.size() );
+    mMainUi->actionSmcResponseSpectrum->setEnabled( mSignalIsSmc && mSmcVector.size() );
+    mMainUi->actionSmcFourierSpectrum->setEnabled( mSignalIsSmc && mSmcVector.size() );
 }
@@ -23,6 +23,7 @@ This file contains the definitions for the signal generator.
 #ifndef SignalGenerator_h
 #define SignalGenerator_h
 
+#include <QActionGroup>
 #include <QAudioDevice>
 #include <QAudioOutput>
 #include <QAudioSink>
@@ -34,13 +35,19 @@ This file contains the definitions for the signal generator.
 
 #include <cmath>
 #include <cstdint>
+#include <fstream>
 #include <map>
+#include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
 #include "AudioSource.h"
+#include "SignalFile.h"
 #include "SignalItem.h"
+#include "SignalList.h"
 #include "Smc.h"
+#include "SmcPlaylist.h"
 #include "./ui_About.h"
 
 
@@ -72,6 +79,18 @@ class SignalGenerator : public QMainWindow
         const QString NA_STR = "N/A";                                   //!< not available
 
         static const int TIMER_PER_MS = 1000;                           //!< timer period [ms]
+        static const int CUE_CROSSFADE_MS_MAX = 1000;                   //!< longest crossfade to a cued signal [ms]
+        static constexpr double ARRAY_FREQ_MIN_HZ = 0.001;              //!< lowest frequency of the phases of a channel array [Hz]
+        static const size_t FILE_ERRORS_SHOWN_MAX = 10;                 //!< skipped lines of a signal file which are listed
+
+        typedef enum : uint8_t
+        {
+            CHANNEL_ARRAY_OFF,
+            CHANNEL_ARRAY_DELAYS,
+            CHANNEL_ARRAY_PHASES
+        }ChannelArrayMode;
+
+        const std::vector<int> OUTPUT_SAMPLE_RATES = { 8000, 11025, 16000, 22050, 32000, 44100, 48000, 88200, 96000, 176400, 192000 };  //!< selectable output rates [SPS]
 
     //************************************************************************
     // functions
@@ -86,69 +105,64 @@ class SignalGenerator : public QMainWindow
 
 
     private:
-        bool checkValidInteger
-            (
-            const int16_t aIntValue         //!< integer value
-            ) const;
-
-        bool checkValidReal
+        QString createSignalString
             (
-            const double aRealValue         //!< real value
+            const SignalItem&   aSignal     //!< a signal
             ) const;
 
         QString createSignalStringTriangle
             (
-            const SignalItem::SignalTriangle    aSignal     //!< a Triangle signal
+            const SignalItem::SignalTriangle&   aSignal     //!< a Triangle signal
             ) const;
 
         QString createSignalStringRectangle
             (
-            const SignalItem::SignalRectangle   aSignal     //!< a Rectangle signal
+            const SignalItem::SignalRectangle&  aSignal     //!< a Rectangle signal
             ) const;
 
         QString createSignalStringPulse
             (
-            const SignalItem::SignalPulse       aSignal     //!< a Pulse signal
+            const SignalItem::SignalPulse&      aSignal     //!< a Pulse signal
             ) const;
 
         QString createSignalStringRiseFall
             (
-            const SignalItem::SignalRiseFall    aSignal     //!< a RiseFall signal
+            const SignalItem::SignalRiseFall&   aSignal     //!< a RiseFall signal
             ) const;
 
         QString createSignalStringSinDamp
             (
-            const SignalItem::SignalSinDamp     aSignal     //!< a SinDamp signal
+            const SignalItem::SignalSinDamp&    aSignal     //!< a SinDamp signal
             ) const;
 
         QString createSignalStringSinRise
             (
-            const SignalItem::SignalSinRise     aSignal     //!< a SinRise signal
+            const SignalItem::SignalSinRise&    aSignal     //!< a SinRise signal
             ) const;
 
         QString createSignalStringWavSin
             (
-            const SignalItem::SignalWavSin      aSignal     //!< a WavSin signal
+            const SignalItem::SignalWavSin&     aSignal     //!< a WavSin signal
             ) const;
 
         QString createSignalStringAmSin
             (
-            const SignalItem::SignalAmSin       aSignal     //!< a AmSin signal
+            const SignalItem::SignalAmSin&      aSignal     //!< a AmSin signal
             ) const;
 
         QString createSignalStringSinDampSin
             (
-            const SignalItem::SignalSinDampSin  aSignal     //!< a SinDampSin signal
+            const SignalItem::SignalSinDampSin& aSignal     //!< a SinDampSin signal
             ) const;
 
         QString createSignalStringTrapDampSin
             (
-            const SignalItem::SignalTrapDampSin aSignal     //!< a TrapDampSin signal
+            const SignalItem::SignalTrapDampSin& aSignal    //!< a TrapDampSin signal
             ) const;
 
         QString createSignalStringNoise
             (
-            const SignalItem::SignalNoise       aSignal     //!< a Noise signal
+            const SignalItem::SignalNoise&      aSignal     //!< a Noise signal
             ) const;
 
 
@@ -156,6 +170,8 @@ class SignalGenerator : public QMainWindow
 
         void createTabSignalsMap();
 
+        void deriveSmcVelocityDisplacement();
+
         void fillValuesTriangle();
         void fillValuesRectangle();
         void fillValuesPulse();
@@ -169,18 +185,39 @@ class SignalGenerator : public QMainWindow
         void fillValuesNoise();
         void fillValuesSmc();
 
+        static QString getSampleFormatName
+            (
+            const QAudioFormat::SampleFormat    aSampleFormat   //!< sample format
+            );
+
+        const std::vector<double>& getSmcPlayedData
+            (
+            const Smc&  aSmc                //!< SMC component
+            ) const;
+
         bool initializeAudio
             (
             const QAudioDevice&     aDeviceInfo     //!< audio device
             );
 
-        void setAudioData();
+        QAudioFormat negotiateAudioFormat
+            (
+            const QAudioDevice&     aDeviceInfo     //!< audio device
+            ) const;
 
-        void trim
+        bool readSignalFile
             (
-            std::string&    aString         //!< string to trim
+            const std::string&          aFileName,          //!< signal file name
+            SignalList&                 aSignalList,        //!< read signal items
+            QStringList&                aLineStrings,       //!< list strings of the read items
+            QString&                    aErrors             //!< lines which were skipped, with their errors
             );
 
+        void recreateSmcSignal();
+
+        void setAudioData();
+
+
         void updateControls();
 
     private slots:
@@ -207,6 +244,22 @@ class SignalGenerator : public QMainWindow
         void handleGeneratePauseResume();
         void handleGenerateStop();
 
+        void handleOutputFormat();
+
+        void handleSignalBandLimited
+            (
+            bool    aChecked    //!< true to play band-limited waveforms
+            );
+
+        void handleSignalChannel();
+        void handleSignalChannelArray();
+
+        void handleSignalContinuous
+            (
+            bool    aChecked    //!< true to generate continuously
+            );
+
+        void handleSignalCue();
         void handleSignalNew();
         void handleSignalOpen();
 
@@ -307,8 +360,32 @@ class SignalGenerator : public QMainWindow
 
         void handleSignalTypeChanged();
 
+        void handleSmcExport();
+
+        void handleSmcFourierSpectrum();
+
+        void handleSmcHighPass();
+
         void handleSmcOpen();
 
+        void handleSmcOpenPlaylist();
+
+        void handleSmcPlayedDataChanged
+            (
+            QAction*    aAction     //!< selected action
+            );
+
+        void handleSmcPlaylistGap();
+
+        void handleSmcPlaylistLoop
+            (
+            bool    aChecked    //!< true to loop
+            );
+
+        void handleSmcResponseSpectrum();
+
+        void handleSmcSpeedUp();
+
         void handleVolumeChanged
             (
             int     aValue      //!< index
@@ -333,6 +410,12 @@ class SignalGenerator : public QMainWindow
         bool                            mSignalStarted;         //!< true if a signal is currently generated
         bool                            mSignalPaused;          //!< true if a signal is currently paused
         bool                            mSignalIsSmc;           //!< true if the signal is SMC data
+        bool                            mSignalContinuous;      //!< true to generate forward in time instead of looping the buffer
+        bool                            mSignalBandLimited;     //!< true to play band-limited Triangle, Rectangle and Pulse signals
+        ChannelArrayMode                mChannelArrayMode;      //!< how the channels of an array are offset
+        QString                         mChannelArrayValues;    //!< delays [ms] or phases [deg] of the array channels, comma separated
+        double                          mChannelArrayFreqHz;    //!< frequency the phases of the array channels are given at [Hz]
+        std::vector<double>             mChannelArrayDelayVec;  //!< delay of each channel of the array [s], empty if not an array
 
         int                             mCurrentSignalType;     //!< current signal type
 
@@ -348,17 +431,21 @@ class SignalGenerator : public QMainWindow
         SignalItem::SignalTrapDampSin   mSignalTrapDampSin;     //!< current data for TrapDampSin signal
         SignalItem::SignalNoise         mSignalNoise;           //!< current data for Noise signal
 
-        std::vector<SignalItem*>        mSignalsVector;         //!< signals vector
+        SignalList                      mSignalList;            //!< signals list
 
         QStringListModel                mSignalsListModel;      //!< signals list model
         QStringList                     mSignalsList;           //!< signals list
 
-        SignalItem*                     mEditedSignal;          //!< signal which is edited
+        SignalList::Handle              mEditedSignal;          //!< signal which is edited
         bool                            mIsSignalEdited;        //!< if a signal is edited
 
         QMediaDevices*                  mDevices;               //!< media devices
         QScopedPointer<AudioSource>     mAudioSrc;              //!< audio source
         QScopedPointer<QAudioSink>      mAudioOutput;           //!< audio output
+        QAudioFormat                    mAudioFormat;           //!< audio format of the output
+        int                             mRequiredChannelCount;  //!< minimum number of output channels, 0 if not relevant
+        int                             mOutputSampleRate;      //!< selected output rate [SPS], 0 for the device rate
+        QAudioFormat::SampleFormat      mOutputSampleFormat;    //!< selected sample format, Unknown for the device format
         double                          mAudioBufferLength;     //!< audio buffer length [s]
 
         int                             mAudioBufferProgress;   //!< percentage progress in audio buffer
@@ -366,7 +453,20 @@ class SignalGenerator : public QMainWindow
         uint64_t                        mAudioBufferCounter;    //!< counter for the audio buffer
 
         Smc                             mSmc;                   //!< SMC (Strong-Motion CD) data object
-        std::string                     mSmcInputFilename;      //!< SMC file name
+        std::vector<Smc>                mSmcVector;             //!< SMC components, one per output channel
+        std::string                     mSmcInputFilename;      //!< SMC file name(s)
+        QActionGroup*                   mSmcPlayedDataGroup;    //!< menu actions for the played SMC data
+        Smc::DataTypeFile               mSmcPlayedDataType;     //!< played SMC data: acceleration, velocity or displacement
+        double                          mSmcHighPassCornerHz;   //!< high-pass corner used for velocity and displacement [Hz]
+        double                          mSmcSpeedUp;            //!< audification factor, 1 for real time
+
+        std::vector<SmcPlaylist::Entry> mSmcPlaylistEntries;    //!< playlist entries, empty if single records are played
+        std::shared_ptr<SmcPlaylist>    mSmcPlaylist;           //!< playlist being played
+        double                          mSmcPlaylistGapSeconds; //!< silence between playlist entries [s]
+        bool                            mSmcPlaylistLoop;       //!< true to restart the playlist after its last entry
+        QString                         mSmcPlaylistLastError;  //!< last skipped playlist entry
+
+        AudioSource::SwitchSettings     mCueSettings;           //!< last settings for switching to a cued signal file
 };
 
 #endif // SignalGenerator_h
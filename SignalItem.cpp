@@ -22,8 +22,6 @@ This file contains the sources for a signal item.
 
 #include "SignalItem.h"
 
-#include <cstring>
-
 
 //!************************************************************************
 //! Constructor for Triangle signal type
@@ -32,10 +30,9 @@ SignalItem::SignalItem
     (
     SignalTriangle      aSignalData     //!< Triangle signal data
     )
-    : mType( SIGNAL_TYPE_TRIANGLE )
+    : mSignalData( aSignalData )
+    , mType( SIGNAL_TYPE_TRIANGLE )
 {
-    cleanDataStructures();
-    memcpy( &mSignalDataTriangle, &aSignalData, sizeof( aSignalData ) );
 }
 
 //!************************************************************************
@@ -45,10 +42,9 @@ SignalItem::SignalItem
     (
     SignalRectangle     aSignalData     //!< Rectangle signal data
     )
-    : mType( SIGNAL_TYPE_RECTANGLE )
+    : mSignalData( aSignalData )
+    , mType( SIGNAL_TYPE_RECTANGLE )
 {
-    cleanDataStructures();
-    memcpy( &mSignalDataRectangle, &aSignalData, sizeof( aSignalData ) );
 }
 
 //!************************************************************************
@@ -58,10 +54,9 @@ SignalItem::SignalItem
     (
     SignalPulse         aSignalData     //!< Pulse signal data
     )
-    : mType( SIGNAL_TYPE_PULSE )
+    : mSignalData( aSignalData )
+    , mType( SIGNAL_TYPE_PULSE )
 {
-    cleanDataStructures();
-    memcpy( &mSignalDataPulse, &aSignalData, sizeof( aSignalData ) );
 }
 
 //!************************************************************************
@@ -71,11 +66,10 @@ SignalItem::SignalItem
     (
     SignalRiseFall      aSignalData     //!< RiseFall signal data
     )
-    : mType( SIGNAL_TYPE_RISEFALL )
+    : mSignalData( aSignalData )
+    , mType( SIGNAL_TYPE_RISEFALL )
 {
-    cleanDataStructures();
-    memcpy( &mSignalDataRiseFall, &aSignalData, sizeof( aSignalData ) );
- }
+}
 
 //!************************************************************************
 //! Constructor for SinDamp signal type
@@ -84,10 +78,9 @@ SignalItem::SignalItem
     (
     SignalSinDamp       aSignalData     //!< SinDamp signal data
     )
-    : mType( SIGNAL_TYPE_SINDAMP )
+    : mSignalData( aSignalData )
+    , mType( SIGNAL_TYPE_SINDAMP )
 {
-    cleanDataStructures();
-    memcpy( &mSignalDataSinDamp, &aSignalData, sizeof( aSignalData ) );
 }
 
 //!************************************************************************
@@ -97,10 +90,9 @@ SignalItem::SignalItem
     (
     SignalSinRise       aSignalData     //!< SinRise signal data
     )
-    : mType( SIGNAL_TYPE_SINRISE )
+    : mSignalData( aSignalData )
+    , mType( SIGNAL_TYPE_SINRISE )
 {
-    cleanDataStructures();
-    memcpy( &mSignalDataSinRise, &aSignalData, sizeof( aSignalData ) );
 }
 
 //!************************************************************************
@@ -110,10 +102,9 @@ SignalItem::SignalItem
     (
     SignalWavSin        aSignalData     //!< WavSin signal data
     )
-    : mType( SIGNAL_TYPE_WAVSIN )
+    : mSignalData( aSignalData )
+    , mType( SIGNAL_TYPE_WAVSIN )
 {
-    cleanDataStructures();
-    memcpy( &mSignalDataWavSin, &aSignalData, sizeof( aSignalData ) );
 }
 
 //!************************************************************************
@@ -123,10 +114,9 @@ SignalItem::SignalItem
     (
     SignalAmSin         aSignalData     //!< AmSin signal data
     )
-    : mType( SIGNAL_TYPE_AMSIN )
+    : mSignalData( aSignalData )
+    , mType( SIGNAL_TYPE_AMSIN )
 {
-    cleanDataStructures();
-    memcpy( &mSignalDataAmSin, &aSignalData, sizeof( aSignalData ) );
 }
 
 //!************************************************************************
@@ -136,10 +126,9 @@ SignalItem::SignalItem
     (
     SignalSinDampSin    aSignalData     //!< SinDampSin signal data
     )
-    : mType( SIGNAL_TYPE_SINDAMPSIN )
+    : mSignalData( aSignalData )
+    , mType( SIGNAL_TYPE_SINDAMPSIN )
 {
-    cleanDataStructures();
-    memcpy( &mSignalDataSinDampSin, &aSignalData, sizeof( aSignalData ) );
 }
 
 //!************************************************************************
@@ -149,10 +138,9 @@ SignalItem::SignalItem
     (
     SignalTrapDampSin   aSignalData     //!< TrapDampSin signal data
     )
-    : mType( SIGNAL_TYPE_TRAPDAMPSIN )
+    : mSignalData( aSignalData )
+    , mType( SIGNAL_TYPE_TRAPDAMPSIN )
 {
-    cleanDataStructures();
-    memcpy( &mSignalDataTrapDampSin, &aSignalData, sizeof( aSignalData ) );
 }
 
 //!************************************************************************
@@ -162,10 +150,9 @@ SignalItem::SignalItem
     (
     SignalNoise         aSignalData     //!< Noise signal data
     )
-    : mType( SIGNAL_TYPE_NOISE )
+    : mSignalData( aSignalData )
+    , mType( SIGNAL_TYPE_NOISE )
 {
-    cleanDataStructures();
-    memcpy( &mSignalDataNoise, &aSignalData, sizeof( aSignalData ) );
 }
 
 //!************************************************************************
@@ -173,155 +160,147 @@ SignalItem::SignalItem
 //!************************************************************************
 SignalItem::SignalItem
     (
-    SignalSmc           aSignalData     //!< SMC signal data
+    SignalSmc&&         aSignalData     //!< SMC signal data, moved in
     )
-    : mType( SIGNAL_TYPE_SMC )
-{
-    cleanDataStructures();
-    memcpy( &mSignalDataSmc, &aSignalData, sizeof( aSignalData ) );
-}
-
-
-//!************************************************************************
-//! Clean all data structures
-//!
-//! @returns: nothing
-//!************************************************************************
-void SignalItem::cleanDataStructures()
+    : mSignalData( std::make_shared<const SignalSmc>( std::move( aSignalData ) ) )
+    , mType( SIGNAL_TYPE_SMC )
 {
-    memset( &mSignalDataTriangle,       0, sizeof( mSignalDataTriangle ) );
-    memset( &mSignalDataRectangle,      0, sizeof( mSignalDataRectangle ) );
-    memset( &mSignalDataPulse,          0, sizeof( mSignalDataPulse ) );
-    memset( &mSignalDataRiseFall,       0, sizeof( mSignalDataRiseFall ) );
-    memset( &mSignalDataSinDamp,        0, sizeof( mSignalDataSinDamp ) );
-    memset( &mSignalDataSinRise,        0, sizeof( mSignalDataSinRise ) );
-    memset( &mSignalDataWavSin,         0, sizeof( mSignalDataWavSin ) );
-    memset( &mSignalDataAmSin,          0, sizeof( mSignalDataAmSin ) );
-    memset( &mSignalDataSinDampSin,     0, sizeof( mSignalDataSinDampSin ) );
-    memset( &mSignalDataTrapDampSin,    0, sizeof( mSignalDataTrapDampSin ) );
-    memset( &mSignalDataNoise,          0, sizeof( mSignalDataNoise ) );
-    memset( &mSignalDataSmc,            0, sizeof( mSignalDataSmc ) );
 }
 
 
 //!************************************************************************
 //! Get Triangle signal data
 //!
-//! @returns: SignalTriangle data structure
+//! @returns: SignalTriangle data structure, held by the item
 //!************************************************************************
-SignalItem::SignalTriangle SignalItem::getSignalDataTriangle() const
+const SignalItem::SignalTriangle& SignalItem::getSignalDataTriangle() const
 {
-    return mSignalDataTriangle;
+    return getSignalData<SignalTriangle>();
 }
 
 //!************************************************************************
 //! Get Rectangle signal data
 //!
-//! @returns: SignalRectangle data structure
+//! @returns: SignalRectangle data structure, held by the item
 //!************************************************************************
-SignalItem::SignalRectangle SignalItem::getSignalDataRectangle() const
+const SignalItem::SignalRectangle& SignalItem::getSignalDataRectangle() const
 {
-    return mSignalDataRectangle;
+    return getSignalData<SignalRectangle>();
 }
 
 //!************************************************************************
 //! Get Pulse signal data
 //!
-//! @returns: SignalPulse data structure
+//! @returns: SignalPulse data structure, held by the item
 //!************************************************************************
-SignalItem::SignalPulse SignalItem::getSignalDataPulse() const
+const SignalItem::SignalPulse& SignalItem::getSignalDataPulse() const
 {
-    return mSignalDataPulse;
+    return getSignalData<SignalPulse>();
 }
 
 //!************************************************************************
 //! Get RiseFall signal data
 //!
-//! @returns: SignalRiseFall data structure
+//! @returns: SignalRiseFall data structure, held by the item
 //!************************************************************************
-SignalItem::SignalRiseFall SignalItem::getSignalDataRiseFall() const
+const SignalItem::SignalRiseFall& SignalItem::getSignalDataRiseFall() const
 {
-    return mSignalDataRiseFall;
+    return getSignalData<SignalRiseFall>();
 }
 
 //!************************************************************************
 //! Get SinDamp signal data
 //!
-//! @returns: SignalSinDamp data structure
+//! @returns: SignalSinDamp data structure, held by the item
 //!************************************************************************
-SignalItem::SignalSinDamp SignalItem::getSignalDataSinDamp() const
+const SignalItem::SignalSinDamp& SignalItem::getSignalDataSinDamp() const
 {
-    return mSignalDataSinDamp;
+    return getSignalData<SignalSinDamp>();
 }
 
 //!************************************************************************
 //! Get SinRise signal data
 //!
-//! @returns: SignalSinRise data structure
+//! @returns: SignalSinRise data structure, held by the item
 //!************************************************************************
-SignalItem::SignalSinRise SignalItem::getSignalDataSinRise() const
+const SignalItem::SignalSinRise& SignalItem::getSignalDataSinRise() const
 {
-    return mSignalDataSinRise;
+    return getSignalData<SignalSinRise>();
 }
 
 //!************************************************************************
 //! Get WavSin signal data
 //!
-//! @returns: SignalWavSin data structure
+//! @returns: SignalWavSin data structure, held by the item
 //!************************************************************************
-SignalItem::SignalWavSin SignalItem::getSignalDataWavSin() const
+const SignalItem::SignalWavSin& SignalItem::getSignalDataWavSin() const
 {
-    return mSignalDataWavSin;
+    return getSignalData<SignalWavSin>();
 }
 
 //!************************************************************************
 //! Get AmSin signal data
 //!
-//! @returns: SignalAmSin data structure
+//! @returns: SignalAmSin data structure, held by the item
 //!************************************************************************
-SignalItem::SignalAmSin SignalItem::getSignalDataAmSin() const
+const SignalItem::SignalAmSin& SignalItem::getSignalDataAmSin() const
 {
-    return mSignalDataAmSin;
+    return getSignalData<SignalAmSin>();
 }
 
 //!************************************************************************
 //! Get SinDampSin signal data
 //!
-//! @returns: SignalSinDampSin data structure
+//! @returns: SignalSinDampSin data structure, held by the item
 //!************************************************************************
-SignalItem::SignalSinDampSin SignalItem::getSignalDataSinDampSin() const
+const SignalItem::SignalSinDampSin& SignalItem::getSignalDataSinDampSin() const
 {
-    return mSignalDataSinDampSin;
+    return getSignalData<SignalSinDampSin>();
 }
 
 //!************************************************************************
 //! Get TrapDampSin signal data
 //!
-//! @returns: SignalTrapDampSin data structure
+//! @returns: SignalTrapDampSin data structure, held by the item
 //!************************************************************************
-SignalItem::SignalTrapDampSin SignalItem::getSignalDataTrapDampSin() const
+const SignalItem::SignalTrapDampSin& SignalItem::getSignalDataTrapDampSin() const
 {
-    return mSignalDataTrapDampSin;
+    return getSignalData<SignalTrapDampSin>();
 }
 
 //!************************************************************************
 //! Get Noise signal data
 //!
-//! @returns: SignalNoise data structure
+//! @returns: SignalNoise data structure, held by the item
 //!************************************************************************
-SignalItem::SignalNoise SignalItem::getSignalDataNoise() const
+const SignalItem::SignalNoise& SignalItem::getSignalDataNoise() const
 {
-    return mSignalDataNoise;
+    return getSignalData<SignalNoise>();
 }
 
 //!************************************************************************
 //! Get SMC signal data
 //!
-//! @returns: SignalNoise data structure
+//! @returns: SignalSmc data structure, held by the item
+//!************************************************************************
+const SignalItem::SignalSmc& SignalItem::getSignalDataSmc() const
+{
+    static const SignalSmc DEFAULT_DATA;
+    const std::shared_ptr<const SignalSmc>* data = std::get_if<std::shared_ptr<const SignalSmc>>( &mSignalData );
+
+    return data ? **data : DEFAULT_DATA;
+}
+
+
+//!************************************************************************
+//! Get the output channel
+//! An SMC trace keeps the channel it was loaded for.
+//!
+//! @returns: the output channel, -1 for all channels
 //!************************************************************************
-SignalItem::SignalSmc SignalItem::getSignalDataSmc() const
+int8_t SignalItem::getChannel() const
 {
-    return mSignalDataSmc;
+    return ( SIGNAL_TYPE_SMC == mType ) ? getSignalDataSmc().channel : mChannel;
 }
 
 
@@ -334,3 +313,17 @@ SignalItem::SignalType SignalItem::getType() const
 {
     return mType;
 }
+
+
+//!************************************************************************
+//! Set the output channel
+//!
+//! @returns: nothing
+//!************************************************************************
+void SignalItem::setChannel
+    (
+    const int8_t        aChannel        //!< output channel, -1 for all channels
+    )
+{
+    mChannel = aChannel;
+}
@@ -24,6 +24,8 @@ This file contains the definitions for a signal item.
 #define SignalItem_h
 
 #include <cstdint>
+#include <memory>
+#include <variant>
 #include <vector>
 
 
@@ -365,11 +367,17 @@ class SignalItem
             SignalType type;
 
             static constexpr double MAX_SCALE_ACCEL_MS2 = 11.768; // equivalent to 1.2g
+            static constexpr double SPEED_UP_MAX = 1000;
 
             double              maxAccelMs2;    // m/s2
-            uint16_t            nrPoints;
+            uint32_t            nrPoints;
             double              sps;
-            std::vector<double> accelDataVec;   // m/s2
+            std::vector<double> dataVec;        // m/s2, m/s or m
+            double              fullScale;      // data value played at full scale
+
+            int8_t              channel;        // output channel, -1 for all channels
+            double              tStart;         // s, offset of the first sample
+            double              speedUp;        // audification factor, 1 for real time
 
             SignalSmc()
             {
@@ -378,6 +386,11 @@ class SignalItem
                 maxAccelMs2 = 0;
                 nrPoints = 0;
                 sps = 0;
+                fullScale = MAX_SCALE_ACCEL_MS2;
+
+                channel = -1;
+                tStart = 0;
+                speedUp = 1;
             }
         };
 
@@ -443,47 +456,69 @@ class SignalItem
 
         SignalItem
             (
-            SignalSmc           aSignalData     //!< SMC signal data
+            SignalSmc&&         aSignalData     //!< SMC signal data, moved in
             );
 
 
-        SignalTriangle      getSignalDataTriangle() const;
-        SignalRectangle     getSignalDataRectangle() const;
-        SignalPulse         getSignalDataPulse() const;
-        SignalRiseFall      getSignalDataRiseFall() const;
-        SignalSinDamp       getSignalDataSinDamp() const;
-        SignalSinRise       getSignalDataSinRise() const;
-        SignalWavSin        getSignalDataWavSin() const;
-        SignalAmSin         getSignalDataAmSin() const;
-        SignalSinDampSin    getSignalDataSinDampSin() const;
-        SignalTrapDampSin   getSignalDataTrapDampSin() const;
-        SignalNoise         getSignalDataNoise() const;
-        SignalSmc           getSignalDataSmc() const;
+        const SignalTriangle&       getSignalDataTriangle() const;
+        const SignalRectangle&      getSignalDataRectangle() const;
+        const SignalPulse&          getSignalDataPulse() const;
+        const SignalRiseFall&       getSignalDataRiseFall() const;
+        const SignalSinDamp&        getSignalDataSinDamp() const;
+        const SignalSinRise&        getSignalDataSinRise() const;
+        const SignalWavSin&         getSignalDataWavSin() const;
+        const SignalAmSin&          getSignalDataAmSin() const;
+        const SignalSinDampSin&     getSignalDataSinDampSin() const;
+        const SignalTrapDampSin&    getSignalDataTrapDampSin() const;
+        const SignalNoise&          getSignalDataNoise() const;
+        const SignalSmc&            getSignalDataSmc() const;
 
-        SignalType          getType() const;
+        SignalType                  getType() const;
 
-    private:
-        void cleanDataStructures();
+        int8_t                      getChannel() const;
+
+        void setChannel
+            (
+            const int8_t        aChannel        //!< output channel, -1 for all channels
+            );
+
+        //!************************************************************************
+        //! Get the data of signal type T
+        //! Asking for another type than the one held gives its default data.
+        //!
+        //! @returns: the signal data
+        //!************************************************************************
+        template<typename T>
+        const T& getSignalData() const
+        {
+            static const T DEFAULT_DATA;
+            const T* data = std::get_if<T>( &mSignalData );
+
+            return data ? *data : DEFAULT_DATA;
+        }
 
 
     //************************************************************************
     // variables
     //************************************************************************
     private:
-        SignalTriangle          mSignalDataTriangle;            //!< data for Triangle signal type
-        SignalRectangle         mSignalDataRectangle;           //!< data for Rectangle signal type
-        SignalPulse             mSignalDataPulse;               //!< data for Pulse signal type
-        SignalRiseFall          mSignalDataRiseFall;            //!< data for RiseFall signal type
-        SignalSinDamp           mSignalDataSinDamp;             //!< data for SinDamp signal type
-        SignalSinRise           mSignalDataSinRise;             //!< data for SinRise signal type
-        SignalWavSin            mSignalDataWavSin;              //!< data for WavSin signal type
-        SignalAmSin             mSignalDataAmSin;               //!< data for AmSin signal type
-        SignalSinDampSin        mSignalDataSinDampSin;          //!< data for SinDampSin signal type
-        SignalTrapDampSin       mSignalDataTrapDampSin;         //!< data for TrapDampSin signal type
-        SignalNoise             mSignalDataNoise;               //!< data for Noise signal type       
-        SignalSmc               mSignalDataSmc;                 //!< data for SMC signal type
+        // only the data of the signal type is held; the SMC trace is shared
+        // by the copies of the item, since it is never changed once moved in
+        std::variant<SignalTriangle,
+                     SignalRectangle,
+                     SignalPulse,
+                     SignalRiseFall,
+                     SignalSinDamp,
+                     SignalSinRise,
+                     SignalWavSin,
+                     SignalAmSin,
+                     SignalSinDampSin,
+                     SignalTrapDampSin,
+                     SignalNoise,
+                     std::shared_ptr<const SignalSmc>>  mSignalData;    //!< data for the signal type
 
         SignalType              mType = SIGNAL_TYPE_INVALID;    //!< default signal type format
+        int8_t                  mChannel = -1;                  //!< output channel, -1 for all channels
 };
 
 #endif // SignalItem_h
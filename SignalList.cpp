@@ -0,0 +1,280 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2025 Mihai Ursu                                                 //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+/*
+SignalList.cpp
+This file contains the sources for a list of signal items.
+*/
+
+#include "SignalList.h"
+
+#include <algorithm>
+
+
+//!************************************************************************
+//! Append an item to the list
+//! A slot freed by a removed item is reused first, so that the arena only
+//! grows with the largest number of items held at once.
+//!
+//! @returns: the handle of the item
+//!************************************************************************
+SignalList::Handle SignalList::append
+    (
+    SignalItem&&    aItem           //!< added item
+    )
+{
+    Handle handle;
+
+    if( mFreeSlotVec.size() )
+    {
+        handle.slot = mFreeSlotVec.back();
+        mFreeSlotVec.pop_back();
+    }
+    else
+    {
+        handle.slot = static_cast<uint32_t>( mSlotVec.size() );
+        mSlotVec.emplace_back();
+    }
+
+    Slot& slot = mSlotVec.at( handle.slot );
+    slot.item.emplace( std::move( aItem ) );
+    handle.generation = slot.generation;
+
+    mOrderVec.push_back( handle );
+    mSnapshot.reset();
+
+    return handle;
+}
+
+
+//!************************************************************************
+//! Get the item at a position of the list
+//!
+//! @returns: the item
+//!************************************************************************
+const SignalItem& SignalList::at
+    (
+    const size_t    aPosition       //!< position in the list
+    ) const
+{
+    return *mSlotVec.at( mOrderVec.at( aPosition ).slot ).item;
+}
+
+
+//!************************************************************************
+//! Remove all items
+//! The slots are kept for the next items; the snapshots already taken
+//! keep their own items.
+//!
+//! @returns: nothing
+//!************************************************************************
+void SignalList::clear()
+{
+    for( const Handle& handle : mOrderVec )
+    {
+        freeSlot( handle.slot );
+    }
+
+    mOrderVec.clear();
+    mSnapshot.reset();
+}
+
+
+//!************************************************************************
+//! Free the slot of an item
+//! The slot gets a new generation, so that the handles to its item go
+//! stale.
+//!
+//! @returns: nothing
+//!************************************************************************
+void SignalList::freeSlot
+    (
+    const uint32_t  aSlot           //!< slot of the item
+    )
+{
+    Slot& slot = mSlotVec.at( aSlot );
+    slot.item.reset();
+    slot.generation++;
+    mFreeSlotVec.push_back( aSlot );
+}
+
+
+//!************************************************************************
+//! Get an item by its handle
+//!
+//! @returns: the item, nullptr if the handle is stale
+//!************************************************************************
+const SignalItem* SignalList::get
+    (
+    const Handle    aHandle         //!< item handle
+    ) const
+{
+    return isValid( aHandle ) ? &*mSlotVec.at( aHandle.slot ).item : nullptr;
+}
+
+
+//!************************************************************************
+//! Get the handle of the item at a position of the list
+//!
+//! @returns: the handle, which is invalid for a position out of the list
+//!************************************************************************
+SignalList::Handle SignalList::getHandle
+    (
+    const size_t    aPosition       //!< position in the list
+    ) const
+{
+    return ( aPosition < mOrderVec.size() ) ? mOrderVec.at( aPosition ) : Handle();
+}
+
+
+//!************************************************************************
+//! Get the number of items
+//!
+//! @returns: the number of items
+//!************************************************************************
+size_t SignalList::getSize() const
+{
+    return mOrderVec.size();
+}
+
+
+//!************************************************************************
+//! Get a snapshot of the items
+//! The snapshot is made once after each change and then shared; it does
+//! not change with the list, so a render thread can read it without any
+//! lock for as long as it holds it.
+//!
+//! @returns: the snapshot
+//!************************************************************************
+SignalList::Snapshot SignalList::getSnapshot() const
+{
+    if( !mSnapshot )
+    {
+        std::shared_ptr<std::vector<SignalItem>> items = std::make_shared<std::vector<SignalItem>>();
+        items->reserve( mOrderVec.size() );
+
+        for( size_t i = 0; i < mOrderVec.size(); i++ )
+        {
+            items->push_back( at( i ) );
+        }
+
+        mSnapshot = items;
+    }
+
+    return mSnapshot;
+}
+
+
+//!************************************************************************
+//! Check if the list is empty
+//!
+//! @returns: true if the list holds no items
+//!************************************************************************
+bool SignalList::isEmpty() const
+{
+    return mOrderVec.empty();
+}
+
+
+//!************************************************************************
+//! Check if a handle refers to an item of the list
+//!
+//! @returns: true if the item was not removed
+//!************************************************************************
+bool SignalList::isValid
+    (
+    const Handle    aHandle         //!< item handle
+    ) const
+{
+    return aHandle.slot < mSlotVec.size()
+        && mSlotVec.at( aHandle.slot ).generation == aHandle.generation
+        && mSlotVec.at( aHandle.slot ).item.has_value();
+}
+
+
+//!************************************************************************
+//! Remove an item
+//! Its slot is freed for the next added item.
+//!
+//! @returns: true if the item was removed
+//!************************************************************************
+bool SignalList::remove
+    (
+    const Handle    aHandle         //!< item handle
+    )
+{
+    const bool valid = isValid( aHandle );
+
+    if( valid )
+    {
+        freeSlot( aHandle.slot );
+
+        std::vector<Handle>::iterator it = std::find_if( mOrderVec.begin(), mOrderVec.end(),
+                                                         [&aHandle]( const Handle& aOther )
+                                                         {
+                                                             return aOther.slot == aHandle.slot;
+                                                         } );
+
+        if( it != mOrderVec.end() )
+        {
+            mOrderVec.erase( it );
+        }
+
+        mSnapshot.reset();
+    }
+
+    return valid;
+}
+
+
+//!************************************************************************
+//! Replace an item, keeping its position and handle
+//!
+//! @returns: true if the item was replaced
+//!************************************************************************
+bool SignalList::replace
+    (
+    const Handle    aHandle,        //!< item handle
+    SignalItem&&    aItem           //!< new item
+    )
+{
+    const bool valid = isValid( aHandle );
+
+    if( valid )
+    {
+        mSlotVec.at( aHandle.slot ).item.emplace( std::move( aItem ) );
+        mSnapshot.reset();
+    }
+
+    return valid;
+}
+
+
+//!************************************************************************
+//! Reserve room for a number of items, so that appending them does not
+//! reallocate the arena
+//!
+//! @returns: nothing
+//!************************************************************************
+void SignalList::reserve
+    (
+    const size_t    aCount          //!< number of items
+    )
+{
+    mSlotVec.reserve( aCount );
+    mOrderVec.reserve( aCount );
+}
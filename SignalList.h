@@ -0,0 +1,148 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2025 Mihai Ursu                                                 //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+/*
+SignalList.h
+This file contains the definitions for a list of signal items.
+*/
+
+#ifndef SignalList_h
+#define SignalList_h
+
+#include "SignalItem.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+
+//************************************************************************
+// Class for an ordered list of signal items, which owns them in an arena
+// of reusable slots and shares immutable snapshots of them
+//************************************************************************
+class SignalList
+{
+    //************************************************************************
+    // constants and types
+    //************************************************************************
+    public:
+        static constexpr uint32_t INVALID_SLOT = UINT32_MAX;   //!< slot of a handle to no item
+
+        // reference to an item, which goes stale once the item is removed
+        struct Handle
+        {
+            uint32_t    slot;           //!< slot of the item in the arena
+            uint32_t    generation;     //!< generation of the slot when the item was added
+
+            Handle()
+            {
+                slot = INVALID_SLOT;
+                generation = 0;
+            }
+        };
+
+        // items in the list order, never changed once made
+        typedef std::shared_ptr<const std::vector<SignalItem>> Snapshot;
+
+    private:
+        // slot of the arena; a free slot holds no item
+        struct Slot
+        {
+            std::optional<SignalItem>   item;           //!< item, if the slot is used
+            uint32_t                    generation;     //!< incremented each time the slot is freed
+
+            Slot()
+            {
+                generation = 0;
+            }
+        };
+
+
+    //************************************************************************
+    // functions
+    //************************************************************************
+    public:
+        Handle append
+            (
+            SignalItem&&    aItem           //!< added item
+            );
+
+        const SignalItem& at
+            (
+            const size_t    aPosition       //!< position in the list
+            ) const;
+
+        void clear();
+
+        const SignalItem* get
+            (
+            const Handle    aHandle         //!< item handle
+            ) const;
+
+        Handle getHandle
+            (
+            const size_t    aPosition       //!< position in the list
+            ) const;
+
+        size_t getSize() const;
+
+        Snapshot getSnapshot() const;
+
+        bool isEmpty() const;
+
+        bool isValid
+            (
+            const Handle    aHandle         //!< item handle
+            ) const;
+
+        bool remove
+            (
+            const Handle    aHandle         //!< item handle
+            );
+
+        bool replace
+            (
+            const Handle    aHandle,        //!< item handle
+            SignalItem&&    aItem           //!< new item
+            );
+
+        void reserve
+            (
+            const size_t    aCount          //!< number of items
+            );
+
+    private:
+        void freeSlot
+            (
+            const uint32_t  aSlot           //!< slot of the item
+            );
+
+
+    //************************************************************************
+    // variables
+    //************************************************************************
+    private:
+        std::vector<Slot>       mSlotVec;       //!< arena of item slots
+        std::vector<uint32_t>   mFreeSlotVec;   //!< slots which can be reused
+        std::vector<Handle>     mOrderVec;      //!< handles in the list order
+
+        mutable Snapshot        mSnapshot;      //!< snapshot of the current items, made on demand
+};
+
+#endif // SignalList_h
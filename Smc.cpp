@@ -22,7 +22,9 @@ This file contains the sources for processing SMC (Strong Motion CD) files.
 
 #include "Smc.h"
 
+#include <cmath>
 #include <cstring>
+#include <stdexcept>
 
 
 const std::map<Smc::DataTypeFile, std::string> Smc::DATA_TYPE_FILE_STRINGS =
@@ -112,6 +114,7 @@ const std::map<uint8_t, std::string> Smc::BRIDGE_LOCATION_NAMES =
 Smc::Smc()
     : mSmcFormatOk( true )
     , mSmcTypeAccelerogram( true )
+    , mDataCalibrated( true )
     // text header
     , mTextDataTypeFile( DATA_TYPE_FILE_UNKNOWN )
     // integer header
@@ -165,6 +168,7 @@ Smc::Smc()
     /////////////////////////////////
     // integer header
     /////////////////////////////////
+    memset( &mRecordStart, 0, sizeof( mRecordStart ) );
     mSensorTypeStr.clear();
     mStructureTypeName.clear();
     memset( &mStructureBuilding, 0, sizeof( mStructureBuilding ) );
@@ -184,4 +188,705 @@ Smc::Smc()
     // data
     /////////////////////////////////
     mDataVector.clear();
+    mVelocityVector.clear();
+    mDisplacementVector.clear();
+}
+
+
+//!************************************************************************
+//! Check if the data starts with a SMC text header
+//!
+//! @returns: true if the first line is a known SMC data type
+//!************************************************************************
+bool Smc::canRead
+    (
+    const char*     aData,          //!< file content
+    const size_t    aLength         //!< file length
+    ) const
+{
+    const char* pos = aData;
+    std::string firstLine;
+    bool found = false;
+
+    if( getLine( pos, aData + aLength, firstLine ) )
+    {
+        trim( firstLine );
+
+        for( const auto& dataType : DATA_TYPE_FILE_STRINGS )
+        {
+            if( dataType.second == firstLine )
+            {
+                found = true;
+                break;
+            }
+        }
+    }
+
+    return found;
+}
+
+
+//!************************************************************************
+//! Get the name of the file format
+//!
+//! @returns: format name
+//!************************************************************************
+std::string Smc::getFormatName() const
+{
+    return "SMC";
+}
+
+
+//!************************************************************************
+//! Get the time of the first sample, counted from the beginning of the
+//! Gregorian calendar
+//! Only differences between components are meaningful.
+//!
+//! @returns: record start time [s]
+//!************************************************************************
+double Smc::getRecordStartSeconds() const
+{
+    double startSeconds = 0;
+
+    if( hasRecordStartTime() )
+    {
+        const int64_t y = mRecordStart.year - 1;
+        const int64_t daysBeforeYear = 365 * y + y / 4 - y / 100 + y / 400;
+
+        startSeconds = 86400.0 * ( daysBeforeYear + mRecordStart.julianDay - 1 );
+        startSeconds += 3600.0 * mRecordStart.hour;
+        startSeconds += 60.0 * mRecordStart.minute;
+        startSeconds += mRecordStart.second;
+        startSeconds += 1.e-3 * mRecordStart.millisecond;
+    }
+
+    return startSeconds;
+}
+
+
+//!************************************************************************
+//! Check if the integer header provides the time of the first sample
+//!
+//! @returns: true if all time fields are defined
+//!************************************************************************
+bool Smc::hasRecordStartTime() const
+{
+    return ( mNoValueInteger != mRecordStart.year
+          && mNoValueInteger != mRecordStart.julianDay
+          && mNoValueInteger != mRecordStart.hour
+          && mNoValueInteger != mRecordStart.minute
+          && mNoValueInteger != mRecordStart.second
+          && mNoValueInteger != mRecordStart.millisecond
+           );
+}
+
+
+//!************************************************************************
+//! Check if an integer value is valid
+//!
+//! @returns: true if valid
+//!************************************************************************
+bool Smc::isValidInteger
+    (
+    const int32_t   aIntValue       //!< integer value
+    ) const
+{
+    return ( aIntValue != mNoValueInteger );
+}
+
+
+//!************************************************************************
+//! Check if a real value is valid
+//!
+//! @returns: true if valid
+//!************************************************************************
+bool Smc::isValidReal
+    (
+    const double    aRealValue      //!< real value
+    ) const
+{
+    return ( std::fabs( aRealValue - mNoValueReal ) > 1.e-7 );
+}
+
+
+//!************************************************************************
+//! Parse the content of a SMC (Strong Motion CD) data file
+//! Only accelerograms are accepted.
+//!
+//! @returns: true if a record was appended
+//!************************************************************************
+bool Smc::read
+    (
+    const char*         aData,          //!< file content
+    const size_t        aLength,        //!< file length
+    std::vector<Smc>&   aRecordVec,     //!< records are appended
+    std::string&        aError          //!< error message
+    ) const
+{
+    const char* pos = aData;
+    const char* end = aData + aLength;
+
+    aError.clear();
+
+    Smc record;
+
+    std::vector<std::string> substringsVec;
+
+    const std::string STAR = "*";
+
+    std::string currentLine;
+    int crtLineNr = 0;
+
+    while( record.mSmcFormatOk && getLine( pos, end, currentLine ) )
+    {
+        crtLineNr++;
+
+        if( crtLineNr <= Smc::LAST_TEXT_LINE_NR )
+        {
+            ///////////////////////
+            // text header
+            ///////////////////////
+
+            switch( crtLineNr )
+            {
+                case 1:
+                    {
+                        bool typefound = false;
+                        size_t i = 0;
+                        trim( currentLine );
+
+                        for( i = 0; i < Smc::DATA_TYPE_FILE_STRINGS.size(); i++ )
+                        {
+                            if( Smc::DATA_TYPE_FILE_STRINGS.at( static_cast<Smc::DataTypeFile>( i ) ) == currentLine )
+                            {
+                                typefound = true;
+                                break;
+                            }
+                        }
+
+                        if( !typefound )
+                        {
+                            record.mSmcFormatOk = false;
+                            record.mSmcTypeAccelerogram = false;
+
+                            aError = "Current file has no SMC header.";
+
+                            break;
+                        }
+                        else
+                        {
+                            record.mTextDataTypeFile = static_cast<Smc::DataTypeFile>( i );
+
+                            if( Smc::DATA_TYPE_FILE_UNCORRECTED_ACCELEROGRAM != record.mTextDataTypeFile
+                             && Smc::DATA_TYPE_FILE_CORRECTED_ACCELEROGRAM != record.mTextDataTypeFile )
+                            {
+                                record.mSmcTypeAccelerogram = false;
+                            }
+
+                            if( !record.mSmcTypeAccelerogram )
+                            {
+                                record.mSmcFormatOk = false;
+                                aError = "Current file is not an accelerogram in SMC format.";
+
+                                break;
+                            }
+                        }
+                    }
+                    break;
+
+                case 3:
+                    trim( currentLine );
+
+                    if( STAR != currentLine )
+                    {
+                        record.mTextStationCodeStr = currentLine;
+                    }
+                    break;
+
+                case 4:
+                    {
+                        std::string tmpStr = currentLine.substr( 0, 3 );
+
+                        for( char c : tmpStr )
+                        {
+                            if( ' ' != c )
+                            {
+                                record.mTextTimeZone = tmpStr;
+                                break;
+                            }
+                        }
+
+                        record.mTextEarthquakeYear = currentLine.substr( 5, 4 );
+                        record.mTextEarthquakeMonth = currentLine.substr( 11, 2 );
+                        record.mTextEarthquakeDay = currentLine.substr( 15, 2 );
+                        record.mTextEarthquakeHour = currentLine.substr( 21, 2 );
+                        record.mTextEarthquakeMinute = currentLine.substr( 23, 2 );
+
+                        record.mEarthquakeTimeStamp = record.mTextEarthquakeYear + "." + record.mTextEarthquakeMonth + "." + record.mTextEarthquakeDay;
+                        record.mEarthquakeTimeStamp += " " + record.mTextEarthquakeHour + ":" + record.mTextEarthquakeMinute;
+
+                        tmpStr = currentLine.substr( 26, 53 );
+                        trim( tmpStr );
+                        record.mTextEarthquakeName = tmpStr;
+                    }
+                    break;
+
+                case 5:
+                    record.mSmcFormatOk = ( "Moment Mag=" == currentLine.substr( 0, 11 )
+                                       && "Ms=" == currentLine.substr( 21, 3 )
+                                       && "Ml=" == currentLine.substr( 34, 3 ) );
+
+                    if( record.mSmcFormatOk )
+                    {
+                        std::string tmpStr = currentLine.substr( 11, 9 );
+                        trim( tmpStr );
+                        record.mTextMomentMagnitude = tmpStr;
+
+                        tmpStr = currentLine.substr( 24, 9 );
+                        trim( tmpStr );
+                        record.mTextSurfaceWaveMagnitude = tmpStr;
+
+                        tmpStr = currentLine.substr( 37, 9 );
+                        trim( tmpStr );
+                        record.mTextLocalMagnitude = tmpStr;
+                    }
+                    break;
+
+                case 6:
+                    record.mSmcFormatOk = ( ( "station = " == currentLine.substr( 0, 10 ) || "Station = " == currentLine.substr( 0, 10 ) )
+                                       && "component=" == currentLine.substr( 41, 10 ) );
+
+                    if( record.mSmcFormatOk )
+                    {
+                        std::string tmpStr = currentLine.substr( 10, 30 );
+                        trim( tmpStr );
+                        record.mTextStationName = tmpStr;
+
+                        tmpStr = currentLine.substr( 52, 6 );
+                        trim( tmpStr );
+                        record.mTextComponentOrientation = tmpStr;
+                    }
+                    else
+                    {
+                        record.mSmcFormatOk = ( ( "station = " == currentLine.substr( 0, 10 ) || "Station = " == currentLine.substr( 0, 10 ) )
+                                           && "component=" == currentLine.substr( 36, 10 ) );
+
+                        if( record.mSmcFormatOk )
+                        {
+                            std::string tmpStr = currentLine.substr( 10, 25 );
+                            trim( tmpStr );
+                            record.mTextStationName = tmpStr;
+
+                            tmpStr = currentLine.substr( 47, 6 );
+                            trim( tmpStr );
+                            record.mTextComponentOrientation = tmpStr;
+                        }
+                    }
+                    break;
+
+                case 7:
+                    record.mSmcFormatOk = ( "epicentral dist =" == currentLine.substr( 0, 17 )
+                                     && ( "pk acc =" == currentLine.substr( 33, 8 )
+                                       || "pk     =" == currentLine.substr( 33, 8 ) )
+                                        );
+
+                    if( record.mSmcFormatOk )
+                    {
+                        std::string tmpStr = currentLine.substr( 17, 9 );
+                        trim( tmpStr );
+                        record.mTextEpicentralDistanceKm = tmpStr;
+
+                        tmpStr = currentLine.substr( 41, 10 );
+                        trim( tmpStr );
+
+                        try
+                        {
+                            // if a value is provided, convert cm/s2 -> m/s2
+                            double pkAccel = std::stod( tmpStr );
+                            pkAccel *= 1.e-2;
+                            record.mTextPeakAcceleration = std::to_string( pkAccel );
+                        }
+                        catch( const std::invalid_argument& )
+                        {
+                            record.mTextPeakAcceleration = tmpStr;
+                        }
+                    }
+                    break;
+
+                case 8:
+                    record.mSmcFormatOk = ( "inst type=" == currentLine.substr( 0, 10 )
+                                       && "data source =" == currentLine.substr( 21, 13 ) );
+
+                    if( record.mSmcFormatOk )
+                    {
+                        std::string tmpStr = currentLine.substr( 10, 5 );
+                        trim( tmpStr );
+                        record.mTextSensorTypeStr = tmpStr;
+
+                        tmpStr = currentLine.substr( 35, 45 );
+                        trim( tmpStr );
+                        record.mTextDataSourceStr = tmpStr;
+                    }
+                    break;
+
+                case 2:
+                case 9:
+                case 10:
+                case 11:
+                    trim( currentLine );
+
+                    if( record.mSmcFormatOk )
+                    {
+                        record.mSmcFormatOk = ( STAR == currentLine );
+                    }
+                    break;
+
+                default:
+                    record.mSmcFormatOk = false;
+                    break;
+            }
+        }
+        else if( crtLineNr <= Smc::LAST_INT_LINE_NR )
+        {
+            ///////////////////////
+            // integer header
+            ///////////////////////
+
+            if( Smc::LAST_TEXT_LINE_NR + 1 == crtLineNr )
+            {
+                substringsVec.clear();
+            }
+
+            for( size_t i = 0; i < currentLine.size(); i += Smc::HEADER_INT_VALUE_LENGTH )
+            {
+                substringsVec.push_back( currentLine.substr( i, Smc::HEADER_INT_VALUE_LENGTH ) );
+            }
+
+            if( Smc::LAST_INT_LINE_NR == crtLineNr )
+            {
+                std::vector<int16_t> tmpIntVec( substringsVec.size() );
+
+                for( size_t i = 0; i < tmpIntVec.size(); i++ )
+                {
+                    tmpIntVec.at( i ) = std::stoi( substringsVec.at( i ) );
+                }
+
+                record.mNoValueInteger = tmpIntVec.at( Smc::INT_FIELD_UNDEFINED_VALUE );
+
+                record.mRecordStart.year = tmpIntVec.at( Smc::INT_FIELD_YEAR );
+                record.mRecordStart.julianDay = tmpIntVec.at( Smc::INT_FIELD_JULIAN_DAY );
+                record.mRecordStart.hour = tmpIntVec.at( Smc::INT_FIELD_HOUR );
+                record.mRecordStart.minute = tmpIntVec.at( Smc::INT_FIELD_MINUTE );
+                record.mRecordStart.second = tmpIntVec.at( Smc::INT_FIELD_SECOND );
+                record.mRecordStart.millisecond = tmpIntVec.at( Smc::INT_FIELD_MILLISECOND );
+
+                record.mVerticalOrientation = tmpIntVec.at( Smc::INT_FIELD_VERTICAL_ORIENTATION_FROM_UP );
+                record.mHorizontalOrientation = tmpIntVec.at( Smc::INT_FIELD_HORIZONTAL_ORIENTATION_FROM_NORTH_TO_EAST );
+
+                record.mSensorTypeCode = tmpIntVec.at( Smc::INT_FIELD_SENSOR_TYPE_CODE );
+
+                if( record.isValidInteger( record.mSensorTypeCode ) )
+                {
+                    record.mSensorTypeStr = Smc::SENSOR_TYPE_NAMES.at( record.mSensorTypeCode );
+                }
+                else
+                {
+                    record.mSensorTypeStr = "undefined";
+                }
+
+                record.mHeaderCommentLinesCount = tmpIntVec.at( Smc::INT_FIELD_NR_OF_COMMENT_LINES );
+
+                record.mDataValuesCount = tmpIntVec.at( Smc::INT_FIELD_NR_OF_VALUES );
+
+                if( record.isValidInteger( record.mDataValuesCount ) )
+                {
+                    record.mDataValuesRecordedCount = record.mDataValuesCount;
+                }
+                else
+                {
+                    record.mSmcFormatOk = false;
+
+                    aError = "No valid data length found in SMC file.";
+
+                    break;
+                }
+
+                record.mDataLinesCount = static_cast<uint16_t>( std::ceil( static_cast<double>( record.mDataValuesCount ) / Smc::DATA_VALUES_PER_LINE ) );
+
+                if( 0 == record.mDataLinesCount )
+                {
+                    record.mSmcFormatOk = false;
+
+                    aError = "No data values specified in SMC file.";
+
+                    break;
+                }
+
+                record.mStructureType = static_cast<Smc::StructureType>( tmpIntVec.at( Smc::INT_FIELD_STRUCTURE_TYPE ) );
+
+                record.mStructureTypeName = "unknown";
+
+                if( record.mStructureType <= Smc::STRUCTURE_TYPE_MAX_KNOWN )
+                {
+                    record.mStructureTypeName = Smc::STRUCTURE_TYPE_NAMES.at( record.mStructureType );
+                }
+
+                switch( record.mStructureType )
+                {
+                    case Smc::STRUCTURE_TYPE_BUILDING:
+                        record.mStructureBuilding.nrFloorsAboveGrade = tmpIntVec.at( Smc::INT_FIELD_TOTAL_NR_OF_FLOORS_ABOVE_GRADE );
+                        record.mStructureBuilding.nrStoriesBelowGrade = tmpIntVec.at( Smc::INT_FIELD_TOTAL_NR_OF_STORIES_BELOW_GRADE );
+                        record.mStructureBuilding.floorNrWhereLocated = tmpIntVec.at( Smc::INT_FIELD_FLOOR_NR );
+                        break;
+
+                    case Smc::STRUCTURE_TYPE_BRIDGE:
+                        record.mStructureBridge.nrSpans = tmpIntVec.at( Smc::INT_FIELD_NR_OF_SPANS );
+                        record.mStructureBridge.whereLocated =
+                                static_cast<Smc::BridgeLocation>( tmpIntVec.at( static_cast<size_t>( Smc::INT_FIELD_TRANSDUCER_LOCATION_BRIDGES ) ) );
+                        break;
+
+                    case Smc::STRUCTURE_TYPE_DAM:
+                        record.mStructureDam.location =
+                            static_cast<Smc::DamLocation>( tmpIntVec.at( static_cast<size_t>( Smc::INT_FIELD_TRANSDUCER_LOCATION_DAMS ) ) );
+                        record.mStructureDam.constructionType =
+                            static_cast<Smc::DamConstructionType>( tmpIntVec.at( static_cast<size_t>( Smc::INT_FIELD_CONSTRUCTION_TYPE ) ) );
+                        break;
+
+                    default:
+                        break;
+                }
+
+                record.mStationNr = tmpIntVec.at( Smc::INT_FIELD_STATION_NR );
+
+                record.mFirstRecordedSampleIndex = tmpIntVec.at( Smc::INT_FIELD_FIRST_RECORDED_SAMPLE );
+                record.mLastRecordedSampleIndex = tmpIntVec.at( Smc::INT_FIELD_LAST_RECORDED_SAMPLE );
+
+                if( record.isValidInteger( record.mFirstRecordedSampleIndex ) )
+                {
+                    if( record.mFirstRecordedSampleIndex >= 1
+                     && record.mFirstRecordedSampleIndex <= record.mDataValuesCount )
+                    {
+                        record.mDataValuesRecordedCount -= ( record.mFirstRecordedSampleIndex - 1 );
+                    }
+                    else
+                    {
+                        record.mFirstRecordedSampleIndex = 1;
+                    }
+                }
+                else
+                {
+                    record.mFirstRecordedSampleIndex = 1;
+                }
+
+                if( record.isValidInteger( record.mLastRecordedSampleIndex ) )
+                {
+                    if( record.mLastRecordedSampleIndex <= record.mDataValuesCount
+                     && record.mLastRecordedSampleIndex >= 1 )
+                    {
+                        record.mDataValuesRecordedCount -= ( record.mDataValuesCount - record.mLastRecordedSampleIndex );
+                    }
+                    else
+                    {
+                        record.mLastRecordedSampleIndex = record.mDataValuesCount;
+                    }
+                }
+                else
+                {
+                    record.mLastRecordedSampleIndex = record.mDataValuesCount;
+                }
+
+                record.mDataVector.resize( record.mDataValuesRecordedCount );
+            }
+        }
+        else if( crtLineNr <= Smc::LAST_REAL_LINE_NR )
+        {
+            ///////////////////////
+            // real header
+            ///////////////////////
+
+            if( Smc::LAST_INT_LINE_NR + 1 == crtLineNr )
+            {
+                substringsVec.clear();
+            }
+
+            for( size_t i = 0; i < currentLine.size(); i += Smc::HEADER_REAL_VALUE_LENGTH )
+            {
+                substringsVec.push_back( currentLine.substr( i, Smc::HEADER_REAL_VALUE_LENGTH ) );
+            }
+
+            if( Smc::LAST_REAL_LINE_NR == crtLineNr )
+            {
+                std::vector<double> tmpRealVec( substringsVec.size() );
+
+                for( size_t i = 0; i < tmpRealVec.size(); i++ )
+                {
+                    tmpRealVec.at( i ) = std::stod( substringsVec.at( i ) );
+                }
+
+                record.mNoValueReal = tmpRealVec.at( Smc::REAL_FIELD_UNDEFINED_VALUE );
+
+                record.mSamplingRate = tmpRealVec.at( Smc::REAL_FIELD_SAMPLING_RATE );
+
+                if( record.isValidReal( record.mSamplingRate ) )
+                {
+                    if( record.mSamplingRate > 0 )
+                    {
+                        record.mDataLengthSeconds = record.mDataValuesRecordedCount / record.mSamplingRate;
+                    }
+                    else
+                    {
+                        record.mSmcFormatOk = false;
+
+                        aError = "Invalid sampling rate value found in SMC file.";
+
+                        break;
+                    }
+                }
+                else
+                {
+                    record.mSmcFormatOk = false;
+
+                    aError = "No data sampling rate found in SMC file.";
+
+                    break;
+                }
+
+                record.mEpicenter.latitude = tmpRealVec.at( Smc::REAL_FIELD_EARTHQUAKE_LATITUDE );
+                record.mEpicenter.longitude = tmpRealVec.at( Smc::REAL_FIELD_EARTHQUAKE_LONGITUDE );
+                record.mEpicenter.depthKm = tmpRealVec.at( Smc::REAL_FIELD_EARTHQUAKE_DEPTH_KM );
+
+                record.mEarthquakeMagnitude.momentMagnitude = tmpRealVec.at( Smc::REAL_FIELD_SOURCE_MOMENT_MAGNITUDE );
+                record.mEarthquakeMagnitude.surfaceWaveMagnitude = tmpRealVec.at( Smc::REAL_FIELD_SOURCE_SURFACE_WAVE_MAGNITUDE );
+                record.mEarthquakeMagnitude.localMagnitude = tmpRealVec.at( Smc::REAL_FIELD_SOURCE_LOCAL_MAGNITUDE );
+                record.mEarthquakeMagnitude.other = tmpRealVec.at( Smc::REAL_FIELD_SOURCE_OTHER );
+
+                record.mSeismicMomentNm = tmpRealVec.at( Smc::REAL_FIELD_SEISMIC_MOMENT_DYNE_CM );
+
+                if( record.isValidReal( record.mSeismicMomentNm ) )
+                {
+                    record.mSeismicMomentNm *= 1.e-7; // dyn-cm to Nm
+                }
+
+                record.mStation.latitude = tmpRealVec.at( Smc::REAL_FIELD_STATION_LATITUDE );
+                record.mStation.longitude = tmpRealVec.at( Smc::REAL_FIELD_STATION_LONGITUDE );
+                record.mStation.elevationMeters = tmpRealVec.at( Smc::REAL_FIELD_STATION_ELEVATION_M );
+                record.mStation.offsetNorthMeters = tmpRealVec.at( Smc::REAL_FIELD_STATION_OFFSET_N_M );
+                record.mStation.offsetEastMeters = tmpRealVec.at( Smc::REAL_FIELD_STATION_OFFSET_E_M );
+                record.mStation.offsetUpMeters = tmpRealVec.at( Smc::REAL_FIELD_STATION_OFFSET_UP_M );
+
+                record.mEpicentralDistanceKm = tmpRealVec.at( Smc::REAL_FIELD_EPICENTRAL_DISTANCE_KM );
+                record.mEpicenterToStationAzimuth = tmpRealVec.at( Smc::REAL_FIELD_EPICENTER_TO_STATION_AZIMUTH );
+
+                record.mDigitizationUnitsPerCm = tmpRealVec.at( Smc::REAL_FIELD_DIGITIZATION_UNITS_1_CM );
+
+                record.mSensorCutoffFrequency = tmpRealVec.at( Smc::REAL_FIELD_SENSOR_CUTOFF_FREQUENCY_HZ );
+                record.mSensorDampingCoefficient = tmpRealVec.at( Smc::REAL_FIELD_SENSOR_DAMPING_COEFFICIENT );
+
+                record.mRecorderSensitivityCmG = tmpRealVec.at( Smc::REAL_FIELD_RECORDER_SENSITIVITY_CM_G );
+
+                record.mMaximumFromRecord.time = tmpRealVec.at( Smc::REAL_FIELD_TIME_OF_MAXIMUM_S );
+                record.mMaximumFromRecord.accelerationMs2 = tmpRealVec.at( Smc::REAL_FIELD_VALUE_OF_MAXIMUM_CM_S2 );
+
+                if( record.isValidReal( record.mMaximumFromRecord.accelerationMs2 ) )
+                {
+                    record.mMaximumFromRecord.accelerationMs2 *= 1.e-2; // m/s2
+                }
+
+                record.mMinimumFromRecord.time = tmpRealVec.at( Smc::REAL_FIELD_TIME_OF_MINIMUM_S );
+                record.mMinimumFromRecord.accelerationMs2 = tmpRealVec.at( Smc::REAL_FIELD_VALUE_OF_MINIMUM_CM_S2 );
+
+                if( record.isValidReal( record.mMinimumFromRecord.accelerationMs2 ) )
+                {
+                    record.mMinimumFromRecord.accelerationMs2 *= 1.e-2; // m/s2
+                }
+            }
+        }
+        else if( crtLineNr <= Smc::LAST_REAL_LINE_NR + record.mHeaderCommentLinesCount )
+        {
+            ///////////////////////
+            // comments header
+            ///////////////////////
+
+            if( Smc::LAST_INT_LINE_NR + 1 == crtLineNr )
+            {
+                substringsVec.clear();
+            }
+
+            substringsVec.push_back( currentLine );
+
+            if( Smc::LAST_REAL_LINE_NR + record.mHeaderCommentLinesCount == crtLineNr )
+            {
+                // intentionally do nothing
+            }
+        }
+        else if( crtLineNr <= Smc::LAST_REAL_LINE_NR + record.mHeaderCommentLinesCount + record.mDataLinesCount )
+        {
+            ///////////////////////
+            // data
+            ///////////////////////
+
+            if( Smc::LAST_REAL_LINE_NR + record.mHeaderCommentLinesCount + 1 == crtLineNr )
+            {
+                substringsVec.clear();
+            }
+
+            for( size_t i = 0; i < currentLine.size(); i += Smc::DATA_VALUE_LENGTH )
+            {
+                substringsVec.push_back( currentLine.substr( i, Smc::DATA_VALUE_LENGTH ) );
+            }
+
+            if( Smc::LAST_REAL_LINE_NR + record.mHeaderCommentLinesCount + record.mDataLinesCount == crtLineNr )
+            {
+                std::vector<double> dataVec( substringsVec.size() );
+
+                for( size_t i = 0; i < dataVec.size(); i++ )
+                {
+                    dataVec.at( i ) = std::stod( substringsVec.at( i ) );
+                }
+
+                if( dataVec.size() != static_cast<size_t>( record.mDataValuesCount ) )
+                {
+                    record.mSmcFormatOk = false;
+
+                    aError = "Expected data length was " + std::to_string( record.mDataValuesCount )
+                            + " , it is " + std::to_string( dataVec.size() ) + ".";
+
+                    break;
+                }
+
+                size_t firstRecordedIndex = record.mFirstRecordedSampleIndex - 1;
+                size_t lastRecordedIndex = dataVec.size() - 1 - ( record.mDataValuesCount - record.mLastRecordedSampleIndex );
+
+                for( size_t i = firstRecordedIndex, j = 0; i <= lastRecordedIndex; i++, j++ )
+                {
+                    record.mDataVector.at( j ) = 0.1 * dataVec.at( i ); // m/s2
+                }
+            }
+        }
+    }
+
+    if( record.mSmcFormatOk
+     && crtLineNr < Smc::LAST_REAL_LINE_NR + record.mHeaderCommentLinesCount + record.mDataLinesCount )
+    {
+        record.mSmcFormatOk = false;
+        aError = "Unexpected end of SMC file.";
+    }
+
+    const bool formatOk = record.mSmcFormatOk;
+
+    if( formatOk )
+    {
+        aRecordVec.push_back( std::move( record ) );
+    }
+    else
+    {
+        if( aError.size() )
+        {
+            aError += "\n";
+        }
+
+        aError += "SMC format is wrong at line " + std::to_string( crtLineNr ) + ".";
+    }
+
+    return formatOk;
 }
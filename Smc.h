@@ -28,11 +28,14 @@ This file contains the definitions for processing SMC (Strong Motion CD) files.
 #include <string>
 #include <vector>
 
+#include "StrongMotionReader.h"
 
 //************************************************************************
 // Class for handling SMC data files
+// The record is also the common representation of all strong-motion
+// formats, which are read into it by the other readers.
 //************************************************************************
-class Smc
+class Smc : public StrongMotionReader
 {
     //************************************************************************
     // constants and types
@@ -176,6 +179,16 @@ class Smc
             INT_FIELD_FILE_FLAG
         }IntField;
 
+        typedef struct
+        {
+            int16_t     year;
+            int16_t     julianDay;
+            int16_t     hour;
+            int16_t     minute;
+            int16_t     second;
+            int16_t     millisecond;
+        }RecordStart;
+
         typedef struct
         {
             double latitude;
@@ -263,6 +276,36 @@ class Smc
     public:
         Smc();
 
+        bool canRead
+            (
+            const char*     aData,          //!< file content
+            const size_t    aLength         //!< file length
+            ) const override;
+
+        std::string getFormatName() const override;
+
+        double getRecordStartSeconds() const;
+
+        bool hasRecordStartTime() const;
+
+        bool isValidInteger
+            (
+            const int32_t   aIntValue       //!< integer value
+            ) const;
+
+        bool isValidReal
+            (
+            const double    aRealValue      //!< real value
+            ) const;
+
+        bool read
+            (
+            const char*         aData,          //!< file content
+            const size_t        aLength,        //!< file length
+            std::vector<Smc>&   aRecordVec,     //!< records are appended
+            std::string&        aError          //!< error message
+            ) const override;
+
 
     //************************************************************************
     // variables
@@ -270,6 +313,7 @@ class Smc
     public:
         bool                    mSmcFormatOk;               //!< true if the SMC file format is OK
         bool                    mSmcTypeAccelerogram;       //!< true if the SMC file is an accelerogram
+        bool                    mDataCalibrated;            //!< true if data values are physical units, false for raw counts
 
         /////////////////////////////////
         // text header
@@ -322,6 +366,8 @@ class Smc
         /////////////////////////////////
         int16_t                 mNoValueInteger;            //!< integer value corresponding to N/A
 
+        RecordStart             mRecordStart;               //!< time of the first sample
+
         int16_t                 mVerticalOrientation;       //!< degrees from up (up=0, down=180) [deg]
         int16_t                 mHorizontalOrientation;     //!< degrees from N to E (N=0, E=90, S=180, W=270) [deg]
 
@@ -376,7 +422,9 @@ class Smc
         // data
         /////////////////////////////////
         std::vector<double>     mDataVector;                //!< accelerogram values [m/s2]
-        int16_t                 mDataValuesRecordedCount;   //!< lenght of recorded data, considering first and last indexes
+        std::vector<double>     mVelocityVector;            //!< velocity derived from the accelerogram [m/s]
+        std::vector<double>     mDisplacementVector;        //!< displacement derived from the accelerogram [m]
+        int32_t                 mDataValuesRecordedCount;   //!< lenght of recorded data, considering first and last indexes
         double                  mDataLengthSeconds;         //!< data duration [s]
 };
 
@@ -0,0 +1,258 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2025 Mihai Ursu                                                 //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+/*
+SmcIntegration.cpp
+This file contains the sources for deriving velocity and displacement
+from SMC (Strong Motion CD) accelerograms.
+*/
+
+#include "SmcIntegration.h"
+
+#include <algorithm>
+#include <cmath>
+
+
+//!************************************************************************
+//! Constructor
+//!************************************************************************
+SmcIntegration::SmcIntegration
+    (
+    const double aSamplingRate,     //!< sampling rate [SPS]
+    const double aHighPassCornerHz  //!< high-pass corner frequency [Hz]
+    )
+    : mSamplingRate( aSamplingRate )
+    , mHighPassCornerHz( std::clamp( aHighPassCornerHz, HIGH_PASS_CORNER_HZ_MIN, HIGH_PASS_CORNER_HZ_MAX ) )
+{
+    calculateFilterCoeffs();
+}
+
+
+//!************************************************************************
+//! Calculate the coefficients of the Butterworth high-pass filter,
+//! as a cascade of second order sections (bilinear transform)
+//!
+//! The corner is kept below 0.4 of the sampling rate.
+//!
+//! @returns: nothing
+//!************************************************************************
+void SmcIntegration::calculateFilterCoeffs()
+{
+    mBiquadVec.clear();
+
+    if( mSamplingRate > 0 )
+    {
+        const double fc = std::min( mHighPassCornerHz, 0.4 * mSamplingRate );
+        const double w0 = 2.0 * M_PI * fc / mSamplingRate;
+        const double cosW0 = cos( w0 );
+        const double sinW0 = sin( w0 );
+
+        for( uint8_t k = 0; k < HIGH_PASS_ORDER / 2; k++ )
+        {
+            // quality factor of each Butterworth pole pair
+            const double q = 1.0 / ( 2.0 * cos( M_PI * ( 2 * k + 1 ) / ( 2 * HIGH_PASS_ORDER ) ) );
+            const double alpha = sinW0 / ( 2.0 * q );
+            const double a0 = 1.0 + alpha;
+
+            Biquad biquad;
+            biquad.b0 = 0.5 * ( 1.0 + cosW0 ) / a0;
+            biquad.b1 = -( 1.0 + cosW0 ) / a0;
+            biquad.b2 = biquad.b0;
+            biquad.a1 = -2.0 * cosW0 / a0;
+            biquad.a2 = ( 1.0 - alpha ) / a0;
+
+            mBiquadVec.push_back( biquad );
+        }
+    }
+}
+
+
+//!************************************************************************
+//! Filter data in place through a second order section
+//! (transposed direct form II)
+//!
+//! @returns: nothing
+//!************************************************************************
+void SmcIntegration::filterBiquad
+    (
+    const Biquad&   aBiquad,        //!< filter section
+    double*         aData,          //!< data, filtered in place
+    const size_t    aLength,        //!< data length
+    const bool      aReverse        //!< true to filter backwards
+    ) const
+{
+    double z1 = 0;
+    double z2 = 0;
+
+    for( size_t n = 0; n < aLength; n++ )
+    {
+        double& x = aReverse ? aData[aLength - 1 - n] : aData[n];
+        const double y = aBiquad.b0 * x + z1;
+
+        z1 = aBiquad.b1 * x - aBiquad.a1 * y + z2;
+        z2 = aBiquad.b2 * x - aBiquad.a2 * y;
+        x = y;
+    }
+}
+
+
+//!************************************************************************
+//! Apply the high-pass filter forward and backward, for zero phase shift
+//!
+//! @returns: nothing
+//!************************************************************************
+void SmcIntegration::highPassZeroPhase
+    (
+    std::vector<double>&    aDataVec    //!< padded data, filtered in place
+    ) const
+{
+    for( const Biquad& biquad : mBiquadVec )
+    {
+        filterBiquad( biquad, aDataVec.data(), aDataVec.size(), false );
+    }
+
+    for( const Biquad& biquad : mBiquadVec )
+    {
+        filterBiquad( biquad, aDataVec.data(), aDataVec.size(), true );
+    }
+}
+
+
+//!************************************************************************
+//! Integrate using the trapezoidal rule, starting from zero
+//!
+//! @returns: nothing
+//!************************************************************************
+void SmcIntegration::integrateTrapezoidal
+    (
+    const std::vector<double>&  aInVec,     //!< input data
+    std::vector<double>&        aOutVec     //!< integrated data
+    ) const
+{
+    const double halfDt = 0.5 / mSamplingRate;
+    aOutVec.resize( aInVec.size() );
+
+    double sum = 0;
+
+    if( aInVec.size() )
+    {
+        aOutVec.front() = 0;
+    }
+
+    for( size_t i = 1; i < aInVec.size(); i++ )
+    {
+        sum += halfDt * ( aInVec[i - 1] + aInVec[i] );
+        aOutVec[i] = sum;
+    }
+}
+
+
+//!************************************************************************
+//! Baseline correction: remove the least-squares line fitted on the
+//! record, leaving the padding at zero
+//!
+//! @returns: nothing
+//!************************************************************************
+void SmcIntegration::removeLinearTrend
+    (
+    std::vector<double>&    aDataVec,   //!< padded data
+    const size_t            aFirst,     //!< first index of the record
+    const size_t            aLength     //!< record length
+    ) const
+{
+    if( aLength > 1 )
+    {
+        double* data = aDataVec.data() + aFirst;
+
+        // abscissas are centered, so that the slope and the mean are decoupled
+        const double xMid = 0.5 * ( aLength - 1 );
+        double sumY = 0;
+        double sumXY = 0;
+        double sumXX = 0;
+
+        for( size_t i = 0; i < aLength; i++ )
+        {
+            const double x = i - xMid;
+            sumY += data[i];
+            sumXY += x * data[i];
+            sumXX += x * x;
+        }
+
+        const double mean = sumY / aLength;
+        const double slope = sumXY / sumXX;
+
+        for( size_t i = 0; i < aLength; i++ )
+        {
+            data[i] -= mean + slope * ( i - xMid );
+        }
+    }
+}
+
+
+//!************************************************************************
+//! Derive velocity and displacement from an acceleration record
+//!
+//! Processing steps:
+//! - zero padding at both ends, to absorb the filter transients
+//! - baseline correction of the acceleration (linear trend removal)
+//! - zero-phase high-pass filtering of the acceleration
+//! - trapezoidal integration to velocity, then high-pass filtering
+//! - trapezoidal integration to displacement, then high-pass filtering
+//!
+//! The outputs have the same length as the input.
+//!
+//! References:
+//! [1] Boore, D. M. - On Pads and Filters: Processing Strong-Motion Data,
+//!                    Bull. Seism. Soc. Am. 95 (2), 2005, pp. 745-750
+//!
+//! @returns: nothing
+//!************************************************************************
+void SmcIntegration::process
+    (
+    const std::vector<double>&  aAccelerationVec,   //!< acceleration [m/s2]
+    std::vector<double>&        aVelocityVec,       //!< velocity [m/s]
+    std::vector<double>&        aDisplacementVec    //!< displacement [m]
+    ) const
+{
+    aVelocityVec.clear();
+    aDisplacementVec.clear();
+
+    const size_t length = aAccelerationVec.size();
+
+    if( mSamplingRate > 0 && length )
+    {
+        const double padSeconds = 0.5 * PADDING_FACTOR * HIGH_PASS_ORDER / mHighPassCornerHz;
+        const size_t padLength = static_cast<size_t>( std::ceil( padSeconds * mSamplingRate ) );
+
+        std::vector<double> accelVec( length + 2 * padLength, 0 );
+        std::copy( aAccelerationVec.begin(), aAccelerationVec.end(), accelVec.begin() + padLength );
+
+        removeLinearTrend( accelVec, padLength, length );
+        highPassZeroPhase( accelVec );
+
+        std::vector<double> velVec;
+        integrateTrapezoidal( accelVec, velVec );
+        highPassZeroPhase( velVec );
+
+        std::vector<double> dispVec;
+        integrateTrapezoidal( velVec, dispVec );
+        highPassZeroPhase( dispVec );
+
+        aVelocityVec.assign( velVec.begin() + padLength, velVec.begin() + padLength + length );
+        aDisplacementVec.assign( dispVec.begin() + padLength, dispVec.begin() + padLength + length );
+    }
+}
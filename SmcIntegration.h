@@ -0,0 +1,126 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2025 Mihai Ursu                                                 //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+/*
+SmcIntegration.h
+This file contains the definitions for deriving velocity and displacement
+from SMC (Strong Motion CD) accelerograms.
+*/
+
+#ifndef SmcIntegration_h
+#define SmcIntegration_h
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+//************************************************************************
+// Class for integrating accelerograms into velocity and displacement
+//************************************************************************
+class SmcIntegration
+{
+    //************************************************************************
+    // constants and types
+    //************************************************************************
+    public:
+        static constexpr double HIGH_PASS_CORNER_HZ_DEFAULT = 0.1;  //!< default high-pass corner [Hz]
+        static constexpr double HIGH_PASS_CORNER_HZ_MIN = 0.01;     //!< minimum high-pass corner [Hz]
+        static constexpr double HIGH_PASS_CORNER_HZ_MAX = 5;        //!< maximum high-pass corner [Hz]
+
+    private:
+        static const uint8_t HIGH_PASS_ORDER = 4;                   //!< Butterworth order, for one pass
+
+        static constexpr double PADDING_FACTOR = 1.5;               //!< zero padding = 1.5 * order / corner [s]
+
+        struct Biquad
+        {
+            double b0;      //!< numerator coefficients
+            double b1;
+            double b2;
+            double a1;      //!< denominator coefficients, a0 = 1
+            double a2;
+
+            Biquad()
+            {
+                b0 = 1;
+                b1 = 0;
+                b2 = 0;
+                a1 = 0;
+                a2 = 0;
+            }
+        };
+
+
+    //************************************************************************
+    // functions
+    //************************************************************************
+    public:
+        SmcIntegration
+            (
+            const double aSamplingRate,     //!< sampling rate [SPS]
+            const double aHighPassCornerHz  //!< high-pass corner frequency [Hz]
+            );
+
+        void process
+            (
+            const std::vector<double>&  aAccelerationVec,   //!< acceleration [m/s2]
+            std::vector<double>&        aVelocityVec,       //!< velocity [m/s]
+            std::vector<double>&        aDisplacementVec    //!< displacement [m]
+            ) const;
+
+    private:
+        void calculateFilterCoeffs();
+
+        void filterBiquad
+            (
+            const Biquad&   aBiquad,        //!< filter section
+            double*         aData,          //!< data, filtered in place
+            const size_t    aLength,        //!< data length
+            const bool      aReverse        //!< true to filter backwards
+            ) const;
+
+        void highPassZeroPhase
+            (
+            std::vector<double>&    aDataVec    //!< padded data, filtered in place
+            ) const;
+
+        void integrateTrapezoidal
+            (
+            const std::vector<double>&  aInVec,     //!< input data
+            std::vector<double>&        aOutVec     //!< integrated data
+            ) const;
+
+        void removeLinearTrend
+            (
+            std::vector<double>&    aDataVec,   //!< padded data
+            const size_t            aFirst,     //!< first index of the record
+            const size_t            aLength     //!< record length
+            ) const;
+
+
+    //************************************************************************
+    // variables
+    //************************************************************************
+    private:
+        double                  mSamplingRate;      //!< sampling rate [SPS]
+        double                  mHighPassCornerHz;  //!< high-pass corner frequency [Hz]
+
+        std::vector<Biquad>     mBiquadVec;         //!< high-pass filter sections
+};
+
+#endif // SmcIntegration_h
@@ -0,0 +1,583 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2025 Mihai Ursu                                                 //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+/*
+SmcPlaylist.cpp
+This file contains the sources for playing strong-motion records back to back.
+*/
+
+#include "SmcPlaylist.h"
+
+#include "PolyphaseResampler.h"
+#include "SignalItem.h"
+#include "StrongMotionReader.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <limits>
+
+
+//!************************************************************************
+//! Constructor
+//! Starts the worker which prepares the first entry
+//!************************************************************************
+SmcPlaylist::SmcPlaylist
+    (
+    const std::vector<Entry>&   aEntryVec,      //!< playlist entries
+    const Settings&             aSettings,      //!< playing settings
+    const double                aOutputRate,    //!< output sampling rate [SPS]
+    const uint8_t               aChannelCount   //!< output channels
+    )
+    : mEntryVec( aEntryVec )
+    , mSettings( aSettings )
+    , mOutputRate( aOutputRate )
+    , mChannelCount( std::max<uint8_t>( aChannelCount, 1 ) )
+    , mGapFrames( static_cast<size_t>( std::llround( std::max( aSettings.gapSeconds, 0.0 ) * aOutputRate ) ) )
+    , mCurrentPos( 0 )
+    , mGapLeft( 0 )
+    , mUnderrun( false )
+    , mNextReady( false )
+    , mRequestedIndex( aEntryVec.empty() ? std::numeric_limits<size_t>::max() : 0 )
+    , mCurrentIndex( 0 )
+    , mUnderrunsCount( 0 )
+    , mFinished( aEntryVec.empty() )
+    , mStopWorker( false )
+{
+    mWorker = std::thread( &SmcPlaylist::runPrefetch, this );
+}
+
+
+//!************************************************************************
+//! Destructor
+//! Stops the worker
+//!************************************************************************
+SmcPlaylist::~SmcPlaylist()
+{
+    {
+        std::lock_guard<std::mutex> lock( mMutex );
+        mStopWorker = true;
+    }
+
+    mCondition.notify_one();
+
+    if( mWorker.joinable() )
+    {
+        mWorker.join();
+    }
+}
+
+
+//!************************************************************************
+//! Switch to the prepared entry, if the worker has finished it
+//! Called only from the audio thread, never blocks.
+//!
+//! @returns true if a new entry is playing
+//!************************************************************************
+bool SmcPlaylist::advance()
+{
+    bool advanced = false;
+
+    if( mNextReady.load( std::memory_order_acquire ) && mMutex.try_lock() )
+    {
+        // the finished entry is handed to the worker, which frees it
+        std::swap( mCurrent, mNext );
+        mNextReady = false;
+
+        size_t nextIndex = mCurrent->index + 1;
+
+        if( nextIndex >= mEntryVec.size() )
+        {
+            nextIndex = mSettings.loop ? 0 : std::numeric_limits<size_t>::max();
+        }
+
+        mRequestedIndex = nextIndex;
+        mMutex.unlock();
+        mCondition.notify_one();
+
+        mCurrentPos = 0;
+        mGapLeft = mGapFrames;
+        mCurrentIndex = mCurrent->index;
+        mUnderrun = false;
+        advanced = true;
+    }
+    else if( !mNextReady && std::numeric_limits<size_t>::max() == mRequestedIndex )
+    {
+        mFinished = true;
+    }
+
+    return advanced;
+}
+
+
+//!************************************************************************
+//! Get the index of the entry being played
+//!
+//! @returns the entry index
+//!************************************************************************
+size_t SmcPlaylist::getCurrentEntry() const
+{
+    return mCurrentIndex;
+}
+
+
+//!************************************************************************
+//! Get the number of playlist entries
+//!
+//! @returns the entries count
+//!************************************************************************
+size_t SmcPlaylist::getEntriesCount() const
+{
+    return mEntryVec.size();
+}
+
+
+//!************************************************************************
+//! Get how many times the next entry was not ready in time
+//!
+//! @returns the underruns count
+//!************************************************************************
+uint32_t SmcPlaylist::getUnderrunsCount() const
+{
+    return mUnderrunsCount;
+}
+
+
+//!************************************************************************
+//! Check if the last entry was played
+//!
+//! @returns true if the playlist has ended
+//!************************************************************************
+bool SmcPlaylist::isFinished() const
+{
+    return mFinished;
+}
+
+
+//!************************************************************************
+//! Read, integrate, align and resample the records of an entry
+//! Runs on the worker thread.
+//!
+//! @returns true if the entry can be played
+//!************************************************************************
+bool SmcPlaylist::prepareEntry
+    (
+    const size_t        aIndex,         //!< entry index
+    PreparedEntry&      aPrepared,      //!< prepared entry
+    std::string&        aError          //!< error message
+    ) const
+{
+    std::vector<Smc> smcVec;
+
+    for( StrongMotionReader::FileResult& crtResult : StrongMotionReader::readFiles( mEntryVec.at( aIndex ) ) )
+    {
+        if( crtResult.error.size() )
+        {
+            aError = "Could not read file \"" + crtResult.fileName + "\"";
+
+            if( crtResult.formatName.size() )
+            {
+                aError += " as " + crtResult.formatName;
+            }
+
+            aError += ". " + crtResult.error;
+            return false;
+        }
+
+        for( Smc& crtSmc : crtResult.recordVec )
+        {
+            smcVec.push_back( std::move( crtSmc ) );
+        }
+    }
+
+    if( smcVec.empty() )
+    {
+        aError = "Playlist entry " + std::to_string( aIndex + 1 ) + " has no records.";
+        return false;
+    }
+
+    bool alignComponents = true;
+    bool dataCalibrated = true;
+    double earliestStart = 0;
+
+    for( size_t i = 0; i < smcVec.size(); i++ )
+    {
+        Smc& crtSmc = smcVec.at( i );
+
+        if( Smc::DATA_TYPE_FILE_CORRECTED_ACCELEROGRAM != mSettings.playedDataType )
+        {
+            SmcIntegration integration( crtSmc.mSamplingRate, mSettings.highPassCornerHz );
+            integration.process( crtSmc.mDataVector, crtSmc.mVelocityVector, crtSmc.mDisplacementVector );
+        }
+
+        alignComponents = alignComponents && crtSmc.hasRecordStartTime();
+        dataCalibrated = dataCalibrated && crtSmc.mDataCalibrated;
+        double crtStart = crtSmc.getRecordStartSeconds();
+
+        if( 0 == i || crtStart < earliestStart )
+        {
+            earliestStart = crtStart;
+        }
+    }
+
+    std::vector<const std::vector<double>*> playedVec;
+
+    for( const Smc& crtSmc : smcVec )
+    {
+        switch( mSettings.playedDataType )
+        {
+            case Smc::DATA_TYPE_FILE_VELOCITY:
+                playedVec.push_back( &crtSmc.mVelocityVector );
+                break;
+
+            case Smc::DATA_TYPE_FILE_DISPLACEMENT:
+                playedVec.push_back( &crtSmc.mDisplacementVector );
+                break;
+
+            default:
+                playedVec.push_back( &crtSmc.mDataVector );
+                break;
+        }
+    }
+
+    // same full scale rules as a single opened record
+    double fullScale = SignalItem::SignalSmc::MAX_SCALE_ACCEL_MS2;
+
+    if( Smc::DATA_TYPE_FILE_CORRECTED_ACCELEROGRAM != mSettings.playedDataType || !dataCalibrated )
+    {
+        fullScale = 0;
+
+        for( const std::vector<double>* crtData : playedVec )
+        {
+            for( const double value : *crtData )
+            {
+                fullScale = std::max( fullScale, std::fabs( value ) );
+            }
+        }
+    }
+
+    if( fullScale <= 0 )
+    {
+        fullScale = 1;
+    }
+
+    aPrepared.index = aIndex;
+    aPrepared.componentVec.clear();
+    aPrepared.channelVec.clear();
+    aPrepared.framesCount = 0;
+
+    const size_t componentsCount = std::min<size_t>( smcVec.size(), INT8_MAX );
+
+    for( size_t i = 0; i < componentsCount; i++ )
+    {
+        const Smc& crtSmc = smcVec.at( i );
+        const std::vector<double>& data = *playedVec.at( i );
+        size_t offsetFrames = 0;
+
+        if( componentsCount > 1 && alignComponents )
+        {
+            offsetFrames = static_cast<size_t>( std::llround( ( crtSmc.getRecordStartSeconds() - earliestStart ) / mSettings.speedUp * mOutputRate ) );
+        }
+
+        std::vector<double> resampledVec;
+        PolyphaseResampler resampler( crtSmc.mSamplingRate * mSettings.speedUp, mOutputRate );
+        resampler.process( data.data(), data.size(), resampledVec );
+        resampler.flush( resampledVec );
+
+        std::vector<float> componentValues( offsetFrames + resampledVec.size(), 0 );
+
+        for( size_t k = 0; k < resampledVec.size(); k++ )
+        {
+            double value = std::max( -1.0, std::min( 1.0, resampledVec[k] / fullScale ) );
+            componentValues[offsetFrames + k] = static_cast<float>( value );
+        }
+
+        aPrepared.framesCount = std::max( aPrepared.framesCount, componentValues.size() );
+        aPrepared.componentVec.push_back( std::move( componentValues ) );
+        aPrepared.channelVec.push_back( componentsCount > 1 ? static_cast<int8_t>( i ) : -1 );
+    }
+
+    for( std::vector<float>& crtComponent : aPrepared.componentVec )
+    {
+        crtComponent.resize( aPrepared.framesCount, 0 );
+    }
+
+    aError.clear();
+    return true;
+}
+
+
+//!************************************************************************
+//! Read a playlist file
+//! Each line which is not empty or a '#' comment is an entry, made of
+//! one or more files separated by ';'. Relative names are resolved
+//! against the folder of the playlist.
+//!
+//! @returns true if at least one entry was read
+//!************************************************************************
+bool SmcPlaylist::readPlaylistFile
+    (
+    const std::string&      aFileName,      //!< playlist file name
+    std::vector<Entry>&     aEntryVec,      //!< read entries
+    std::string&            aError          //!< error message
+    )
+{
+    aEntryVec.clear();
+    std::ifstream inputFile( aFileName );
+
+    if( !inputFile.is_open() )
+    {
+        aError = "Could not open the playlist file.";
+        return false;
+    }
+
+    const size_t separatorPos = aFileName.find_last_of( "/\\" );
+    const std::string folder = ( std::string::npos == separatorPos ) ? "" : aFileName.substr( 0, separatorPos + 1 );
+    std::string line;
+
+    while( std::getline( inputFile, line ) )
+    {
+        trimName( line );
+
+        if( line.empty() || '#' == line.front() )
+        {
+            continue;
+        }
+
+        Entry crtEntry;
+        size_t startPos = 0;
+
+        while( startPos <= line.size() )
+        {
+            size_t endPos = line.find( ';', startPos );
+
+            if( std::string::npos == endPos )
+            {
+                endPos = line.size();
+            }
+
+            std::string crtName = line.substr( startPos, endPos - startPos );
+            trimName( crtName );
+
+            if( crtName.size() )
+            {
+                const bool isAbsolute = ( '/' == crtName.front() || '\\' == crtName.front() )
+                                     || ( crtName.size() > 1 && ':' == crtName.at( 1 ) );
+                crtEntry.push_back( isAbsolute ? crtName : folder + crtName );
+            }
+
+            startPos = endPos + 1;
+        }
+
+        if( crtEntry.size() )
+        {
+            aEntryVec.push_back( crtEntry );
+        }
+    }
+
+    if( aEntryVec.empty() )
+    {
+        aError = "The playlist has no entries.";
+        return false;
+    }
+
+    aError.clear();
+    return true;
+}
+
+
+//!************************************************************************
+//! Render interleaved frames
+//! Called from the audio thread. Only copies prepared values, so it never
+//! reads files or waits for the worker; if the next entry is late,
+//! silence is played until it is ready.
+//!
+//! @returns nothing
+//!************************************************************************
+void SmcPlaylist::render
+    (
+    double*         aFrames,        //!< interleaved output frames
+    const size_t    aFramesCount    //!< number of frames
+    )
+{
+    size_t doneFrames = 0;
+
+    while( doneFrames < aFramesCount )
+    {
+        double* output = aFrames + doneFrames * mChannelCount;
+        const size_t leftFrames = aFramesCount - doneFrames;
+
+        if( mCurrent && mCurrentPos < mCurrent->framesCount )
+        {
+            const size_t count = std::min( leftFrames, mCurrent->framesCount - mCurrentPos );
+            std::fill( output, output + count * mChannelCount, 0.0 );
+
+            for( size_t i = 0; i < mCurrent->componentVec.size(); i++ )
+            {
+                const float* values = mCurrent->componentVec[i].data() + mCurrentPos;
+                const int8_t channel = mCurrent->channelVec[i];
+
+                if( channel < 0 )
+                {
+                    for( size_t k = 0; k < count; k++ )
+                    {
+                        for( uint8_t c = 0; c < mChannelCount; c++ )
+                        {
+                            output[k * mChannelCount + c] += values[k];
+                        }
+                    }
+                }
+                else if( channel < mChannelCount )
+                {
+                    for( size_t k = 0; k < count; k++ )
+                    {
+                        output[k * mChannelCount + channel] += values[k];
+                    }
+                }
+            }
+
+            mCurrentPos += count;
+            doneFrames += count;
+        }
+        else if( mGapLeft )
+        {
+            const size_t count = std::min( leftFrames, mGapLeft );
+            std::fill( output, output + count * mChannelCount, 0.0 );
+            mGapLeft -= count;
+            doneFrames += count;
+        }
+        else if( !advance() )
+        {
+            // count a late entry once, not for every silent block
+            if( mCurrent && !mFinished && !mUnderrun )
+            {
+                mUnderrun = true;
+                mUnderrunsCount++;
+            }
+
+            std::fill( output, output + leftFrames * mChannelCount, 0.0 );
+            doneFrames = aFramesCount;
+        }
+    }
+}
+
+
+//!************************************************************************
+//! Worker loop preparing the requested entry
+//! Entries which cannot be read are skipped and reported.
+//!
+//! @returns nothing
+//!************************************************************************
+void SmcPlaylist::runPrefetch()
+{
+    const size_t NO_ENTRY = std::numeric_limits<size_t>::max();
+
+    while( true )
+    {
+        std::unique_lock<std::mutex> lock( mMutex );
+        mCondition.wait_for( lock, std::chrono::milliseconds( PREFETCH_WAIT_MS ),
+                             [this, NO_ENTRY]{ return mStopWorker || ( !mNextReady && NO_ENTRY != mRequestedIndex ); } );
+
+        if( mStopWorker )
+        {
+            break;
+        }
+
+        if( mNextReady || NO_ENTRY == mRequestedIndex )
+        {
+            continue;
+        }
+
+        size_t index = mRequestedIndex;
+        lock.unlock();
+
+        std::unique_ptr<PreparedEntry> prepared( new PreparedEntry );
+        std::string error;
+        bool ok = false;
+
+        for( size_t tries = 0; !ok && NO_ENTRY != index && tries < mEntryVec.size() && !mStopWorker; tries++ )
+        {
+            ok = prepareEntry( index, *prepared, error );
+
+            if( !ok )
+            {
+                {
+                    std::lock_guard<std::mutex> errorLock( mMutex );
+                    mErrorVec.push_back( error );
+                }
+
+                index++;
+
+                if( index >= mEntryVec.size() )
+                {
+                    index = mSettings.loop ? 0 : NO_ENTRY;
+                }
+            }
+        }
+
+        lock.lock();
+
+        if( ok )
+        {
+            // the entry handed back by the audio thread is freed here
+            mNext = std::move( prepared );
+            mNextReady.store( true, std::memory_order_release );
+        }
+        else
+        {
+            mRequestedIndex = NO_ENTRY;
+        }
+    }
+}
+
+
+//!************************************************************************
+//! Take the errors of the skipped entries
+//!
+//! @returns the errors reported since the previous call
+//!************************************************************************
+std::vector<std::string> SmcPlaylist::takeErrors()
+{
+    std::lock_guard<std::mutex> lock( mMutex );
+    std::vector<std::string> errorVec;
+    errorVec.swap( mErrorVec );
+    return errorVec;
+}
+
+
+//!************************************************************************
+//! Remove leading and trailing whitespace
+//!
+//! @returns nothing
+//!************************************************************************
+void SmcPlaylist::trimName
+    (
+    std::string&    aName           //!< name to trim
+    )
+{
+    const size_t firstPos = aName.find_first_not_of( " \t\r\n" );
+
+    if( std::string::npos == firstPos )
+    {
+        aName.clear();
+    }
+    else
+    {
+        aName = aName.substr( firstPos, aName.find_last_not_of( " \t\r\n" ) - firstPos + 1 );
+    }
+}
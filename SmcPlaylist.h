@@ -0,0 +1,180 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2025 Mihai Ursu                                                 //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+/*
+SmcPlaylist.h
+This file contains the definitions for playing strong-motion records back to back.
+*/
+
+#ifndef SmcPlaylist_h
+#define SmcPlaylist_h
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Smc.h"
+#include "SmcIntegration.h"
+
+
+//************************************************************************
+// Class for streaming a list of strong-motion records without gaps
+// The next entry is read, integrated and resampled on a worker thread
+// while the current one plays, so that switching entries only swaps
+// prepared buffers.
+//************************************************************************
+class SmcPlaylist
+{
+    //************************************************************************
+    // constants and types
+    //************************************************************************
+    public:
+        static constexpr double GAP_SECONDS_DEFAULT = 2;    //!< silence between entries [s]
+        static constexpr double GAP_SECONDS_MAX = 600;      //!< longest silence between entries [s]
+
+        // files played together, one component per output channel
+        typedef std::vector<std::string> Entry;
+
+        struct Settings
+        {
+            Smc::DataTypeFile   playedDataType;     //!< acceleration, velocity or displacement
+            double              highPassCornerHz;   //!< high-pass corner for velocity and displacement [Hz]
+            double              speedUp;            //!< audification factor, 1 for real time
+            double              gapSeconds;         //!< silence between entries [s]
+            bool                loop;               //!< true to restart after the last entry
+
+            Settings()
+            {
+                playedDataType = Smc::DATA_TYPE_FILE_CORRECTED_ACCELEROGRAM;
+                highPassCornerHz = SmcIntegration::HIGH_PASS_CORNER_HZ_DEFAULT;
+                speedUp = 1;
+                gapSeconds = GAP_SECONDS_DEFAULT;
+                loop = false;
+            }
+        };
+
+    private:
+        static const uint16_t PREFETCH_WAIT_MS = 50;    //!< longest wait of the worker for a request
+
+        // entry resampled at the output rate and scaled to [-1..1]
+        struct PreparedEntry
+        {
+            size_t                          index;          //!< entry index
+            std::vector<std::vector<float>> componentVec;   //!< values of each component
+            std::vector<int8_t>             channelVec;     //!< output channel of each component, -1 for all
+            size_t                          framesCount;    //!< length in output frames
+
+            PreparedEntry()
+            {
+                index = 0;
+                framesCount = 0;
+            }
+        };
+
+
+    //************************************************************************
+    // functions
+    //************************************************************************
+    public:
+        SmcPlaylist
+            (
+            const std::vector<Entry>&   aEntryVec,      //!< playlist entries
+            const Settings&             aSettings,      //!< playing settings
+            const double                aOutputRate,    //!< output sampling rate [SPS]
+            const uint8_t               aChannelCount   //!< output channels
+            );
+
+        ~SmcPlaylist();
+
+        size_t getCurrentEntry() const;
+
+        size_t getEntriesCount() const;
+
+        uint32_t getUnderrunsCount() const;
+
+        bool isFinished() const;
+
+        static bool readPlaylistFile
+            (
+            const std::string&      aFileName,      //!< playlist file name
+            std::vector<Entry>&     aEntryVec,      //!< read entries
+            std::string&            aError          //!< error message
+            );
+
+        void render
+            (
+            double*         aFrames,        //!< interleaved output frames
+            const size_t    aFramesCount    //!< number of frames
+            );
+
+        std::vector<std::string> takeErrors();
+
+    private:
+        bool advance();
+
+        bool prepareEntry
+            (
+            const size_t        aIndex,         //!< entry index
+            PreparedEntry&      aPrepared,      //!< prepared entry
+            std::string&        aError          //!< error message
+            ) const;
+
+        void runPrefetch();
+
+        static void trimName
+            (
+            std::string&    aName           //!< name to trim
+            );
+
+
+    //************************************************************************
+    // variables
+    //************************************************************************
+    private:
+        const std::vector<Entry>        mEntryVec;          //!< playlist entries
+        const Settings                  mSettings;          //!< playing settings
+        const double                    mOutputRate;        //!< output sampling rate [SPS]
+        const uint8_t                   mChannelCount;      //!< output channels
+        const size_t                    mGapFrames;         //!< silence between entries [frames]
+
+        // owned by the audio thread
+        std::unique_ptr<PreparedEntry>  mCurrent;           //!< entry being played
+        size_t                          mCurrentPos;        //!< next frame of the current entry
+        size_t                          mGapLeft;           //!< silent frames left after the current entry
+        bool                            mUnderrun;          //!< true while waiting for the next entry
+
+        // shared with the worker thread
+        std::mutex                      mMutex;             //!< guards the next entry and the errors
+        std::condition_variable         mCondition;         //!< wakes up the worker
+        std::unique_ptr<PreparedEntry>  mNext;              //!< entry prepared by the worker
+        std::vector<std::string>        mErrorVec;          //!< errors of skipped entries
+        std::atomic<bool>               mNextReady;         //!< true if mNext can be played
+        std::atomic<size_t>             mRequestedIndex;    //!< entry the worker should prepare
+        std::atomic<size_t>             mCurrentIndex;      //!< entry being played
+        std::atomic<uint32_t>           mUnderrunsCount;    //!< times the next entry was late
+        std::atomic<bool>               mFinished;          //!< true after the last entry
+        std::atomic<bool>               mStopWorker;        //!< true to end the worker
+        std::thread                     mWorker;            //!< prefetch thread
+};
+
+#endif // SmcPlaylist_h
@@ -0,0 +1,397 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2025 Mihai Ursu                                                 //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+/*
+StrongMotionReader.cpp
+This file contains the sources for reading strong-motion data files.
+*/
+
+#include "StrongMotionReader.h"
+
+#include "CosmosReader.h"
+#include "MiniSeedReader.h"
+#include "PeerAt2Reader.h"
+#include "Smc.h"
+
+#include <QByteArray>
+#include <QFile>
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <exception>
+#include <thread>
+
+
+//************************************************************************
+// Destructor
+//************************************************************************
+StrongMotionReader::~StrongMotionReader()
+{
+}
+
+
+//!************************************************************************
+//! Create the reader which recognizes the file content
+//!
+//! @returns: reader, or nullptr if the format is unknown
+//!************************************************************************
+std::unique_ptr<StrongMotionReader> StrongMotionReader::createReader
+    (
+    const char*     aData,          //!< file content
+    const size_t    aLength         //!< file length
+    )
+{
+    std::vector<std::unique_ptr<StrongMotionReader>> readerVec;
+    readerVec.push_back( std::unique_ptr<StrongMotionReader>( new MiniSeedReader() ) );
+    readerVec.push_back( std::unique_ptr<StrongMotionReader>( new Smc() ) );
+    readerVec.push_back( std::unique_ptr<StrongMotionReader>( new CosmosReader() ) );
+    readerVec.push_back( std::unique_ptr<StrongMotionReader>( new PeerAt2Reader() ) );
+
+    std::unique_ptr<StrongMotionReader> reader;
+
+    for( std::unique_ptr<StrongMotionReader>& crtReader : readerVec )
+    {
+        if( crtReader->canRead( aData, aLength ) )
+        {
+            reader = std::move( crtReader );
+            break;
+        }
+    }
+
+    return reader;
+}
+
+
+//!************************************************************************
+//! Compute the values which are derived from the data of a record:
+//! length, duration, extremes and peak acceleration
+//! Used by the readers whose headers do not provide them.
+//!
+//! @returns: nothing
+//!************************************************************************
+void StrongMotionReader::finalizeRecord
+    (
+    Smc&            aRecord         //!< record with data and sampling rate
+    )
+{
+    aRecord.mDataValuesRecordedCount = static_cast<int32_t>( aRecord.mDataVector.size() );
+    aRecord.mDataLengthSeconds = aRecord.mDataVector.size() / aRecord.mSamplingRate;
+
+    aRecord.mMaximumFromRecord.time = aRecord.mNoValueReal;
+    aRecord.mMaximumFromRecord.accelerationMs2 = aRecord.mNoValueReal;
+    aRecord.mMinimumFromRecord.time = aRecord.mNoValueReal;
+    aRecord.mMinimumFromRecord.accelerationMs2 = aRecord.mNoValueReal;
+
+    if( aRecord.mDataCalibrated && aRecord.mDataVector.size() )
+    {
+        const auto minMax = std::minmax_element( aRecord.mDataVector.begin(), aRecord.mDataVector.end() );
+
+        aRecord.mMaximumFromRecord.time = ( minMax.second - aRecord.mDataVector.begin() ) / aRecord.mSamplingRate;
+        aRecord.mMaximumFromRecord.accelerationMs2 = *minMax.second;
+        aRecord.mMinimumFromRecord.time = ( minMax.first - aRecord.mDataVector.begin() ) / aRecord.mSamplingRate;
+        aRecord.mMinimumFromRecord.accelerationMs2 = *minMax.first;
+
+        aRecord.mTextPeakAcceleration = std::to_string( std::max( std::fabs( *minMax.first ), std::fabs( *minMax.second ) ) );
+    }
+}
+
+
+//!************************************************************************
+//! Get the next line of a file mapped in memory
+//! Both "\n" and "\r\n" line endings are accepted.
+//!
+//! @returns: true if a line was found
+//!************************************************************************
+bool StrongMotionReader::getLine
+    (
+    const char*&    aPos,           //!< current position, moved to the next line
+    const char*     aEnd,           //!< end of data
+    std::string&    aLine           //!< line without the end-of-line characters
+    )
+{
+    bool found = ( aPos < aEnd );
+
+    if( found )
+    {
+        const char* lineEnd = std::find( aPos, aEnd, '\n' );
+        const char* next = ( lineEnd < aEnd ) ? lineEnd + 1 : aEnd;
+
+        if( lineEnd > aPos && '\r' == *( lineEnd - 1 ) )
+        {
+            lineEnd--;
+        }
+
+        aLine.assign( aPos, lineEnd );
+        aPos = next;
+    }
+
+    return found;
+}
+
+
+//!************************************************************************
+//! Mark the SMC header fields which other formats do not provide as
+//! undefined, with the null values of the record
+//!
+//! @returns: nothing
+//!************************************************************************
+void StrongMotionReader::initializeRecord
+    (
+    Smc&            aRecord         //!< record to initialize
+    )
+{
+    const int16_t noValueInteger = aRecord.mNoValueInteger;
+    const double noValueReal = aRecord.mNoValueReal;
+
+    aRecord.mRecordStart.year = noValueInteger;
+    aRecord.mRecordStart.julianDay = noValueInteger;
+    aRecord.mRecordStart.hour = noValueInteger;
+    aRecord.mRecordStart.minute = noValueInteger;
+    aRecord.mRecordStart.second = noValueInteger;
+    aRecord.mRecordStart.millisecond = noValueInteger;
+
+    aRecord.mVerticalOrientation = noValueInteger;
+    aRecord.mHorizontalOrientation = noValueInteger;
+    aRecord.mSensorTypeCode = noValueInteger;
+    aRecord.mSensorTypeStr = "undefined";
+    aRecord.mStructureTypeName = "unknown";
+
+    aRecord.mSeismicMomentNm = noValueReal;
+    aRecord.mEpicentralDistanceKm = noValueReal;
+    aRecord.mEpicenterToStationAzimuth = noValueReal;
+    aRecord.mDigitizationUnitsPerCm = noValueReal;
+    aRecord.mSensorCutoffFrequency = noValueReal;
+    aRecord.mSensorDampingCoefficient = noValueReal;
+    aRecord.mRecorderSensitivityCmG = noValueReal;
+}
+
+
+//!************************************************************************
+//! Parse the numeric values of a data line
+//! Fortran fixed-width fields may have no separator between them, for
+//! example "-0.12345-0.23456", so they are cut at the field width.
+//!
+//! @returns: true if all fields are numbers
+//!************************************************************************
+bool StrongMotionReader::parseFixedWidthValues
+    (
+    const std::string&      aLine,      //!< line with values
+    const size_t            aWidth,     //!< field width, 0 for whitespace-separated values
+    std::vector<double>&    aValueVec   //!< values are appended
+    )
+{
+    bool status = true;
+    char field[64];
+    const char* pos = aLine.c_str();
+    const char* end = pos + aLine.size();
+
+    while( status && pos < end )
+    {
+        const char* fieldEnd = end;
+
+        if( aWidth )
+        {
+            fieldEnd = std::min( pos + aWidth, end );
+        }
+        else
+        {
+            while( pos < end && std::isspace( static_cast<unsigned char>( *pos ) ) )
+            {
+                pos++;
+            }
+
+            fieldEnd = pos;
+
+            while( fieldEnd < end && !std::isspace( static_cast<unsigned char>( *fieldEnd ) ) )
+            {
+                fieldEnd++;
+            }
+        }
+
+        const size_t fieldLength = std::min( static_cast<size_t>( fieldEnd - pos ), sizeof( field ) - 1 );
+        std::copy( pos, pos + fieldLength, field );
+        field[fieldLength] = 0;
+
+        // Fortran exponents may be written with D
+        std::replace( field, field + fieldLength, 'D', 'E' );
+
+        char* parsedEnd = nullptr;
+        const double value = std::strtod( field, &parsedEnd );
+
+        bool blankField = true;
+
+        for( size_t i = 0; i < fieldLength; i++ )
+        {
+            blankField = blankField && std::isspace( static_cast<unsigned char>( field[i] ) );
+        }
+
+        if( !blankField )
+        {
+            while( std::isspace( static_cast<unsigned char>( *parsedEnd ) ) )
+            {
+                parsedEnd++;
+            }
+
+            status = ( parsedEnd != field && 0 == *parsedEnd );
+            aValueVec.push_back( value );
+        }
+
+        pos = fieldEnd;
+    }
+
+    return status;
+}
+
+
+//!************************************************************************
+//! Read a file mapped in memory with the reader matching its content
+//!
+//! @returns: nothing
+//!************************************************************************
+void StrongMotionReader::readFile
+    (
+    FileResult&     aResult         //!< file name in, records or error out
+    )
+{
+    QFile file( QString::fromStdString( aResult.fileName ) );
+
+    if( !file.open( QIODevice::ReadOnly ) )
+    {
+        aResult.error = "Could not open file.";
+    }
+    else
+    {
+        const qint64 fileSize = file.size();
+        uchar* mappedData = ( fileSize > 0 ) ? file.map( 0, fileSize ) : nullptr;
+        QByteArray fileContent;
+
+        const char* data = reinterpret_cast<const char*>( mappedData );
+
+        if( !mappedData )
+        {
+            // files which cannot be mapped are read instead
+            fileContent = file.readAll();
+            data = fileContent.constData();
+        }
+
+        const size_t length = mappedData ? static_cast<size_t>( fileSize ) : static_cast<size_t>( fileContent.size() );
+
+        std::unique_ptr<StrongMotionReader> reader = createReader( data, length );
+
+        if( !reader )
+        {
+            aResult.error = "Unknown strong-motion file format.";
+        }
+        else
+        {
+            aResult.formatName = reader->getFormatName();
+
+            try
+            {
+                if( !reader->read( data, length, aResult.recordVec, aResult.error ) )
+                {
+                    aResult.recordVec.clear();
+                }
+            }
+            catch( const std::exception& )
+            {
+                aResult.recordVec.clear();
+                aResult.error = "Invalid " + aResult.formatName + " value found.";
+            }
+        }
+
+        if( mappedData )
+        {
+            file.unmap( mappedData );
+        }
+
+        file.close();
+    }
+}
+
+
+//!************************************************************************
+//! Read strong-motion data files in parallel
+//! Each file is mapped in memory and read by the reader which recognizes
+//! its content. The results keep the order of the file names.
+//!
+//! @returns: records or error for each file
+//!************************************************************************
+std::vector<StrongMotionReader::FileResult> StrongMotionReader::readFiles
+    (
+    const std::vector<std::string>& aFileNameVec    //!< file names
+    )
+{
+    std::vector<FileResult> resultVec( aFileNameVec.size() );
+
+    for( size_t i = 0; i < aFileNameVec.size(); i++ )
+    {
+        resultVec.at( i ).fileName = aFileNameVec.at( i );
+    }
+
+    std::atomic<size_t> nextFile( 0 );
+
+    auto worker = [&]()
+    {
+        for( size_t i = nextFile++; i < resultVec.size(); i = nextFile++ )
+        {
+            readFile( resultVec.at( i ) );
+        }
+    };
+
+    const size_t threadsCount = std::min<size_t>( std::max( 1u, std::thread::hardware_concurrency() ), resultVec.size() );
+    std::vector<std::thread> threadVec;
+
+    for( size_t i = 1; i < threadsCount; i++ )
+    {
+        threadVec.emplace_back( worker );
+    }
+
+    worker();
+
+    for( std::thread& crtThread : threadVec )
+    {
+        crtThread.join();
+    }
+
+    return resultVec;
+}
+
+
+//!************************************************************************
+//! Trim a string at both ends
+//!
+//! @returns nothing
+//!************************************************************************
+void StrongMotionReader::trim
+    (
+    std::string&    aString         //!< string to trim
+    )
+{
+    aString.erase( aString.begin(), std::find_if( aString.begin(), aString.end(), []( unsigned char ch )
+    {
+        return !std::isspace( ch );
+    }));
+
+    aString.erase( std::find_if( aString.rbegin(), aString.rend(), []( unsigned char ch )
+    {
+        return !std::isspace( ch );
+    } ).base(), aString.end());
+}
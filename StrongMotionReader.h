@@ -0,0 +1,127 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2025 Mihai Ursu                                                 //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+/*
+StrongMotionReader.h
+This file contains the definitions for reading strong-motion data files.
+*/
+
+#ifndef StrongMotionReader_h
+#define StrongMotionReader_h
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+class Smc;
+
+
+//************************************************************************
+// Interface for strong-motion data file readers
+//
+// Every reader parses a whole file, already mapped in memory, into one or
+// more Smc records (one per component), so that all formats share the
+// same time series and metadata.
+//************************************************************************
+class StrongMotionReader
+{
+    //************************************************************************
+    // constants and types
+    //************************************************************************
+    public:
+        struct FileResult
+        {
+            std::string         fileName;       //!< file name
+            std::string         formatName;     //!< detected format
+            std::vector<Smc>    recordVec;      //!< one record for each component
+            std::string         error;          //!< error message, empty on success
+        };
+
+
+    //************************************************************************
+    // functions
+    //************************************************************************
+    public:
+        virtual ~StrongMotionReader();
+
+        virtual bool canRead
+            (
+            const char*     aData,          //!< file content
+            const size_t    aLength         //!< file length
+            ) const = 0;
+
+        virtual std::string getFormatName() const = 0;
+
+        virtual bool read
+            (
+            const char*         aData,          //!< file content
+            const size_t        aLength,        //!< file length
+            std::vector<Smc>&   aRecordVec,     //!< records are appended
+            std::string&        aError          //!< error message
+            ) const = 0;
+
+        static std::vector<FileResult> readFiles
+            (
+            const std::vector<std::string>& aFileNameVec    //!< file names
+            );
+
+    protected:
+        static void finalizeRecord
+            (
+            Smc&            aRecord         //!< record with data and sampling rate
+            );
+
+        static bool getLine
+            (
+            const char*&    aPos,           //!< current position, moved to the next line
+            const char*     aEnd,           //!< end of data
+            std::string&    aLine           //!< line without the end-of-line characters
+            );
+
+        static void initializeRecord
+            (
+            Smc&            aRecord         //!< record to initialize
+            );
+
+        static bool parseFixedWidthValues
+            (
+            const std::string&      aLine,      //!< line with values
+            const size_t            aWidth,     //!< field width, 0 for whitespace-separated values
+            std::vector<double>&    aValueVec   //!< values are appended
+            );
+
+        static void trim
+            (
+            std::string&    aString         //!< string to trim
+            );
+
+    private:
+        static std::unique_ptr<StrongMotionReader> createReader
+            (
+            const char*     aData,          //!< file content
+            const size_t    aLength         //!< file length
+            );
+
+        static void readFile
+            (
+            FileResult&     aResult         //!< file name in, records or error out
+            );
+};
+
+#endif // StrongMotionReader_h
@@ -0,0 +1,205 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2025 Mihai Ursu                                                 //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+/*
+WavetableBank.cpp
+This file contains the sources for the band-limited wavetables.
+*/
+
+#include "WavetableBank.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <mutex>
+
+#include "RealFft.h"
+
+
+//!************************************************************************
+//! Fill the levels of a wavetable from the harmonics of its shape
+//! The harmonics are weighted with the Lanczos sigma factors, so that the
+//! edges do not ring with the Gibbs overshoot of a truncated series.
+//!
+//! @returns: nothing
+//!************************************************************************
+void WavetableBank::fillWavetable
+    (
+    const std::vector<Piece>&   aPieces,    //!< quantized pieces of one cycle
+    Wavetable&                  aWavetable  //!< filled wavetable
+    )
+{
+    RealFft fft( TABLE_SIZE );
+    std::vector<std::complex<double>> harmonicVec( HARMONICS_MAX + 1 );
+    std::vector<std::complex<double>> spectrum( TABLE_SIZE / 2 + 1 );
+    std::vector<double> cycle( TABLE_SIZE );
+
+    for( uint32_t n = 0; n <= HARMONICS_MAX; n++ )
+    {
+        harmonicVec[n] = getHarmonic( aPieces, n );
+    }
+
+    aWavetable.levelVec.assign( LEVELS_COUNT, std::vector<float>( TABLE_SIZE + 1 ) );
+
+    for( uint8_t level = 0; level < LEVELS_COUNT; level++ )
+    {
+        const uint32_t harmonicsCount = 1 << level;
+        std::fill( spectrum.begin(), spectrum.end(), 0 );
+
+        for( uint32_t n = 0; n <= harmonicsCount; n++ )
+        {
+            const double x = M_PI * n / ( harmonicsCount + 1 );
+            const double sigma = ( 0 == n ) ? 1 : sin( x ) / x;
+
+            // the inverse transform is scaled by 1/N
+            spectrum[n] = static_cast<double>( TABLE_SIZE ) * sigma * harmonicVec[n];
+        }
+
+        fft.inverse( spectrum, cycle.data() );
+
+        std::vector<float>& table = aWavetable.levelVec[level];
+        std::copy( cycle.begin(), cycle.end(), table.begin() );
+        table[TABLE_SIZE] = table[0];
+    }
+}
+
+
+//!************************************************************************
+//! Get a harmonic of a piecewise-linear cycle
+//!
+//! c[n] = integral over the cycle of y(t) * exp(-2*pi*i*n*t) dt
+//!
+//! @returns: the complex amplitude c[n]
+//!************************************************************************
+std::complex<double> WavetableBank::getHarmonic
+    (
+    const std::vector<Piece>&   aPieces,    //!< pieces of one cycle
+    const uint32_t              aIndex      //!< harmonic index
+    )
+{
+    std::complex<double> harmonic = 0;
+
+    for( const Piece& piece : aPieces )
+    {
+        const double duration = piece.tEnd - piece.tStart;
+
+        if( duration <= 0 )
+        {
+            continue;
+        }
+
+        const double slope = ( piece.yEnd - piece.yStart ) / duration;
+
+        if( 0 == aIndex )
+        {
+            harmonic += duration * 0.5 * ( piece.yStart + piece.yEnd );
+        }
+        else
+        {
+            // y(t) = yStart + slope * ( t - tStart ), integrated in closed form
+            const std::complex<double> iw( 0, 2 * M_PI * aIndex );
+            const std::complex<double> eStart = std::exp( -iw * piece.tStart );
+            const std::complex<double> eEnd = std::exp( -iw * piece.tEnd );
+            const std::complex<double> integral = ( eStart - eEnd ) / iw;
+
+            harmonic += piece.yStart * integral + slope * ( integral - duration * eEnd ) / iw;
+        }
+    }
+
+    return harmonic;
+}
+
+
+//!************************************************************************
+//! Get the level to play a shape with a given number of harmonics below
+//! the Nyquist frequency
+//!
+//! @returns: the highest level whose harmonics all stay below Nyquist
+//!************************************************************************
+uint8_t WavetableBank::getLevel
+    (
+    const double    aHarmonicsCount     //!< harmonics below the Nyquist frequency
+    )
+{
+    uint8_t level = 0;
+
+    while( level + 1 < LEVELS_COUNT && ( 2u << level ) <= aHarmonicsCount )
+    {
+        level++;
+    }
+
+    return level;
+}
+
+
+//!************************************************************************
+//! Get the wavetable of a shape
+//! The piece bounds and values are quantized, so that shapes which only
+//! differ below the quantization share one wavetable. A wavetable is kept
+//! while any component plays it.
+//!
+//! @returns: the wavetable
+//!************************************************************************
+std::shared_ptr<const WavetableBank::Wavetable> WavetableBank::getWavetable
+    (
+    const std::vector<Piece>&   aPieces     //!< pieces of one cycle
+    )
+{
+    static std::mutex cacheMutex;
+    static std::map<std::vector<int32_t>, std::weak_ptr<const Wavetable>> cacheMap;
+
+    std::vector<Piece> pieces;
+    std::vector<int32_t> key;
+
+    for( const Piece& piece : aPieces )
+    {
+        Piece quantized;
+        quantized.tStart = std::round( std::clamp( piece.tStart, 0.0, 1.0 ) * QUANTIZATION_STEPS ) / QUANTIZATION_STEPS;
+        quantized.tEnd = std::round( std::clamp( piece.tEnd, 0.0, 1.0 ) * QUANTIZATION_STEPS ) / QUANTIZATION_STEPS;
+        quantized.yStart = std::round( std::clamp( piece.yStart, 0.0, 1.0 ) * QUANTIZATION_STEPS ) / QUANTIZATION_STEPS;
+        quantized.yEnd = std::round( std::clamp( piece.yEnd, 0.0, 1.0 ) * QUANTIZATION_STEPS ) / QUANTIZATION_STEPS;
+
+        if( quantized.tEnd > quantized.tStart )
+        {
+            pieces.push_back( quantized );
+            key.push_back( static_cast<int32_t>( quantized.tStart * QUANTIZATION_STEPS ) );
+            key.push_back( static_cast<int32_t>( quantized.tEnd * QUANTIZATION_STEPS ) );
+            key.push_back( static_cast<int32_t>( quantized.yStart * QUANTIZATION_STEPS ) );
+            key.push_back( static_cast<int32_t>( quantized.yEnd * QUANTIZATION_STEPS ) );
+        }
+    }
+
+    std::lock_guard<std::mutex> lock( cacheMutex );
+
+    std::shared_ptr<const Wavetable> wavetable = cacheMap[key].lock();
+
+    if( !wavetable )
+    {
+        std::shared_ptr<Wavetable> newWavetable = std::make_shared<Wavetable>();
+        fillWavetable( pieces, *newWavetable );
+        wavetable = newWavetable;
+        cacheMap[key] = wavetable;
+
+        // drop the entries of the shapes no longer played
+        for( auto it = cacheMap.begin(); it != cacheMap.end(); )
+        {
+            it = it->second.expired() ? cacheMap.erase( it ) : std::next( it );
+        }
+    }
+
+    return wavetable;
+}
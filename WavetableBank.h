@@ -0,0 +1,92 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2025 Mihai Ursu                                                 //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+/*
+WavetableBank.h
+This file contains the definitions for the band-limited wavetables.
+*/
+
+#ifndef WavetableBank_h
+#define WavetableBank_h
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+
+//************************************************************************
+// Class for band-limited single-cycle wavetables of piecewise-linear
+// shapes, one table for each octave of harmonics, cached by shape
+//************************************************************************
+class WavetableBank
+{
+    //************************************************************************
+    // constants and types
+    //************************************************************************
+    public:
+        static const size_t TABLE_SIZE = 4096;              //!< samples in one cycle
+        static const uint8_t LEVELS_COUNT = 11;             //!< level k holds the harmonics up to 2^k
+        static const uint32_t HARMONICS_MAX = 1 << ( LEVELS_COUNT - 1 );   //!< harmonics of the top level
+        static const uint16_t QUANTIZATION_STEPS = 1024;    //!< steps of a cycle and of the unit value range
+
+        // linear piece of one cycle
+        struct Piece
+        {
+            double      tStart;         //!< start [cycles]
+            double      tEnd;           //!< end [cycles]
+            double      yStart;         //!< value at the start, in [0..1]
+            double      yEnd;           //!< value at the end, in [0..1]
+        };
+
+        // band-limited cycle; each table has a guard sample repeating the first
+        struct Wavetable
+        {
+            std::vector<std::vector<float>>     levelVec;   //!< TABLE_SIZE + 1 samples for each level
+        };
+
+
+    //************************************************************************
+    // functions
+    //************************************************************************
+    public:
+        static uint8_t getLevel
+            (
+            const double    aHarmonicsCount     //!< harmonics below the Nyquist frequency
+            );
+
+        static std::shared_ptr<const Wavetable> getWavetable
+            (
+            const std::vector<Piece>&   aPieces     //!< pieces of one cycle
+            );
+
+    private:
+        static void fillWavetable
+            (
+            const std::vector<Piece>&   aPieces,    //!< quantized pieces of one cycle
+            Wavetable&                  aWavetable  //!< filled wavetable
+            );
+
+        static std::complex<double> getHarmonic
+            (
+            const std::vector<Piece>&   aPieces,    //!< pieces of one cycle
+            const uint32_t              aIndex      //!< harmonic index
+            );
+};
+
+#endif // WavetableBank_h